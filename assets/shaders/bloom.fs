@@ -6,6 +6,10 @@ out vec4 finalColor;
 uniform sampler2D sceneTexture;
 uniform vec2  resolution;
 
+// Dynamic resolution: the scene only fills uvScale of sceneTexture, fragTexCoord runs 0..uvScale.
+uniform vec2  uvScale;
+uniform float sharpenAmount; // unsharp mask on upscaled frames, 0 = off
+
 // Bloom + tone mapping
 uniform float bloomStrength;
 uniform float uExposure;
@@ -54,8 +58,25 @@ void main()
 {
     vec2 texelSize = 1.0 / resolution;
 
+    // keep taps inside the rendered corner, and screen-space effects in 0..1 screen coords
+    vec2 uvMax    = uvScale - texelSize * 0.5;
+    vec2 screenUV = fragTexCoord / uvScale;
+
     // Source scene is assumed to be sRGB.
-    vec3 srcSRGB = texture(sceneTexture, fragTexCoord).rgb;
+    // Clamped like the other taps: on the last upscaled row/column bilinear would blend in the
+    // cleared texels past the rendered corner.
+    vec3 srcSRGB = texture(sceneTexture, clamp(fragTexCoord, vec2(0.0), uvMax)).rgb;
+
+    // Sharpen what bilinear upscaling softened: push the center away from its 4 neighbours.
+    if (sharpenAmount > 0.001)
+    {
+        vec3 n = texture(sceneTexture, clamp(fragTexCoord + vec2( texelSize.x, 0.0), vec2(0.0), uvMax)).rgb
+               + texture(sceneTexture, clamp(fragTexCoord + vec2(-texelSize.x, 0.0), vec2(0.0), uvMax)).rgb
+               + texture(sceneTexture, clamp(fragTexCoord + vec2(0.0,  texelSize.y), vec2(0.0), uvMax)).rgb
+               + texture(sceneTexture, clamp(fragTexCoord + vec2(0.0, -texelSize.y), vec2(0.0), uvMax)).rgb;
+        srcSRGB = clamp(srcSRGB + (srcSRGB - n * 0.25) * sharpenAmount, 0.0, 1.0);
+    }
+
     vec3 srcLin  = toLinear(srcSRGB);
 
     // ------------------------------------------------------------
@@ -73,7 +94,7 @@ void main()
             for (int x = -2; x <= 2; ++x)
             {
                 vec2 uv = fragTexCoord + vec2(x, y) * texelSize;
-                uv = clamp(uv, vec2(0.0), vec2(1.0));
+                uv = clamp(uv, vec2(0.0), uvMax);
 
                 vec3 s = toLinear(texture(sceneTexture, uv).rgb);
 
@@ -113,7 +134,7 @@ void main()
     // ------------------------------------------------------------
     // 3) Vignette / status / fade / dungeon effects
     // ------------------------------------------------------------
-    float dist = distance(fragTexCoord, vec2(0.5));
+    float dist = distance(screenUV, vec2(0.5));
     float vignette = smoothstep(0.4, 0.8, dist);
 
     // Base dark corner vignette
@@ -158,7 +179,7 @@ void main()
     float lb = clamp(letterboxAmount, 0.0, 0.49);
     float soft = max(letterboxSoftness, 0.00001);
 
-    float y = fragTexCoord.y;
+    float y = screenUV.y;
 
     // Bottom bar: 1.0 inside bar, 0.0 outside
     float bottomBar = 1.0 - smoothstep(lb, lb + soft, y);
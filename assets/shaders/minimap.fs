@@ -0,0 +1,41 @@
+#version 330
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;   // wall mask, scale px per tile
+uniform sampler2D stateTex;   // one texel per tile: r = explored, g = visible, b = reveal time
+uniform vec2 mapSize;         // dungeon size in tiles
+uniform float timeSeconds;
+uniform float fadeDuration;
+
+out vec4 finalColor;
+
+void main()
+{
+    ivec2 tile = ivec2(clamp(floor(fragTexCoord * mapSize), vec2(0.0), mapSize - 1.0));
+    vec4 state = texelFetch(stateTex, tile, 0);
+
+    // Unexplored: nothing from the map
+    if (state.r < 0.5) discard;
+
+    vec4 mask = texture(texture0, fragTexCoord) * fragColor;
+
+    // reveal fade for newly discovered tiles, black 220 -> 0
+    float fade = 0.0;
+    float elapsed = timeSeconds - state.b;
+    if (state.b >= 0.0 && elapsed < fadeDuration)
+    {
+        fade = (1.0 - max(elapsed, 0.0) / fadeDuration) * (220.0 / 255.0);
+    }
+
+    // memory fog: explored but not in LOS
+    float fog = (state.g < 0.5) ? (80.0 / 255.0) : 0.0;
+
+    // same result as drawing the tile, then the two black overlays on top of it
+    float keep = (1.0 - fade) * (1.0 - fog);
+    float alpha = 1.0 - (1.0 - mask.a) * keep;
+    if (alpha <= 0.0) discard;
+
+    finalColor = vec4(mask.rgb * mask.a * keep / alpha, alpha);
+}
@@ -0,0 +1,15 @@
+#version 330
+
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+
+// raylib DrawMeshInstanced feeds this through SHADER_LOC_MATRIX_MODEL
+in mat4 instanceTransform;
+
+out vec2 fragTexCoord;
+uniform mat4 mvp;
+
+void main() {
+    fragTexCoord = vertexTexCoord;
+    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);
+}
@@ -6,6 +6,7 @@
 #include "game_settings.h"
 #include "shaderSetup.h"
 #include "camera_system.h"
+#include "replay.h"
 
 void JournalUI::Init()
 {
@@ -194,33 +195,33 @@ void JournalUI::Update(float deltaTime)
     }
 
 
-    if (IsKeyPressed(KEY_J)){
+    if (Replay::IsKeyPressed(KEY_J)){
         Toggle();
     }
 
 
-    if (open && IsKeyPressed(KEY_ESCAPE)){
+    if (open && Replay::IsKeyPressed(KEY_ESCAPE)){
         Close();
     }
 
     if (open)
     {
-        if (IsKeyPressed(KEY_Q))
+        if (Replay::IsKeyPressed(KEY_Q))
         {
             PreviousJournalPage();
         }
 
-        if (IsKeyPressed(KEY_E))
+        if (Replay::IsKeyPressed(KEY_E))
         {
             NextJournalPage();
         }
 
-        if (IsKeyPressed(KEY_LEFT))
+        if (Replay::IsKeyPressed(KEY_LEFT))
         {
             PreviousCreaturePage();
         }
 
-        if (IsKeyPressed(KEY_RIGHT))
+        if (Replay::IsKeyPressed(KEY_RIGHT))
         {
             NextCreaturePage();
         }
@@ -9,14 +9,10 @@
 #include "ui.h"
 #include "dungeonGeneration.h"
 
-static bool PtrStillListed(Character* p, const std::vector<Character*>& enemyPtrs)
+// target is only trusted while the enemy store still maps its handle to it
+static bool TargetStillListed(Character* p, EnemyHandle h)
 {
-    if (!p) return false;
-    for (Character* e : enemyPtrs)
-    {
-        if (e == p) return true;
-    }
-    return false;
+    return p && enemies.Get(h) == p;
 }
 
 static bool IsWithinAimConeXZ(const Vector3& hermitPos,
@@ -312,7 +308,7 @@ void NPC::SetTurretState(HermitTurretState s)
 Character* NPC::AcquireClosestEnemy(const std::vector<Character*>& enemyPtrs)
 {
     // Keep current target if valid and within vision
-    if (target && PtrStillListed(target, enemyPtrs) &&
+    if (target && TargetStillListed(target, targetHandle) &&
         !target->isDead && target->currentHealth > 0)
     {
         Vector3 d = Vector3Subtract(target->position, position);
@@ -347,7 +343,7 @@ void NPC::MaintainOrAcquireTarget(float dt, const std::vector<Character*>& enemy
 {
     auto TargetIsValid = [&]() -> bool {
         if (!target) return false;
-        if (!PtrStillListed(target, enemyPtrs)) return false;
+        if (!TargetStillListed(target, targetHandle)) return false;
         if (target->isDead) return false;
         if (target->currentHealth <= 0) return false;
 
@@ -378,6 +374,7 @@ void NPC::MaintainOrAcquireTarget(float dt, const std::vector<Character*>& enemy
     // Drop and reacquire
     targetDropTimer = 0.0f;
     target = AcquireClosestEnemy(enemyPtrs);
+    if (target) targetHandle = target->handle;
 
     if (target && turretState == HermitTurretState::Idle)
         SetTurretState(HermitTurretState::Aim);
@@ -392,7 +389,7 @@ void NPC::UpdateHermitTurretBrain(float dt, const std::vector<Character*>& enemy
     flipCooldownLeft = fmaxf(0.0f, flipCooldownLeft - dt);
 
     // If our stored target pointer got removed from list, drop immediately
-    if (target && !PtrStillListed(target, enemyPtrs))
+    if (target && !TargetStillListed(target, targetHandle))
     {
         target = nullptr;
         targetDropTimer = 0.0f;
@@ -489,6 +486,7 @@ void NPC::Hermit_Turret_Fire(float /*dt*/, const std::vector<Character*>& enemyP
         if (next)
         {
             target = next;
+            targetHandle = next->handle;
             SetTurretState(HermitTurretState::Aim);
         }
         else
@@ -550,13 +548,13 @@ void NPC::Hermit_Patrol_Idle(float dt)
     if (idleNoTargetTimer < patrolIdleDelay) return;
     idleNoTargetTimer = 0.0f;
 
-    float cellSize = terrainScale.x / (float)(heightmap.width - 1);
+    float cellSize = terrainScale.x / (float)(gHeightField.Width() - 1);
 
     patrolGoal = RandomPointOnHeightmapRingXZ(
         homePos,
         patrolMinR,
         patrolMaxR,
-        heightmap.width,
+        gHeightField.Width(),
         cellSize,
         200.0f
     );
@@ -586,13 +584,13 @@ void NPC::Hermit_Patrol_Move(float dt)
     // Ensure we have a goal
     if (!patrolHasGoal)
     {
-        float cellSize = terrainScale.x / (float)(heightmap.width - 1);
+        float cellSize = terrainScale.x / (float)(gHeightField.Width() - 1);
 
         patrolGoal = RandomPointOnHeightmapRingXZ(
             homePos,
             patrolMinR,
             patrolMaxR,
-            heightmap.width,
+            gHeightField.Width(),
             cellSize,
             200.0f
         );
@@ -691,7 +689,7 @@ void NPC::Hermit_Follow_Move(float dt)
     animIntent = AnimIntent::Walk;
 
     Vector3 goal = player.position;
-    goal.y = isDungeon ? GetHeightAtWorldPosition(goal, heightmap, terrainScale) : dungeonEnemyHeight;
+    goal.y = isDungeon ? GetHeightAtWorldPosition(goal) : dungeonEnemyHeight;
 
     Vector3 goalDelta = Vector3Subtract(goal, followLastGoal);
     goalDelta.y = 0.0f;
@@ -787,7 +785,7 @@ void NPC::FollowNavPath(float dt)
     }
 
     Vector3 wp = navPath[navPathIndex];
-    wp.y = GetHeightAtWorldPosition(wp, heightmap, terrainScale);
+    wp.y = GetHeightAtWorldPosition(wp);
 
     Vector3 to = Vector3Subtract(wp, position);
     to.y = 0.0f;
@@ -928,12 +926,12 @@ bool NPC::CanInteract(const Vector3& playerPos) const
 
 float NPC::GetFeetPosY()
 {
-    return isDungeon ? floorHeight + 20.0f : GetHeightAtWorldPosition(position, heightmap, terrainScale);
+    return isDungeon ? floorHeight + 20.0f : GetHeightAtWorldPosition(position);
 }
 
 float NPC::GetCenterPosY() const
 {
-    return GetHeightAtWorldPosition(position, heightmap, terrainScale) + (frameHeight * scale) * 0.5f;
+    return GetHeightAtWorldPosition(position) + (frameHeight * scale) * 0.5f;
 }
 
 float NPC::GetCenterDungeonPosY() const 
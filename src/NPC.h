@@ -2,6 +2,7 @@
 #include "raylib.h"
 #include <string>
 #include <vector>
+#include "enemy_handle.h"
 
 // Forward decl to avoid include cycles
 class Character;
@@ -191,6 +192,7 @@ public:
 
     // --- combat target ---
     Character* target = nullptr;
+    EnemyHandle targetHandle;          // checked against the enemy store before target is used
     Vector3 muzzleOffset = { 0.0f, 0.0f, 0.0f };
 
 public:
@@ -0,0 +1,117 @@
+#include "ai_scheduler.h"
+
+#include <algorithm>
+#include "raymath.h"
+#include "character.h"
+#include "enemy_store.h"
+#include "dungeon_visibility.h"
+#include "world.h"
+
+namespace AIScheduler
+{
+    // Ranges are in world units; dungeons are much tighter than the island.
+    static constexpr float OVERWORLD_FULL_RANGE    = 4000.0f;
+    static constexpr float OVERWORLD_REDUCED_RANGE = 12000.0f;
+    static constexpr float DUNGEON_FULL_RANGE      = 2000.0f;  // 10 tiles
+    static constexpr float DUNGEON_REDUCED_RANGE   = 5000.0f;  // 25 tiles
+
+    static constexpr float REDUCED_INTERVAL = 0.1f;
+    static constexpr float DORMANT_INTERVAL = 0.5f;
+    static constexpr float MAX_AI_STEP      = 0.5f;  // longest dt a sliced think gets
+    static constexpr int   SLICED_BUDGET    = 32;    // Reduced + Dormant thinks per frame
+
+    static constexpr float VIEW_CONE_COS = 0.5f;     // overworld: ~60 deg either side of the view direction
+
+    static Stats gStats;
+    static size_t gCursor = 0;  // where the round robin picks up next frame
+
+    // State comes from the Character (Schedule touches it anyway, and hits from last frame's
+    // collision land after the hot sync), position from the hot snapshot.
+    static Tier Classify(const Character& c, Vector3 p, Vector3 playerPos, const Camera& camera)
+    {
+        if (c.isDead) return Tier::Full; //death anim + removal timing
+        CharacterState s = c.state;
+        if (s != CharacterState::Idle && s != CharacterState::Patrol) return Tier::Full; //engaged
+
+        float fullRange = isDungeon ? DUNGEON_FULL_RANGE : OVERWORLD_FULL_RANGE;
+        float reducedRange = isDungeon ? DUNGEON_REDUCED_RANGE : OVERWORLD_REDUCED_RANGE;
+
+        float distSq = Vector3DistanceSqr(p, playerPos);
+        if (distSq < fullRange * fullRange) return Tier::Full;
+        if (distSq >= reducedRange * reducedRange) return Tier::Dormant;
+
+        // mid range: full rate if the player can see it so movement stays smooth.
+        // Dungeons use the room/portal result (last frame's, Update runs with the draw), so
+        // enemies behind walls or in sealed rooms drop to Reduced. The overworld has no
+        // occluders to go by, there it's just the view cone.
+        if (isDungeon) return DungeonVisibility::IsWorldPosVisible(p) ? Tier::Full : Tier::Reduced;
+
+        Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+        Vector3 toEnemy = Vector3Subtract(p, camera.position);
+        float len = Vector3Length(toEnemy);
+        if (len > 0.001f && Vector3DotProduct(forward, toEnemy) / len > VIEW_CONE_COS) return Tier::Full;
+
+        return Tier::Reduced;
+    }
+
+    void Schedule(const std::vector<Character*>& enemies, const EnemyHotData& hot,
+                  Vector3 playerPos, const Camera& camera, float dt, std::vector<float>& aiDt)
+    {
+        const size_t n = enemies.size();
+        aiDt.assign(n, 0.0f);
+        gStats = Stats{};
+        gStats.budget = SLICED_BUDGET;
+
+        for (size_t i = 0; i < n; i++)
+        {
+            Character* c = enemies[i];
+            c->aiPendingDt += dt;
+            c->aiTier = Classify(*c, hot.position[i], playerPos, camera);
+
+            switch (c->aiTier)
+            {
+                case Tier::Full:    gStats.full++; break;
+                case Tier::Reduced: gStats.reduced++; break;
+                case Tier::Dormant: gStats.dormant++; break;
+            }
+
+            if (c->aiTier == Tier::Full)
+            {
+                aiDt[i] = std::min(c->aiPendingDt, MAX_AI_STEP);
+                c->aiPendingDt = 0.0f;
+                gStats.thinks++;
+            }
+        }
+
+        if (n == 0) return;
+
+        int budget = SLICED_BUDGET;
+        size_t start = gCursor % n;
+        for (size_t k = 0; k < n; k++)
+        {
+            size_t i = (start + k) % n;
+            Character* c = enemies[i];
+            if (c->aiTier == Tier::Full) continue;
+
+            float interval = (c->aiTier == Tier::Reduced) ? REDUCED_INTERVAL : DORMANT_INTERVAL;
+            if (c->aiPendingDt < interval) continue;
+
+            if (budget == 0)
+            {
+                gStats.deferred++;
+                continue;
+            }
+
+            aiDt[i] = std::min(c->aiPendingDt, MAX_AI_STEP);
+            c->aiPendingDt = 0.0f;
+            gStats.thinks++;
+            budget--;
+            gCursor = i + 1;
+        }
+    }
+
+    const Stats& LastStats()
+    {
+        return gStats;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "raylib.h"
+
+class Character;
+struct EnemyHotData;
+
+// AI level of detail. Decides each frame which enemies run UpdateAI and with what dt.
+//
+//   Full     every frame: near the player, visible at mid range, or not idle/patrolling
+//   Reduced  about every 0.1 s: mid range, not visible
+//
+// "Visible" is DungeonVisibility's room/portal result in dungeons and the camera's view
+// cone on the overworld.
+//   Dormant  about every 0.5 s: far away
+//
+// A skipped enemy still runs the cheap part of Character::Update (timers, animation);
+// the time it missed is saved up and handed to UpdateAI the next time it thinks.
+// Reduced/Dormant thinks are capped per frame and handed out round robin, so a crowd of
+// distant enemies costs the same per frame no matter how big it gets. Tiers depend only on
+// positions and dt, so replays and the benchmark schedule identically.
+
+namespace AIScheduler
+{
+    enum class Tier : uint8_t
+    {
+        Full,
+        Reduced,
+        Dormant
+    };
+
+    struct Stats
+    {
+        int full = 0;
+        int reduced = 0;
+        int dormant = 0;
+        int thinks = 0;     // UpdateAI calls this frame
+        int deferred = 0;   // due but over budget, pushed to a later frame
+        int budget = 0;     // max Reduced/Dormant thinks per frame
+    };
+
+    // Fills aiDt (same order as enemies): dt to pass to UpdateAI, 0 = skip this frame.
+    void Schedule(const std::vector<Character*>& enemies, const EnemyHotData& hot,
+                  Vector3 playerPos, const Camera& camera, float dt, std::vector<float>& aiDt);
+
+    const Stats& LastStats();
+}
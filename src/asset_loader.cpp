@@ -0,0 +1,237 @@
+#include "asset_loader.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include "raylib.h"
+#include "job_system.h"
+#include "load_timer.h"
+#include "resourceManager.h"
+#include "sound_manager.h"
+#include "sprite_atlas.h"
+#include "ui.h"
+
+namespace AssetLoader
+{
+    enum class AssetKind
+    {
+        Texture,
+        Model,
+        Sound
+    };
+
+    struct PendingAsset
+    {
+        AssetKind kind = AssetKind::Texture;
+        std::string name;
+        std::string path;
+
+        // filled in by the worker
+        unsigned char* fileData = nullptr; // models: raw .glb, handed to raylib's loader
+        int fileSize = 0;
+        Image image = {};
+        Wave wave = {};
+    };
+
+    static std::vector<PendingAsset> gQueue;
+
+    static std::mutex gDoneMutex;
+    static std::condition_variable gDoneCv;
+    static std::vector<int> gDone; // indices into gQueue, decoded and waiting for upload
+
+    static const PendingAsset* gServing = nullptr; // model currently inside ::LoadModel
+
+    static constexpr double PROGRESS_REDRAW_SECONDS = 1.0 / 30.0; // vsync would stall every upload otherwise
+
+    // Plain stdio so workers never go through raylib's (main thread only) file callback.
+    // Buffer comes from MemAlloc so raylib can free it with UnloadFileData.
+    static unsigned char* ReadWholeFile(const char* path, int* size)
+    {
+        *size = 0;
+        FILE* f = fopen(path, "rb");
+        if (!f) return nullptr;
+
+        fseek(f, 0, SEEK_END);
+        long len = ftell(f);
+        fseek(f, 0, SEEK_SET);
+
+        unsigned char* data = nullptr;
+        if (len > 0)
+        {
+            data = (unsigned char*)MemAlloc((unsigned int)len);
+            if (data && fread(data, 1, (size_t)len, f) == (size_t)len)
+            {
+                *size = (int)len;
+            }
+            else
+            {
+                MemFree(data);
+                data = nullptr;
+            }
+        }
+
+        fclose(f);
+        return data;
+    }
+
+    // Installed while a model uploads: hands glTF the bytes a worker already read.
+    // Anything else it asks for (external .bin / images) is read on the spot.
+    static unsigned char* ServePrefetched(const char* fileName, int* dataSize)
+    {
+        if (gServing && gServing->fileData && strcmp(fileName, gServing->path.c_str()) == 0)
+        {
+            PendingAsset* a = const_cast<PendingAsset*>(gServing);
+            unsigned char* data = a->fileData;
+            *dataSize = a->fileSize;
+            a->fileData = nullptr; // raylib owns it now
+            a->fileSize = 0;
+            return data;
+        }
+
+        unsigned char* data = ReadWholeFile(fileName, dataSize);
+        if (!data) TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", fileName);
+        return data;
+    }
+
+    static void Decode(PendingAsset& a)
+    {
+        int size = 0;
+        unsigned char* data = ReadWholeFile(a.path.c_str(), &size);
+
+        switch (a.kind)
+        {
+            case AssetKind::Texture:
+                if (data) a.image = LoadImageFromMemory(GetFileExtension(a.path.c_str()), data, size);
+                MemFree(data);
+                break;
+
+            case AssetKind::Sound:
+                if (data) a.wave = LoadWaveFromMemory(GetFileExtension(a.path.c_str()), data, size);
+                MemFree(data);
+                break;
+
+            case AssetKind::Model:
+                a.fileData = data;
+                a.fileSize = size;
+                break;
+        }
+    }
+
+    static const char* Upload(PendingAsset& a)
+    {
+        switch (a.kind)
+        {
+            case AssetKind::Texture:
+            {
+                Texture2D& tex = R.AddTextureFromImage(a.name, a.image, a.path);
+                if (!SpriteAtlas::Collect(tex, a.path, a.image)) UnloadImage(a.image); // sprite sheets go on to the atlas
+                a.image = {};
+                return "Loading Textures";
+            }
+
+            case AssetKind::Sound:
+                SoundManager::GetInstance().AddSoundFromWave(a.name, a.wave, a.path);
+                UnloadWave(a.wave);
+                a.wave = {};
+                return "Loading Sounds";
+
+            case AssetKind::Model:
+                gServing = &a;
+                SetLoadFileDataCallback(ServePrefetched);
+                R.LoadModel(a.name, a.path);
+                SetLoadFileDataCallback(nullptr);
+                gServing = nullptr;
+
+                MemFree(a.fileData); // only still set if the model was already loaded under this name
+                a.fileData = nullptr;
+                return "Loading Models";
+        }
+        return "";
+    }
+
+    static void Queue(AssetKind kind, const std::string& name, const std::string& path)
+    {
+        PendingAsset a;
+        a.kind = kind;
+        a.name = name;
+        a.path = path;
+        gQueue.push_back(a);
+    }
+
+    void QueueTexture(const std::string& name, const std::string& path)
+    {
+        Queue(AssetKind::Texture, name, path);
+    }
+
+    void QueueModel(const std::string& name, const std::string& path)
+    {
+        Queue(AssetKind::Model, name, path);
+    }
+
+    void QueueSound(const std::string& name, const std::string& path)
+    {
+        Queue(AssetKind::Sound, name, path);
+    }
+
+    void Flush()
+    {
+        if (gQueue.empty()) return;
+        LoadTimer timer("AssetLoader::Flush");
+
+        const int total = (int)gQueue.size();
+        gDone.clear();
+
+        // Models first: their parse is the long pole on the main thread, so get those bytes
+        // back early and let textures and sounds decode behind them.
+        for (AssetKind kind : { AssetKind::Model, AssetKind::Texture, AssetKind::Sound })
+        {
+            for (int i = 0; i < total; i++)
+            {
+                if (gQueue[i].kind != kind) continue;
+                JobSystem::Submit([i]
+                {
+                    Decode(gQueue[i]);
+                    {
+                        std::lock_guard<std::mutex> lock(gDoneMutex);
+                        gDone.push_back(i);
+                    }
+                    gDoneCv.notify_one();
+                });
+            }
+        }
+
+        int uploaded = 0;
+        double lastDraw = -1.0;
+        std::vector<int> ready;
+
+        while (uploaded < total)
+        {
+            {
+                std::unique_lock<std::mutex> lock(gDoneMutex);
+                gDoneCv.wait(lock, [] { return !gDone.empty(); });
+                ready.swap(gDone);
+            }
+
+            for (int i : ready)
+            {
+                const char* message = Upload(gQueue[i]);
+                uploaded++;
+
+                double now = GetTime();
+                if (now - lastDraw >= PROGRESS_REDRAW_SECONDS || uploaded == total)
+                {
+                    UpdateLoadingScreen((float)uploaded / total, message);
+                    lastDraw = now;
+                }
+            }
+            ready.clear();
+        }
+
+        TraceLog(LOG_INFO, "ASSETS: %d files loaded on %d worker threads", total, JobSystem::WorkerCount());
+        gQueue.clear();
+
+        SpriteAtlas::Build();
+    }
+}
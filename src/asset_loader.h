@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+// Startup asset loading split into two stages:
+//   worker threads: read the file and decode it (PNG -> Image, OGG/WAV -> Wave, .glb -> bytes)
+//   main thread:    upload to the GPU / audio device as each result comes back
+//
+// Queue everything first, then Flush() once. Flush draws the boot progress bar,
+// so the "Pieces" font has to be loaded before it runs.
+//
+// raylib's LoadModel parses the glTF and uploads the meshes in one call, so models only
+// get their file read on a worker; the parse still happens on the main thread.
+
+namespace AssetLoader
+{
+    void QueueTexture(const std::string& name, const std::string& path);
+    void QueueModel(const std::string& name, const std::string& path);
+    void QueueSound(const std::string& name, const std::string& path);
+
+    // Blocks until everything queued is uploaded and registered with R / SoundManager.
+    void Flush();
+}
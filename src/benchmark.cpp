@@ -0,0 +1,305 @@
+#include "benchmark.h"
+
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <vector>
+#include "world.h"
+#include "camera_system.h"
+#include "debug_overlay.h"
+#include "game_settings.h"
+#include "pathfinding.h"
+#include "shaderSetup.h"
+#include "utilities.h"
+
+namespace Benchmark
+{
+    static constexpr float STEP_DT = 1.0f / 60.0f;
+    static constexpr int WARMUP_FRAMES = 60;      // shader warmup, texture uploads, fade in
+    static constexpr float SEGMENT_SECONDS = 3.0f;
+
+    struct LevelResult
+    {
+        int levelIndex = 0;
+        std::string name;
+        FrameTimeStats stats;
+        float avgTerrainChunks = 0.0f;
+        float avgDungeonInstances = 0.0f;
+        float avgFoliage = 0.0f;
+        int enemies = 0;
+        float avgEnemyUpdateMs = 0.0f;
+    };
+
+    static bool gRunning = false;
+    static std::string gCsvPath;
+    static int gLevelCursor = -1;
+    static int gFrameInLevel = 0;
+    static bool gSavedFreezeAI = false;
+    static bool gSavedShowTutorial = true;
+    static bool gSavedGodMode = false;
+    static int gExtraEnemies = 0;
+
+    static std::vector<float> gLevelFrameTimesMs;
+    static std::vector<float> gAllFrameTimesMs;
+    static double gTerrainChunkSum = 0.0;
+    static double gDungeonInstanceSum = 0.0;
+    static double gFoliageSum = 0.0;
+    static double gEnemyUpdateSum = 0.0;
+    static std::vector<LevelResult> gResults;
+
+    // ------------------------------------------------------------
+    // Flythrough paths
+    // ------------------------------------------------------------
+
+    static void PushWaypoint(WaypointCutsceneDesc& desc, Vector3 pos, Vector3 target)
+    {
+        CameraWaypoint w;
+        w.position = pos;
+        w.target = target;
+        w.durationToNext = SEGMENT_SECONDS;
+        desc.points.push_back(w);
+    }
+
+    // Ring around the island above the terrain, looking in at the middle, then a pass over the top.
+    static WaypointCutsceneDesc MakeOverworldPath()
+    {
+        WaypointCutsceneDesc desc;
+        const int ringPoints = 6;
+        const float radius = 9000.0f;
+        const float heightAboveGround = 900.0f;
+        Vector3 center = { 0.0f, 300.0f, 0.0f };
+
+        for (int i = 0; i <= ringPoints; i++)
+        {
+            float a = (float)(i % ringPoints) / ringPoints * 2.0f * PI;
+            Vector3 p = { cosf(a) * radius, 0.0f, sinf(a) * radius };
+            float ground = GetHeightAtWorldPosition(p);
+            p.y = fmaxf(ground, 0.0f) + heightAboveGround;
+            PushWaypoint(desc, p, center);
+        }
+
+        Vector3 over = { 0.0f, GetHeightAtWorldPosition(center) + 1500.0f, 0.0f };
+        PushWaypoint(desc, over, desc.points[0].position);
+        return desc;
+    }
+
+    // Visits a walkable tile in each cell of a 3x3 grid in serpentine order at eye height.
+    // Segments go straight through walls; fine for a rendering benchmark.
+    static WaypointCutsceneDesc MakeDungeonPath()
+    {
+        WaypointCutsceneDesc desc;
+        const int cells = 3;
+        const float camY = 300.0f;
+
+        for (int cy = 0; cy < cells; cy++)
+        {
+            for (int i = 0; i < cells; i++)
+            {
+                int cx = (cy % 2 == 0) ? i : cells - 1 - i;
+                int midX = (cx * 2 + 1) * dungeonWidth / (cells * 2);
+                int midY = (cy * 2 + 1) * dungeonHeight / (cells * 2);
+
+                // nearest walkable tile to the cell center
+                int bestX = -1, bestY = -1, bestD = INT_MAX;
+                for (int y = cy * dungeonHeight / cells; y < (cy + 1) * dungeonHeight / cells; y++)
+                {
+                    for (int x = cx * dungeonWidth / cells; x < (cx + 1) * dungeonWidth / cells; x++)
+                    {
+                        if (!IsWalkable(x, y, dungeonImg)) continue;
+                        int d = (x - midX) * (x - midX) + (y - midY) * (y - midY);
+                        if (d < bestD) { bestD = d; bestX = x; bestY = y; }
+                    }
+                }
+
+                if (bestX < 0) continue;
+                Vector3 p = DungeonTileCenter(bestX, bestY, dungeonWidth, dungeonHeight, tileSize, camY);
+                PushWaypoint(desc, p, p);
+            }
+        }
+
+        // look toward the next waypoint, last one looks back where it came from
+        for (size_t i = 0; i < desc.points.size(); i++)
+        {
+            size_t next = (i + 1 < desc.points.size()) ? i + 1 : (i > 0 ? i - 1 : i);
+            desc.points[i].target = desc.points[next].position;
+            desc.points[i].target.y = camY;
+        }
+
+        return desc;
+    }
+
+    // ------------------------------------------------------------
+    // Per level
+    // ------------------------------------------------------------
+
+    static void BeginLevel(int index, Camera& camera)
+    {
+        gLevelCursor = index;
+        gFrameInLevel = 0;
+        gLevelFrameTimesMs.clear();
+        gTerrainChunkSum = 0.0;
+        gDungeonInstanceSum = 0.0;
+        gFoliageSum = 0.0;
+        gEnemyUpdateSum = 0.0;
+
+        SeedRandom(12345); // same props and spawns every run
+        InitLevel(levels[index], camera);
+        currentGameState = GameState::Playing;
+
+        // InitLevel may have started an intro cutscene, the flythrough replaces it.
+        ShaderSetup::gBloom.letterboxTarget = 0.0f;
+        GameSettings::drawMinimap = true;
+
+        if (gExtraEnemies > 0)
+        {
+            Vector3 center = levels[index].isDungeon ? player.position : Vector3{ 0.0f, 0.0f, 0.0f };
+            generateRaptors(gExtraEnemies, center, levels[index].isDungeon ? 4000.0f : 9000.0f);
+            player.godMode = true;
+        }
+
+        WaypointCutsceneDesc desc = levels[index].isDungeon ? MakeDungeonPath() : MakeOverworldPath();
+        desc.snapOnStart = true;
+        desc.returnToPlayerOnFinish = false;
+        desc.points.back().durationToNext = 0.0f;
+
+        TraceLog(LOG_INFO, "BENCHMARK: level %d (%s), %d waypoints",
+            index, levels[index].name.c_str(), (int)desc.points.size());
+        CameraSystem::Get().StartWaypointCutscene(desc);
+    }
+
+    static void FinishLevel()
+    {
+        LevelResult r;
+        r.levelIndex = gLevelCursor;
+        r.name = levels[gLevelCursor].name;
+        r.stats = ComputeFrameTimeStats(gLevelFrameTimesMs);
+
+        if (r.stats.frames > 0)
+        {
+            r.avgTerrainChunks = (float)(gTerrainChunkSum / r.stats.frames);
+            r.avgDungeonInstances = (float)(gDungeonInstanceSum / r.stats.frames);
+            r.avgFoliage = (float)(gFoliageSum / r.stats.frames);
+            r.avgEnemyUpdateMs = (float)(gEnemyUpdateSum / r.stats.frames);
+        }
+        r.enemies = (int)enemies.size();
+
+        TraceLog(LOG_INFO, "BENCHMARK: %s  %d frames  avg %.2f ms  p95 %.2f  p99 %.2f  enemies %d (%.3f ms)",
+            r.name.c_str(), r.stats.frames, r.stats.avgMs, r.stats.p95Ms, r.stats.p99Ms,
+            r.enemies, r.avgEnemyUpdateMs);
+
+        gResults.push_back(r);
+    }
+
+    static void WriteCsv(const FrameTimeStats& all, float score)
+    {
+        std::ofstream csv(gCsvPath);
+        if (!csv.is_open())
+        {
+            TraceLog(LOG_WARNING, "BENCHMARK: could not write %s", gCsvPath.c_str());
+            return;
+        }
+
+        csv << "level,name,frames,avg_ms,p50_ms,p95_ms,p99_ms,max_ms,"
+               "avg_terrain_chunks,avg_dungeon_instances,avg_foliage,enemies,avg_enemy_update_ms,"
+               "draw_dist,width,height,score\n";
+
+        for (const LevelResult& r : gResults)
+        {
+            csv << r.levelIndex << ',' << r.name << ',' << r.stats.frames << ','
+                << r.stats.avgMs << ',' << r.stats.p50Ms << ',' << r.stats.p95Ms << ','
+                << r.stats.p99Ms << ',' << r.stats.maxMs << ','
+                << r.avgTerrainChunks << ',' << r.avgDungeonInstances << ',' << r.avgFoliage << ','
+                << r.enemies << ',' << r.avgEnemyUpdateMs << ','
+                << GameSettings::maxDrawDist << ',' << GetScreenWidth() << ',' << GetScreenHeight() << ",\n";
+        }
+
+        csv << "-1,ALL," << all.frames << ','
+            << all.avgMs << ',' << all.p50Ms << ',' << all.p95Ms << ','
+            << all.p99Ms << ',' << all.maxMs << ",,,,,,"
+            << GameSettings::maxDrawDist << ',' << GetScreenWidth() << ',' << GetScreenHeight() << ','
+            << score << '\n';
+    }
+
+    static void Finish()
+    {
+        FrameTimeStats all = ComputeFrameTimeStats(gAllFrameTimesMs);
+        float score = (all.p95Ms > 0.0f) ? 1000.0f / all.p95Ms : 0.0f;
+
+        WriteCsv(all, score);
+        TraceLog(LOG_INFO, "BENCHMARK: done, score %.1f (p95 %.2f ms), results in %s",
+            score, all.p95Ms, gCsvPath.c_str());
+
+        GameSettings::freezeAI = gSavedFreezeAI;
+        GameSettings::showTutorial = gSavedShowTutorial;
+        player.godMode = gSavedGodMode;
+        gRunning = false;
+        currentGameState = GameState::Quit;
+    }
+
+    // ------------------------------------------------------------
+    // Public API
+    // ------------------------------------------------------------
+
+    bool Start(const std::string& csvPath, Camera& camera, int extraEnemies)
+    {
+        if (levels.empty()) return false;
+
+        gCsvPath = csvPath;
+        gResults.clear();
+        gAllFrameTimesMs.clear();
+
+        gSavedFreezeAI = GameSettings::freezeAI;
+        gSavedShowTutorial = GameSettings::showTutorial;
+        gSavedGodMode = player.godMode;
+        gExtraEnemies = extraEnemies;
+        GameSettings::freezeAI = (extraEnemies == 0); //the enemy benchmark needs them thinking
+        GameSettings::showTutorial = false;
+
+        gRunning = true;
+        BeginLevel(0, camera);
+        return true;
+    }
+
+    bool IsRunning()
+    {
+        return gRunning;
+    }
+
+    float StepDt()
+    {
+        return STEP_DT;
+    }
+
+    void BeginFrame(Camera& camera)
+    {
+        if (!gRunning) return;
+
+        // GetFrameTime() and the overlay counts describe the frame that was just drawn.
+        if (gFrameInLevel++ >= WARMUP_FRAMES)
+        {
+            float ms = GetFrameTime() * 1000.0f;
+            gLevelFrameTimesMs.push_back(ms);
+            gAllFrameTimesMs.push_back(ms);
+
+            DebugOverlayInfo info;
+            UpdateOverlayInfo(info);
+            gTerrainChunkSum += info.visibleTerrainChunks;
+            gDungeonInstanceSum += info.visibleInstances;
+            gFoliageSum += info.visibleFoliage;
+            gEnemyUpdateSum += info.enemyUpdateMs;
+        }
+
+        if (CameraSystem::Get().IsWaypointCutsceneActive()) return;
+
+        FinishLevel();
+
+        if (gLevelCursor + 1 < (int)levels.size())
+        {
+            BeginLevel(gLevelCursor + 1, camera);
+        }
+        else
+        {
+            Finish();
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "raylib.h"
+#include <string>
+
+// Automated benchmark: launch with  --benchmark [file.csv] [--drawdist <units>] [--enemies <count>]
+//
+// Loads every entry in `levels` in turn with AI frozen and flies a fixed waypoint path
+// through it. The camera advances by a fixed step per frame, so every build renders the
+// same frames. Per level it records frame time percentiles and the average visible
+// terrain chunks, dungeon instances and foliage from DebugOverlayInfo, writes one CSV
+// row per level plus a total row, and quits when the last level is done.
+//
+// score = 1000 / p95 frame time over all levels (the fps 95% of frames hit). Higher is better.
+//
+// --enemies N adds N raptors to each level and runs the AI (player in god mode), so the
+// avg_enemy_update_ms column shows how enemy update cost scales with the count.
+
+namespace Benchmark
+{
+    bool Start(const std::string& csvPath, Camera& camera, int extraEnemies = 0);
+    bool IsRunning();
+
+    // Call once at the top of the main loop. Samples the previous frame and
+    // moves on to the next level when the flythrough finishes.
+    void BeginFrame(Camera& camera);
+
+    // Fixed sim/camera step used while the benchmark runs.
+    float StepDt();
+}
@@ -4,6 +4,7 @@
 #include "world.h"
 #include <iostream>
 #include "shaderSetup.h"
+#include "replay.h"
 
 Boat player_boat{};
 
@@ -41,13 +42,13 @@ void UpdateBoat(Boat& boat, float deltaTime) {
 
     // Turning
     if (controlPlayer) {
-        if (IsKeyDown(KEY_D)) boat.rotationY -= boat.turnSpeed * deltaTime;
-        if (IsKeyDown(KEY_A)) boat.rotationY += boat.turnSpeed * deltaTime;
+        if (Replay::IsKeyDown(KEY_D)) boat.rotationY -= boat.turnSpeed * deltaTime;
+        if (Replay::IsKeyDown(KEY_A)) boat.rotationY += boat.turnSpeed * deltaTime;
 
         // Forward/slowdown
-        if (IsKeyDown(KEY_W)) {
+        if (Replay::IsKeyDown(KEY_W)) {
             boat.speed += boat.acceleration * deltaTime;
-        } else if (IsKeyDown(KEY_S)) {
+        } else if (Replay::IsKeyDown(KEY_S)) {
             boat.speed -= boat.acceleration * deltaTime;
         } else {
             boat.speed *= 0.999f; // drag
@@ -67,7 +68,7 @@ void UpdateBoat(Boat& boat, float deltaTime) {
     Vector3 proposedPosition = Vector3Add(boat.position, Vector3Scale(boat.velocity, deltaTime));
 
     // Sample height at next position
-    float terrainHeight = GetHeightAtWorldPosition(proposedPosition, heightmap, terrainScale);
+    float terrainHeight = GetHeightAtWorldPosition(proposedPosition);
 
     if (terrainHeight <= 60.0f) {
         // Water — move the boat
@@ -109,7 +110,7 @@ static Color GetTimeOfDayGrayTint()
 
 void DrawBoat(const Boat& boat) {
     if (!boat.active) return;
-    float bob = sinf(GetTime() * 2.0f) * 2.0f;
+    float bob = sinf(Replay::GetTime() * 2.0f) * 2.0f;
     Vector3 drawPos = boat.position;
     if (!boat.beached) drawPos.y += bob;
 
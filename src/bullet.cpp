@@ -14,8 +14,6 @@
 #include "rlgl.h"
 #include <cstdint>
 
-static unsigned int gBulletCounter = 0;
-
 Bullet::Bullet(Vector3 startPos, Vector3 vel, float lifetime, bool en, BulletType t, float r, bool launch)
     : position(startPos),
       velocity(vel),
@@ -134,7 +132,7 @@ void Bullet::UpdateMagicBall(Camera& camera, float deltaTime) {
             return;
         }
     } else {
-        float terrainHeight = GetHeightAtWorldPosition(position, heightmap, terrainScale);
+        float terrainHeight = GetHeightAtWorldPosition(position);
         if (position.y <= terrainHeight) {
             Explode(camera);
             return;
@@ -191,7 +189,7 @@ void Bullet::HandleBulletWorldCollision(){
         }
     } else {
         // Overworld: terrain height varies; sampling each frame is fine.
-        float h = GetHeightAtWorldPosition(position, heightmap, terrainScale);
+        float h = GetHeightAtWorldPosition(position);
         if (prevPosition.y > h && position.y <= h) {
             Vector3 n = {0, 1, 0};
             if (position.y <= 60){
@@ -500,7 +498,7 @@ void DrawHarpoon(const Bullet& b, const Camera& camera)
 
     if (b.stuck)
     {
-        Character* e = FindEnemyById(b.stuckEnemyId); // lookup in enemyPtrs 
+        Character* e = enemies.Get(b.stuckEnemy); // nullptr once the enemy is removed
         if (e)
             tip = Vector3Add(e->position, b.stuckOffset);
     }
@@ -630,7 +628,7 @@ void Bullet::BulletHole(Camera& camera, bool enemy){
     Vector3 camDir = Vector3Normalize(Vector3Subtract(position, camera.position));
     Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, forward));
 
-    decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("bulletHoleSheet"), 5, 1.0f, 0.2f, size);
+    decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("bulletHoleSheet"), 5, 1.0f, 0.2f, size);
     exploded = true;
     alive = false; //kill the bullet
 
@@ -677,7 +675,7 @@ void Bullet::Explode(Camera& camera) {
         Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, 100.0f));
 
         if (type == BulletType::Fireball || type == BulletType::CannonBall){
-            decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("explosionSheet"), 13, 1.0f, 0.1f, 500.0f);
+            decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("explosionSheet"), 13, 1.0f, 0.1f, 500.0f);
             fireEmitter.EmitBurst(position, 200, ParticleType::Sparks);
             //Vector3 forward = Vector3Negate(Vector3Normalize(velocity));
             ExplodeShrapnelSphere(position, 10, 1500.0f, 1.0f, false);
@@ -789,8 +787,7 @@ void ExplodeShrapnelSphere(Vector3 origin, int pelletCount,float speed,float lif
         b.initialSpeed = Vector3Length(b.velocity);
         if (b.initialSpeed < 1.0f) b.initialSpeed = 1.0f;
         b.size = 10.0f;
-        b.id = gBulletCounter++;
-        activeBullets.emplace_back(b);
+        activeBullets.Spawn(std::move(b));
     }
 }
 
@@ -798,17 +795,15 @@ void FireCrossbow(Vector3 origin, Vector3 forward, float speed, float lifetime,
     Vector3 vel = Vector3Scale(forward, speed);
     Bullet bolt = {origin, vel, lifetime, enemy, BulletType::Bolt};
     bolt.rotation =  QuaternionFromVector3ToVector3({0,0,1}, forward);
-    bolt.id = gBulletCounter++;
-    activeBullets.emplace_back(bolt);
+    activeBullets.Spawn(std::move(bolt));
 }
 
 void FireCrossbowHarpoon(Vector3 origin, Vector3 forward, float speed, float lifetime, bool enemy) {
     Vector3 vel = Vector3Scale(forward, speed);
     Bullet harpoon = {origin, vel, lifetime, enemy, BulletType::Harpoon};
     harpoon.rotation =  QuaternionFromVector3ToVector3({0,0,1}, forward);
-    harpoon.id = gBulletCounter++;
     harpoon.lifeTime = 2.5f;
-    activeBullets.emplace_back(harpoon);
+    activeBullets.Spawn(std::move(harpoon));
 }
 
 void FireBlunderbuss(Vector3 origin, Vector3 forward, float spreadDegrees, int pelletCount, float speed, float lifetime, bool enemy) {
@@ -837,8 +832,7 @@ void FireBlunderbuss(Vector3 origin, Vector3 forward, float spreadDegrees, int p
 
         b.initialSpeed = Vector3Length(b.velocity); //set initial speed. 
         if (b.initialSpeed < 1.0f) b.initialSpeed = 1.0f;
-        b.id = gBulletCounter++;
-        activeBullets.emplace_back(b);
+        activeBullets.Spawn(std::move(b));
 
     }
 }
@@ -850,10 +844,9 @@ void FireCannon(Vector3 origin, Vector3 target, float speed, float lifetime, boo
     Bullet b = {origin, velocity, lifetime, enemy};
     b.type = BulletType::CannonBall;
     b.alive = true;
-    b.id = gBulletCounter++;
-    activeBullets.push_back(b);
+    activeBullets.Spawn(std::move(b));
 
-    SoundManager::GetInstance().PlaySoundAtPosition("CannonShot", b.position, player.position, 0.0f, 10000.0f);
+    SoundManager::GetInstance().PlaySoundAtPosition("CannonShot", origin, player.position, 0.0f, 10000.0f);
 }
 
 void FireBullet(Vector3 origin, Vector3 target, float speed, float lifetime, bool enemy, bool hermit) {
@@ -861,10 +854,9 @@ void FireBullet(Vector3 origin, Vector3 target, float speed, float lifetime, boo
     direction = Vector3Normalize(direction);
     Vector3 velocity = Vector3Scale(direction, speed);
     Bullet b = {origin, velocity, lifetime, enemy};
-    b.id = gBulletCounter++;
     b.hermit = hermit;
 
-    activeBullets.push_back(b);
+    activeBullets.Spawn(std::move(b));
 }
 
 void FireFireball(Vector3 origin, Vector3 target, float speed, float lifetime, bool enemy, bool launcher, bool wizard) {
@@ -872,7 +864,7 @@ void FireFireball(Vector3 origin, Vector3 target, float speed, float lifetime, b
     Vector3 velocity = Vector3Scale(direction, speed);
 
 
-    Bullet& b = activeBullets.emplace_back(origin, velocity, lifetime, enemy, BulletType::Fireball, 20.0f, launcher);
+    Bullet& b = activeBullets.Spawn(origin, velocity, lifetime, enemy, BulletType::Fireball, 20.0f, launcher);
 
     b.light.active     = true;
     b.light.color      = (b.type==BulletType::Fireball)? lightConfig.dynamicFireColor : lightConfig.dynamicIceColor;
@@ -880,7 +872,6 @@ void FireFireball(Vector3 origin, Vector3 target, float speed, float lifetime, b
     b.light.intensity  = lightConfig.dynamicIntensity;
     b.light.detachOnDeath = true;
     b.light.lifeTime   = 0.15f; // short glow after death
-    b.id = gBulletCounter++;
     b.wizard = wizard;
 
     
@@ -892,7 +883,7 @@ void FireIceball(Vector3 origin, Vector3 target, float speed, float lifetime, bo
     Vector3 direction = Vector3Normalize(Vector3Subtract(target, origin));
     Vector3 velocity = Vector3Scale(direction, speed);
 
-    Bullet& b = activeBullets.emplace_back(origin, velocity, lifetime, enemy, BulletType::Iceball, 20.0f, launcher); //larger radius 75, so you can't avoid in hallways
+    Bullet& b = activeBullets.Spawn(origin, velocity, lifetime, enemy, BulletType::Iceball, 20.0f, launcher); //larger radius 75, so you can't avoid in hallways
 
     b.light.active     = true;
     b.light.color      = lightConfig.dynamicIceColor;
@@ -900,8 +891,60 @@ void FireIceball(Vector3 origin, Vector3 target, float speed, float lifetime, bo
     b.light.intensity  = lightConfig.dynamicIntensity;
     b.light.detachOnDeath = true;
     b.light.lifeTime   = 0.15f; // short glow after death
-    b.id = gBulletCounter++;
 
     SoundManager::GetInstance().PlaySoundAtPosition("iceMagic", origin, player.position, 0.0f, 3000.0f);
 }
 
+
+// ------------------------------------------------------------
+// BulletPool
+// ------------------------------------------------------------
+
+BulletHandle BulletPool::AllocSlot() {
+    BulletHandle h;
+    if (!freeSlots.empty()) {
+        h.index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        h.index = (uint32_t)slots.size();
+        slots.push_back(Slot{});
+    }
+    slots[h.index].dense = PENDING;
+    h.generation = slots[h.index].generation;
+    return h;
+}
+
+void BulletPool::CommitSpawns() {
+    if (pending.empty()) return;
+    if (dense.capacity() == 0) dense.reserve(256);
+
+    for (Bullet& b : pending) {
+        slots[b.handle.index].dense = (int)dense.size();
+        dense.push_back(std::move(b));
+    }
+    pending.clear();
+}
+
+void BulletPool::RemoveAt(size_t i) {
+    Slot& gone = slots[dense[i].handle.index];
+    gone.dense = -1;
+    gone.generation++;
+    freeSlots.push_back(dense[i].handle.index);
+
+    if (i + 1 != dense.size()) {
+        dense[i] = std::move(dense.back());
+        slots[dense[i].handle.index].dense = (int)i;
+    }
+    dense.pop_back();
+}
+
+void BulletPool::clear() {
+    dense.clear();
+    pending.clear();
+    freeSlots.clear();
+    for (uint32_t i = 0; i < (uint32_t)slots.size(); i++) {
+        slots[i].dense = -1;
+        slots[i].generation++; // outstanding handles go stale
+        freeSlots.push_back(i);
+    }
+}
@@ -6,6 +6,8 @@
 #include "emitter.h"
 #include "raymath.h"
 #include <cstdint>
+#include "enemy_handle.h"
+#include <utility>
 
 enum class BulletType {
     Default,
@@ -32,6 +34,15 @@ struct BulletLight {
 };
 
 
+// Stable reference to a bullet in activeBullets. Survives other bullets being removed,
+// goes stale (Get returns nullptr) once its own bullet is erased.
+struct BulletHandle
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+    bool IsValid() const { return index != UINT32_MAX; }
+};
+
 class Bullet {
 public:
     Bullet(Vector3 position, Vector3 velocity, float lifetime, bool enemy,  BulletType t = BulletType::Default, float radius = 25.0f, bool launcher = false);
@@ -55,7 +66,8 @@ public:
     float gravity = 300.0f;
 
     float timer = 0.0f;
-    unsigned int id = 0;
+    unsigned int id = 0;       // serial, never reused. set by BulletPool::Spawn
+    BulletHandle handle;       // set by BulletPool::Spawn
 
     Vector3 prevPosition = {0.0f, 0.0f, 0.0f};
     Quaternion rotation = {0.0f, 0.0f, 0.0f, 1.0f};
@@ -75,7 +87,7 @@ public:
     bool explosionTriggered = false;
 
     bool   stuck = false;
-    int    stuckEnemyId = -1;
+    EnemyHandle stuckEnemy;            // invalid = stuck to the world, not an enemy
     Vector3 stuckOffset = {0, 0, 0};   // world-space offset from enemy.position
     bool retracting = false;
     float retractSpeed = 4000.0f; // units/sec tweak
@@ -119,6 +131,63 @@ public:
 
 
 };
+// Slot map for bullets. Live bullets are dense in one vector (cache friendly to iterate),
+// handles go through a slot table with generations, removal is swap-remove.
+//
+// Spawn() puts new bullets in a pending list that joins the dense array at CommitSpawns(),
+// so code iterating activeBullets can spawn more (explosion shrapnel) without the vector
+// reallocating under it. Pending bullets are not visited by iteration until committed.
+class BulletPool {
+public:
+    template<typename... Args>
+    Bullet& Spawn(Args&&... args) {
+        pending.emplace_back(std::forward<Args>(args)...);
+        Bullet& b = pending.back();
+        b.id = nextId++;
+        b.handle = AllocSlot();
+        return b;
+    }
+
+    void CommitSpawns();
+
+    // Swap-removes every committed bullet pred(b) is true for and invalidates its handle.
+    template<typename Pred>
+    void RemoveIf(Pred pred) {
+        for (size_t i = 0; i < dense.size(); ) {
+            if (pred(dense[i])) { RemoveAt(i); continue; }
+            i++;
+        }
+    }
+
+    void clear();
+
+    size_t size() const { return dense.size(); }
+    bool empty() const { return dense.empty(); }
+
+    std::vector<Bullet>::iterator begin() { return dense.begin(); }
+    std::vector<Bullet>::iterator end() { return dense.end(); }
+    std::vector<Bullet>::const_iterator begin() const { return dense.begin(); }
+    std::vector<Bullet>::const_iterator end() const { return dense.end(); }
+
+private:
+    static constexpr int PENDING = -2;
+
+    struct Slot
+    {
+        int dense = -1;            // index into dense, PENDING, or -1 when free
+        uint32_t generation = 0;
+    };
+
+    BulletHandle AllocSlot();
+    void RemoveAt(size_t i);
+
+    std::vector<Bullet> dense;
+    std::vector<Bullet> pending;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    unsigned int nextId = 0;
+};
+
 void ExplodeShrapnelSphere(Vector3 origin, int pelletCount =10,float speed = 2000.0f,float lifetime = 0.6f,bool enemy = false);
 void FireBlunderbuss(Vector3 origin, Vector3 forward, float spreadDegrees, int pelletCount, float speed, float lifetime, bool enemy);
 void FireBullet(Vector3 origin, Vector3 target, float speed, float lifetime, bool enemy, bool hermit);
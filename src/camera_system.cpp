@@ -9,6 +9,7 @@
 #include "shaderSetup.h"
 #include "boat.h"
 #include "dungeonGeneration.h"
+#include "replay.h"
 
 DeathCamState deathCam;
 
@@ -448,9 +449,9 @@ void CameraSystem::Shake(float mag, float dur) { shakeMag = mag; shakeTime = dur
 void CameraSystem::ApplyShake(float dt) {
     if (shakeTime <= 0.f) return;
     shakeTime -= dt;
-    Vector3 jitter = { (GetRandomValue(-100,100)/100.f)*shakeMag,
-                       (GetRandomValue(-100,100)/100.f)*shakeMag,
-                       (GetRandomValue(-100,100)/100.f)*shakeMag };
+    Vector3 jitter = { (RandomInt(-100,100)/100.f)*shakeMag,
+                       (RandomInt(-100,100)/100.f)*shakeMag,
+                       (RandomInt(-100,100)/100.f)*shakeMag };
     if (mode == CamMode::Player) playerRig.cam.position = Vector3Add(playerRig.cam.position, jitter);
     else                         freeRig.cam.position   = Vector3Add(freeRig.cam.position, jitter);
 }
@@ -719,19 +720,19 @@ void CameraSystem::UpdatePlayerCam(float dt)
 void CameraSystem::UpdateFreeCam(float dt) {
     if (DebugConsole::IsOpen()) return;
 
-    const float speed = (IsKeyDown(KEY_LEFT_SHIFT) ? 1500.f : 900.f);
+    const float speed = (Replay::IsKeyDown(KEY_LEFT_SHIFT) ? 1500.f : 900.f);
     Vector3 f = Vector3Normalize(Vector3Subtract(freeRig.cam.target, freeRig.cam.position));
     Vector3 r = Vector3Normalize(Vector3CrossProduct(f, {0,1,0}));
 
     Vector3 move{0,0,0};
-    if (IsKeyDown(KEY_W)) move = Vector3Add(move, f);
-    if (IsKeyDown(KEY_S)) move = Vector3Subtract(move, f);
-    if (IsKeyDown(KEY_A)) move = Vector3Subtract(move, r);
-    if (IsKeyDown(KEY_D)) move = Vector3Add(move, r);
+    if (Replay::IsKeyDown(KEY_W)) move = Vector3Add(move, f);
+    if (Replay::IsKeyDown(KEY_S)) move = Vector3Subtract(move, f);
+    if (Replay::IsKeyDown(KEY_A)) move = Vector3Subtract(move, r);
+    if (Replay::IsKeyDown(KEY_D)) move = Vector3Add(move, r);
 
     // vertical controls
-    if (IsKeyDown(KEY_SPACE)) move = Vector3Add(move, {0, 1, 0});
-    if (IsKeyDown(KEY_LEFT_CONTROL)) move = Vector3Add(move, {0, -1, 0}); 
+    if (Replay::IsKeyDown(KEY_SPACE)) move = Vector3Add(move, {0, 1, 0});
+    if (Replay::IsKeyDown(KEY_LEFT_CONTROL)) move = Vector3Add(move, {0, -1, 0}); 
 
     if (Vector3Length(move) > 0) {
         move = Vector3Scale(Vector3Normalize(move), speed * dt);
@@ -740,7 +741,7 @@ void CameraSystem::UpdateFreeCam(float dt) {
     }
 
     // Mouse look
-    Vector2 delta = GetMouseDelta();
+    Vector2 delta = Replay::GetMouseDelta();
     float sens = 0.05f; //matches player's 
     freeRig.yaw   -= delta.x * sens;
     freeRig.pitch += -delta.y * sens;
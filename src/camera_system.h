@@ -201,6 +201,7 @@ public:
     void StartWaypointCutscene(const WaypointCutsceneDesc& desc);
 
     bool IsCutsceneActive() const { return cutsceneActive; }
+    bool IsWaypointCutsceneActive() const { return waypointActive; }
     bool aspectSquare = false;
 
 
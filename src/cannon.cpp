@@ -4,6 +4,7 @@
 #include "world.h"
 #include "raymath.h"
 #include "sound_manager.h"
+#include "replay.h"
 
 
 namespace
@@ -38,7 +39,7 @@ void Cannon::Update(float dt, Player& player)
     // Minimal interact example:
     // If player is close and presses E, fire if loaded.
     // Loading itself can be triggered elsewhere when a cannonball box is dropped nearby.
-    if (IsPlayerInRange(player) && IsKeyPressed(KEY_E))
+    if (IsPlayerInRange(player) && Replay::IsKeyPressed(KEY_E))
     {
         if (CanFire())
         {
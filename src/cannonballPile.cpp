@@ -4,6 +4,7 @@
 #include "resourceManager.h"
 #include "iostream"
 #include "dungeonGeneration.h"
+#include "replay.h"
 // assuming you have a global resource manager like R
 
 const int kMaxLooseCannonBalls = 5;
@@ -41,7 +42,7 @@ void CannonballPile::Update(Player& player)
 {
     if (!IsPlayerInRange(player)) return;
 
-    if (IsKeyPressed(KEY_E))
+    if (Replay::IsKeyPressed(KEY_E))
     {
         if (!player.isCarrying && CountLooseCannonBalls() < kMaxLooseCannonBalls)
         {
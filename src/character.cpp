@@ -52,9 +52,9 @@ void Character::playRaptorSounds()
     if (raptorSoundCooldown > 0.0f) return;
 
     // 1.5–3 second cooldown randomization for variety
-    raptorSoundCooldown = GetRandomValue(1500, 3000) / 1000.0f;
+    raptorSoundCooldown = RandomInt(1500, 3000) / 1000.0f;
 
-    int rn = GetRandomValue(1, 3);
+    int rn = RandomInt(1, 3);
 
     auto& sm = SoundManager::GetInstance();
     switch (rn){
@@ -79,8 +79,8 @@ void Character::ApplyGroundSnap()
     // Get current feet pos
     Vector3 feet = GetFeetPos();
 
-    // Sample the terrain height at this XZ
-    float groundY = GetHeightAtWorldPosition(feet, heightmap, terrainScale);
+    // Terrain height at this XZ, sampled at the top of Update
+    float groundY = groundHeight;
     if (isDungeon) groundY = floorHeight;
 
     feet.y = groundY;
@@ -88,10 +88,18 @@ void Character::ApplyGroundSnap()
 
 }
 
+bool Character::IsBloatBat() const
+{
+    if (type != CharacterType::Bat) return false;
+    const BatData* bat = enemies.Bat(handle);
+    return bat && bat->bloatBat;
+}
+
 void Character::ApplyAreaDamage()
 {
-    if (hasExploded) return;
-    hasExploded = true;
+    BatData* bat = enemies.Bat(handle);
+    if (!bat || bat->hasExploded) return;
+    bat->hasExploded = true;
 
     const float minDamage = 10.0f;
     const float maxDamage = 50.0f;
@@ -112,7 +120,7 @@ void Character::ApplyAreaDamage()
         Vector3 camDir = Vector3Normalize(Vector3Subtract(position, camera.position));
         Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, 100.0f));
 
-        decals.emplace_back(
+        decals.Spawn(
             offsetPos,
             DecalType::Explosion,
             R.GetTexture("explosionSheet"),
@@ -203,7 +211,7 @@ void Character::PlayDeathSound() {
 
     case CharacterType::Pirate:
     case CharacterType::Wizard:
-        if (GetRandomValue(0,1) > 0){
+        if (RandomInt(0,1) > 0){
             SoundManager::GetInstance().PlaySoundAtPosition("pirateDeath", position, player.position, 0.0f, 3000);
         }else{
             SoundManager::GetInstance().PlaySoundAtPosition("deathScream", position, player.position, 0.0f, 3000);
@@ -233,7 +241,7 @@ void Character::PlayDamageSounds(){
             break;
 
         case CharacterType::Trex:
-            SoundManager::GetInstance().PlaySoundAtPosition(GetRandomValue(0, 1) == 0 ? "TrexHurt2" : "TrexHurt", position, player.position, 0.0f, 3000);
+            SoundManager::GetInstance().PlaySoundAtPosition(RandomInt(0, 1) == 0 ? "TrexHurt2" : "TrexHurt", position, player.position, 0.0f, 3000);
             break;
 
         case CharacterType::GiantSpider:
@@ -253,28 +261,28 @@ void Character::SpawnFlyingGib(Vector3 spawnPos, DecalType type, const std::stri
 {
     Decal decal = {spawnPos, type, R.GetTexture(textureName), 4, 2.0f, 0.25f, 32.0f};
 
-    decal.canBounce = (GetRandomValue(0, 1) == 1);
+    decal.canBounce = (RandomInt(0, 1) == 1);
     decal.hasBounced = false;
 
     decal.velocity = {
-        (float)GetRandomValue(-180, 180),
-        (float)GetRandomValue(250, 420),
-        (float)GetRandomValue(-180, 180)
+        (float)RandomInt(-180, 180),
+        (float)RandomInt(250, 420),
+        (float)RandomInt(-180, 180)
     };
 
     if (type == DecalType::Bone){
         decal.velocity = {
-            (float)GetRandomValue(-250, 250),
-            (float)GetRandomValue(400, 620),
-            (float)GetRandomValue(-250, 250)
+            (float)RandomInt(-250, 250),
+            (float)RandomInt(400, 620),
+            (float)RandomInt(-250, 250)
         };
     }
 
     if (emitBlood) {
-        decal.bloodEmitter.EmitBlood(decal.position, 20, RED);
+        decalBlood.EmitBlood(decal.position, 20, RED);
     }
 
-    decals.emplace_back(decal);
+    decals.Spawn(decal);
 }
 
 void Character::SpawnGibs(){
@@ -284,7 +292,7 @@ void Character::SpawnGibs(){
 
     if (type == CharacterType::Skeleton && canGib){ //skeletons emit bones when taking damage.
         canGib = false;
-        int randomNumber = GetRandomValue(1,4);
+        int randomNumber = RandomInt(1,4);
         for (int i = 0; i < randomNumber; i++){
             SpawnFlyingGib(position, DecalType::Bone, "boneSpin", false);
         }
@@ -303,11 +311,11 @@ void Character::SpawnGibs(){
         // Prevent this zombie from rolling again on every subsequent hit.
         canLoseLimb = false;
 
-        if (GetRandomValue(0, 1) == 1) // One 50% roll
+        if (RandomInt(0, 1) == 1) // One 50% roll
         {
             lostLimb = true;
 
-            if (GetRandomValue(0, 1) == 1)
+            if (RandomInt(0, 1) == 1)
             {
                 texture = R.GetTexture("zombieSheetArmless");
                 SpawnFlyingGib(
@@ -436,10 +444,10 @@ void Character::TakeDamage(int amount) {
             Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
             Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, 50.0f));
             offsetPos.y += 10; 
-            decals.emplace_back(offsetPos, DecalType::Blood, R.GetTexture("bloodSheet"), 8, 0.7f, 0.07f,128.0f);
+            decals.Spawn(offsetPos, DecalType::Blood, R.GetTexture("bloodSheet"), 8, 0.7f, 0.07f,128.0f);
         }
 
-        if (type == CharacterType::Bat && bloatBat)
+        if (IsBloatBat())
         {
             ApplyAreaDamage();       
 
@@ -507,6 +515,10 @@ void Character::UpdateAltitude(float dt, float groundY, float desiredAltitude)
 
     // Accelerate verticalVel toward desiredVY
     //float ay = Clamp(desiredVY - verticalVel, -MAX_CLIMB_ACCEL, MAX_CLIMB_ACCEL);
+    DactylData* dactyl = enemies.Dactyl(handle);
+    if (!dactyl) return;
+    float& verticalVel = dactyl->verticalVel;
+
     float maxAccel = (desiredVY < verticalVel) ? MAX_DIVE_ACCEL : MAX_CLIMB_ACCEL;
     float ay = Clamp(desiredVY - verticalVel, -maxAccel, maxAccel);
     verticalVel += ay * dt;
@@ -523,7 +535,7 @@ void Character::UpdateAltitude(float dt, float groundY, float desiredAltitude)
 
 
 
-void Character::Update(float deltaTime, Player& player ) {
+void Character::Update(float deltaTime, Player& player, float aiDeltaTime) {
     if (isLoadingLevel) return;
     bloodEmitter.UpdateBlood(deltaTime);
     
@@ -533,10 +545,13 @@ void Character::Update(float deltaTime, Player& player ) {
     if (raptorSoundCooldown < 0) raptorSoundCooldown = 0;
 
     spriteHeight = frameHeight * scale;
+
+    // one heightmap sample per frame, shared by the ground snap, the dactyl clamp and the blob shadow
+    if (!isDungeon) groundHeight = GetHeightAtWorldPosition(position);
     if (!isDungeon && type != CharacterType::Pterodactyl) ApplyGroundSnap();
 
 
-    float groundY = GetHeightAtWorldPosition(position, heightmap, terrainScale); //get groundY from heightmap
+    float groundY = groundHeight;
     if (type == CharacterType::Pterodactyl){
         if (GetFeetPos().y < groundY) SetFeetPos(Vector3 {position.x, groundY, position.z}); //prevent dactyls from going underground
     }
@@ -588,23 +603,26 @@ void Character::Update(float deltaTime, Player& player ) {
     }
 
     
-    //Run AI state machine depending on characterType
-    UpdateAI(deltaTime,player);
+    //Run AI state machine depending on characterType. Distant enemies think less often (AIScheduler)
+    if (aiDeltaTime < 0.0f) aiDeltaTime = deltaTime;
+    if (aiDeltaTime > 0.0f) UpdateAI(aiDeltaTime, player);
+    think.valid = false;
 
-    if (type == CharacterType::Bat && deathTimer <= 0.0f){
+    BatData* bat = (type == CharacterType::Bat) ? enemies.Bat(handle) : nullptr;
+    if (bat && deathTimer <= 0.0f){
         // Advance phase
-        bobPhase += bobSpeed * deltaTime;
+        bat->bobPhase += bat->bobSpeed * deltaTime;
 
         // Keep it bounded (optional but tidy)
-        if (bobPhase > 2.0f * PI)
-            bobPhase -= 2.0f * PI;
+        if (bat->bobPhase > 2.0f * PI)
+            bat->bobPhase -= 2.0f * PI;
 
         // Compute bob offset
-        float bobOffset = sinf(bobPhase) * bobAmplitude;
+        float bobOffset = sinf(bat->bobPhase) * bat->bobAmplitude;
 
         // Final vertical position
 
-        position.y = groundY + hoverHeight + bobOffset;
+        position.y = groundY + bat->hoverHeight + bobOffset;
 
     }
 
@@ -959,7 +977,7 @@ AnimDesc Character::GetAnimFor(CharacterType type, CharacterState state) {
                 case CharacterState::Chase:
                 case CharacterState::Patrol:
                 case CharacterState::Reposition:
-                    if (bloatBat){
+                    if (IsBloatBat()){
                         return AnimDesc{6, 4, 0.2f, true}; // walk
                     }else{
                         return AnimDesc{1, 4, 0.2f, true}; // walk
@@ -969,7 +987,7 @@ AnimDesc Character::GetAnimFor(CharacterType type, CharacterState state) {
                 case CharacterState::Freeze: return {0, 1, 1.0f, true};
                 case CharacterState::Idle:
                 {
-                   if (bloatBat){
+                   if (IsBloatBat()){
                         return AnimDesc{6, 4, 0.2, true}; // idle
                    }else{
                         return AnimDesc{0, 5, 0.2f, true};
@@ -982,7 +1000,7 @@ AnimDesc Character::GetAnimFor(CharacterType type, CharacterState state) {
                 case CharacterState::Stagger: return {4, 1, 1.0f, false}; // Use first frame of death anim for 1 second. for all enemies
 
                 case CharacterState::Death:
-                    if (bloatBat){
+                    if (IsBloatBat()){
                         return AnimDesc{5, 5, 0.2, false};
                     }else{
                         return AnimDesc{4, 5, 0.15f, false};
@@ -1082,12 +1100,12 @@ void Character::ChangeState(CharacterState next) {
     stateTimer = 0.0f;
 
     if (type == CharacterType::Raptor && state == CharacterState::Chase){
-        chaseDuration = GetRandomValue(10, 20);
+        chaseDuration = RandomInt(10, 20);
         playRaptorSounds(); //play a random tweet when switching to chase. 
     }
 
     if (type == CharacterType::Trex && state == CharacterState::Chase){
-        chaseDuration = GetRandomValue(10, 20);
+        chaseDuration = RandomInt(10, 20);
 
     }
 
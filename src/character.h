@@ -6,6 +6,8 @@
 #include "emitter.h"
 #include "utilities.h"
 #include "decal.h"
+#include "enemy_handle.h"
+#include "ai_scheduler.h"
 
 enum class CharacterType {
     Raptor,
@@ -44,6 +46,21 @@ enum class SpawnSource {
     Player
 };
 
+// Results of Character::Think. Written on a worker during the parallel phase of
+// UpdateEnemies, read by UpdateAI on the main thread in the same frame.
+struct AIThink {
+    bool valid = false;             // Think ran this frame
+
+    bool hasPlayerLOS = false;      // canSeePlayer below was computed (epsilon 0)
+    bool canSeePlayer = false;
+
+    bool targetRefreshed = false;   // UpdateTargeting is due, target/targetCanSee filled
+    EnemyHandle target;             // invalid = go for the player
+    bool targetCanSee = false;
+
+    std::vector<uint32_t> neighbors; // enemies.Hot() indices within THINK_NEIGHBOR_RADIUS (XZ)
+};
+
 struct AnimDesc {
     int row;
     int frames;
@@ -78,7 +95,8 @@ public:
     float rotationY = 0.0f; // in degrees
     float stateTimer = 0.0f;
     float stepTimer = 0.0f;
-    int id = -1;
+    int id = -1;                 // set by EnemyStore::Add
+    EnemyHandle handle;          // set by EnemyStore::Add
     float baseScale = 0.5f;
     float raptorSpeed = 700.0f;
     float raptorSoundCooldown = 0.0f;
@@ -91,6 +109,7 @@ public:
     bool animationLoop;
     bool canSee;
     float spriteHeight;
+    float groundHeight = 0.0f; // terrain under the feet, sampled once per Update on islands
     int lastAttackid = -1;
     float deathTimer = 0.0f;
     float attackCooldown = 0.0f;
@@ -145,21 +164,15 @@ public:
     float navRepathTimer = 0.0f;
     static constexpr float NAV_REPATH_INTERVAL = 1.5f; // seconds, tweak
 
-    //dactyl
-    float verticalVel   = 0.0f;   // Y velocity
-    float desiredAlt    = 0.0f;   // target altitude above ground
-    bool  inAir         = false;  // optional latch: are we airborne?
-    float patrolAlt     = 1200.0f;
-
-    //Bat bob
-    float bobPhase = 0.0f;        // radians
-    float bobSpeed = 3.5f;        // radians per second
-    float bobAmplitude = 18.0f;   // world units
-    float hoverHeight = 225.0f;   // base offset above ground
+    // Dactyl and bat specific state is in EnemyStore side tables: enemies.Dactyl(handle) /
+    // enemies.Bat(handle), only for enemies of that type.
+    bool IsBloatBat() const;
 
-    //bloat
-    bool bloatBat = false;
-    bool hasExploded = false;
+    // AI level of detail, set by AIScheduler::Schedule
+    AIScheduler::Tier aiTier = AIScheduler::Tier::Full;
+    float aiPendingDt = 0.0f;   // time since UpdateAI last ran
+    AIThink think;
+    static constexpr float THINK_NEIGHBOR_RADIUS = 500.0f; // largest repulsion radius in use
 
     float chaseSoundTimer = 0.0f;
     bool wasChasing = false;
@@ -169,7 +182,8 @@ public:
     bool iceWizard = false;
 
     //pirates vs zombies
-    Character* target = nullptr;
+    EnemyHandle targetHandle;        // kept between frames
+    Character* target = nullptr;     // targetHandle resolved by UpdateTargeting, only valid this frame
     float targetDist = 99999999.0f;
     bool  targetCanSee = false;
     float targetRefreshTimer = 0.0f; // like pathCooldownTimer
@@ -187,16 +201,17 @@ public:
 
     Character(Vector3 pos, Texture2D& tex, int fw, int fh, int frames, float speed, float scl, int row = 0, CharacterType t = CharacterType::Raptor);
     BoundingBox GetBoundingBox() const;
-    Vector3 ComputeRepulsionForce(const std::vector<Character*>& allRaptors, float repulsionRadius = 500.0f, float repulsionStrength = 6000.0f);
+    Vector3 ComputeRepulsionForce(float repulsionRadius = 500.0f, float repulsionStrength = 6000.0f);
     Vector3 GetFeetPos() const;
     void SetFeetPos(const Vector3& feet);
     void ApplyGroundSnap();
-    void Update(float deltaTime, Player& player);
+    void Update(float deltaTime, Player& player, float aiDeltaTime = -1.0f); // aiDeltaTime: <0 think with deltaTime, 0 skip UpdateAI
     void UpdateTrexAI(float deltaTime, Player& player);
     void UpdateRaptorAI(float deltaTime, Player& player);
     void UpdateDactylAI(float deltaTime, Player& player);
     void UpdateAltitude(float dt, float groundY, float desiredAltitude);
     void UpdateAI(float deltaTime, Player& player); 
+    void Think(const Player& player, float aiDeltaTime); // worker thread safe, only writes `think`
     void UpdateSkeletonAI(float deltaTime, Player& player);
     void UpdateZombieAI(float deltaTime, Player& player);
     void UpdateBatAI(float deltaTime, Player& player);
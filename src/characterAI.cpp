@@ -77,9 +77,37 @@ static Character* FindClosestOfType(
     return best;
 }
 
+// Read only, so Think can run it on a worker. nullptr means "use the player".
+static Character* PickTarget(const Character& self, const Player& player, const std::vector<Character*>& enemyPtrs, bool& canSeeTarget)
+{
+    Character* target = nullptr;
+    canSeeTarget = false;
+
+    if (self.type == CharacterType::Pirate || self.type == CharacterType::Captain)
+    {
+        // Pirates pick closest zombie within some radius
+        target = FindClosestOfType(self.position, enemyPtrs, CharacterType::Zombie, &self, 6000.0f);
+    }
+
+    if (self.type == CharacterType::Zombie)
+    {
+        target = FindClosestOfType(self.position, enemyPtrs, CharacterType::Pirate, &self, 6000.0f);
+    }
+
+    // If you want pirates to still prefer player when close, do:
+    // (optional) <-needed
+    float playerSqr = Vector3DistanceSqr(self.position, player.position);
+    if (playerSqr < 3500.0f * 3500.0f && HasWorldLineOfSight(self.position, player.position, 0.1f)) target = nullptr; // meaning "use player"
+
+    // Use your existing LOS checker; whichever one you use for pirates now
+    if (target) canSeeTarget = HasWorldLineOfSight(self.position, target->position, 0.1);//WorldLineOfSight(position, target->position); // placeholder
+    return target;
+}
+
 void Character::UpdateTargeting(float dt, Player& player, const std::vector<Character*>& enemyPtrs)
 {
 
+    target = enemies.Get(targetHandle); //nullptr if it was removed since last frame
     if (!IsValidTarget(target)) target = nullptr;
     targetRefreshTimer = std::max(0.0f, targetRefreshTimer - dt);
     if (targetRefreshTimer > 0.0f) return;
@@ -87,30 +115,24 @@ void Character::UpdateTargeting(float dt, Player& player, const std::vector<Char
 
     targetRefreshTimer = 0.25f; // refresh 4x/sec; cheap but responsive
 
-    // Default: no target
-    target = nullptr;
-
-    if (type == CharacterType::Pirate || type == CharacterType::Captain)
+    bool canSeeTarget = false;
+    if (think.valid && think.targetRefreshed)
     {
-        // Pirates pick closest zombie within some radius
-        target = FindClosestOfType(position, enemyPtrs, CharacterType::Zombie, this, 6000.0f);
+        // already picked on a worker this frame
+        target = enemies.Get(think.target);
+        if (!IsValidTarget(target)) target = nullptr;
+        canSeeTarget = think.targetCanSee;
     }
-
-    if (type == CharacterType::Zombie)
+    else
     {
-        target = FindClosestOfType(position, enemyPtrs, CharacterType::Pirate, this, 6000.0f);
+        target = PickTarget(*this, player, enemyPtrs, canSeeTarget);
     }
-
-    // If you want pirates to still prefer player when close, do:
-    // (optional) <-needed
-    float playerSqr = Vector3DistanceSqr(position, player.position);
-    if (playerSqr < 3500.0f * 3500.0f && HasWorldLineOfSight(position, player.position, 0.1f)) target = nullptr; // meaning "use player"
+    targetHandle = target ? target->handle : EnemyHandle{};
     
     if (target)
     {
         targetDist = Vector3DistanceSqr(position, target->position);
-        // Use your existing LOS checker; whichever one you use for pirates now
-        targetCanSee = HasWorldLineOfSight(position, target->position, 0.1);//WorldLineOfSight(position, target->position); // placeholder
+        targetCanSee = canSeeTarget;
     }
     else
     {
@@ -119,6 +141,39 @@ void Character::UpdateTargeting(float dt, Player& player, const std::vector<Char
     }
 }
 
+void Character::Think(const Player& player, float aiDeltaTime)
+{
+    // Parallel half of the AI: the queries that only read the world (line of sight, target
+    // search, neighbours). Everything that changes shared state stays in UpdateAI.
+    think.valid = true;
+
+    // Types that use UpdatePlayerVisibility. Raptors/trex/dactyls only check range.
+    think.hasPlayerLOS = type != CharacterType::Raptor && type != CharacterType::Trex && type != CharacterType::Pterodactyl;
+    think.canSeePlayer = think.hasPlayerLOS && !player.godMode && HasWorldLineOfSight(position, player.position, 0.0f);
+
+    bool hunts = type == CharacterType::Pirate || type == CharacterType::Captain || type == CharacterType::Zombie;
+    think.targetRefreshed = hunts && targetRefreshTimer - aiDeltaTime <= 0.0f;
+    think.target = {};
+    think.targetCanSee = false;
+    if (think.targetRefreshed)
+    {
+        Character* t = PickTarget(*this, player, enemies.Ptrs(), think.targetCanSee);
+        if (t) think.target = t->handle;
+    }
+
+    const EnemyHotData& hot = enemies.Hot();
+    const std::vector<Character*>& others = enemies.Ptrs();
+    const float radiusSq = THINK_NEIGHBOR_RADIUS * THINK_NEIGHBOR_RADIUS;
+
+    think.neighbors.clear();
+    for (size_t i = 0; i < hot.size(); i++) {
+        if (others[i] == this || !hot.alive[i]) continue;
+        float dx = position.x - hot.position[i].x;
+        float dz = position.z - hot.position[i].z;
+        if (dx * dx + dz * dz <= radiusSq) think.neighbors.push_back((uint32_t)i);
+    }
+}
+
 
 void Character::UpdateChaseSound(float deltaTime, Player& player){
     if (state != CharacterState::Chase) return;
@@ -131,19 +186,19 @@ void Character::UpdateChaseSound(float deltaTime, Player& player){
         switch (type)
         {
             case CharacterType::Skeleton:
-                sn = (GetRandomValue(0,1) > 0) ? "skeletonGrunt" : "skeletonGrunt2";
+                sn = (RandomInt(0,1) > 0) ? "skeletonGrunt" : "skeletonGrunt2";
                 break;
 
             case CharacterType::Pirate:
-                sn = (GetRandomValue(0,1) > 0) ? "pirateYell1" : "pirateYell2";
+                sn = (RandomInt(0,1) > 0) ? "pirateYell1" : "pirateYell2";
                 break;
 
             case CharacterType::Zombie:
-                sn = (GetRandomValue(0,1) > 0) ? "zombieMoan1" : "zombieMoan2";
+                sn = (RandomInt(0,1) > 0) ? "zombieMoan1" : "zombieMoan2";
                 break;
 
             case CharacterType::Spider:
-                sn = (GetRandomValue(0,1) > 0) ? "spiderChase" : "spiderChase2";
+                sn = (RandomInt(0,1) > 0) ? "spiderChase" : "spiderChase2";
                 break;
 
             default:
@@ -165,7 +220,8 @@ void Character::UpdatePlayerVisibility(const Vector3& playerPos, float deltaTime
     }
 
 
-    canSee = HasWorldLineOfSight(position, playerPos, epsilon);
+    bool precomputed = think.valid && think.hasPlayerLOS && epsilon == 0.0f; //Think already cast this ray
+    canSee = precomputed ? think.canSeePlayer : HasWorldLineOfSight(position, playerPos, epsilon);
     if (canSee) {
         lastKnownPlayerPos = playerPos;
         hasLastKnownPlayerPos = true;
@@ -184,7 +240,7 @@ void Character::AddSwordDecal(){
     Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
     Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
-    decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("blockSheet"), 4, 0.4f, 0.1f, 50.0f);
+    decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("blockSheet"), 4, 0.4f, 0.1f, 50.0f);
     SoundManager::GetInstance().Play(rand() % 2 ? "swordBlock" : "swordBlock2");
 }
 
@@ -350,7 +406,7 @@ void Character::UpdateGiantSpiderAI(float deltaTime, Player& player) {
                     Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
                     SoundManager::GetInstance().Play(rand() % 2 ? "giantSpiderBite" : "giantSpiderBite");
-                    decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
+                    decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
 
                 }
                 
@@ -559,7 +615,7 @@ void Character::UpdateBatAI(float deltaTime, Player& player){
             float attackDistance = 200.0f * 200.0f;
             pathCooldownTimer = std::max(0.0f, pathCooldownTimer - deltaTime);
 
-            if (bloatBat){
+            if (IsBloatBat()){
                 if (distanceSq < attackDistance && canSee){
                     TakeDamage(999); //trigger death/explosion
                     return; //bat is exploding make sure we don't change state later on.
@@ -584,7 +640,7 @@ void Character::UpdateBatAI(float deltaTime, Player& player){
                     SetPath(start); 
                 
                 }
-                Vector3 repel = ComputeRepulsionForce(enemyPtrs, 300, 500); // your existing call
+                Vector3 repel = ComputeRepulsionForce(300, 500); // your existing call
                 // Move along current path
                 MoveAlongPath(currentWorldPath, position, rotationY, skeleSpeed, deltaTime, 100, repel);
             }
@@ -643,7 +699,7 @@ void Character::UpdateBatAI(float deltaTime, Player& player){
                     Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
                     //SoundManager::GetInstance().Play(rand() % 2 ? "spiderBite2" : "spiderBite1");
-                    decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
+                    decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
 
                 }
                 
@@ -911,7 +967,6 @@ void Character::UpdateZombieAI(float deltaTime, Player& player) {
             }
 
             Vector3 repel = ComputeRepulsionForce(
-                enemyPtrs,
                 300.0f,
                 200.0f
             );
@@ -991,7 +1046,7 @@ void Character::UpdateZombieAI(float deltaTime, Player& player) {
                     // Optional: spawn blood decal at pirate like you do for player
                     Vector3 camDir = Vector3Normalize(Vector3Subtract(position, victimPos));
                     Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
-                    decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
+                    decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
                 }
                 else
                 {
@@ -1001,7 +1056,7 @@ void Character::UpdateZombieAI(float deltaTime, Player& player) {
                         Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
                         Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
-                        decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("blockSheet"), 4, 0.4f, 0.1f, 50.0f);
+                        decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("blockSheet"), 4, 0.4f, 0.1f, 50.0f);
                         SoundManager::GetInstance().Play(rand() % 2 ? "swordBlock" : "swordBlock2");
                     }
                     else
@@ -1010,7 +1065,7 @@ void Character::UpdateZombieAI(float deltaTime, Player& player) {
 
                         Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
                         Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
-                        decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
+                        decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
                     }
                 }
             }
@@ -1163,7 +1218,7 @@ void Character::UpdateZombieAI(float deltaTime, Player& player) {
             }
 
 
-            if (deathTimer >= 4.5f && canRes && !lostLimb && GetRandomValue(0,1) > 0){ //zombies can get back up. half the time
+            if (deathTimer >= 4.5f && canRes && !lostLimb && RandomInt(0,1) > 0){ //zombies can get back up. half the time
                 canRes = false; //zombies can only ressurect once.
                 deathTimer = 0.0;
                 isDead = false;
@@ -1245,7 +1300,7 @@ void Character::UpdateSkeletonAI(float deltaTime, Player& player) {
                     SetPath(start); 
                 
                 }
-                Vector3 repel = ComputeRepulsionForce(enemyPtrs, 300, 500); // your existing call
+                Vector3 repel = ComputeRepulsionForce(300, 500); // your existing call
                 float speed = 100.0f;
                 // Move along current path
                 MoveAlongPath(currentWorldPath, position, rotationY, skeleSpeed, deltaTime, speed, repel);
@@ -1298,18 +1353,18 @@ void Character::UpdateSkeletonAI(float deltaTime, Player& player) {
                     Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
                     if (type == CharacterType::Spider){
                         SoundManager::GetInstance().Play(rand() % 2 ? "spiderBite2" : "spiderBite1");
-                        decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
+                        decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
                     }else if (type == CharacterType::Skeleton){
                         SoundManager::GetInstance().Play("slice");
                         Decal decal = {offsetPos, DecalType::MeleeSwipe, R.GetTexture("slashSheet"), 5, 0.5f, 0.1f, 80.0f};
 
                         Vector3 vel = Vector3Scale(camDir, 0.0f); //no velocity looks better, keep this technology for later
                         decal.velocity = vel;
-                        decals.emplace_back(decal);
-                        //decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("slashSheet"), 5, 0.5f, 0.1f, 80.0f);
+                        decals.Spawn(decal);
+                        //decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("slashSheet"), 5, 0.5f, 0.1f, 80.0f);
                     }else if (type == CharacterType::Ghost){
                         Vector3 mid = Vector3Lerp(position, player.position, 0.5f); //in between ghost and player
-                        decals.emplace_back(mid, DecalType::MagicAttack, R.GetTexture("magicAttackSheet"), 8, 1.0f, 0.1f, 60.0f);
+                        decals.Spawn(mid, DecalType::MagicAttack, R.GetTexture("magicAttackSheet"), 8, 1.0f, 0.1f, 60.0f);
                         // siphon heal
                         int healOnHit = 20; 
                         currentHealth = std::min(maxHealth, currentHealth + healOnHit);
@@ -1500,14 +1555,14 @@ void Character::UpdateTrexAI(float deltaTime, Player& player){
 
                 hasPatrolTarget  = true;
                 ChangeState(CharacterState::Patrol);
-                SoundManager::GetInstance().PlaySoundAtPosition((GetRandomValue(0, 1) == 0 ? "TrexRoar" : "TrexRoar2"), position, player.position, 0.0, 6000);
+                SoundManager::GetInstance().PlaySoundAtPosition((RandomInt(0, 1) == 0 ? "TrexRoar" : "TrexRoar2"), position, player.position, 0.0, 6000);
                 break;
             }
 
             if (distanceSq < STALK_ENTER && playerVisible) {
                 if (canSee){
                     ChangeState(CharacterState::Chase);
-                    SoundManager::GetInstance().PlaySoundAtPosition((GetRandomValue(0, 1) == 0 ? "TrexRoar" : "TrexRoar2"), position, player.position, 0.0, 6000);
+                    SoundManager::GetInstance().PlaySoundAtPosition((RandomInt(0, 1) == 0 ? "TrexRoar" : "TrexRoar2"), position, player.position, 0.0, 6000);
                 } 
                 
                 
@@ -1548,9 +1603,9 @@ void Character::UpdateTrexAI(float deltaTime, Player& player){
                 //add bite decal
                 Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
                 Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
-                decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 100.0f);
+                decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 100.0f);
 
-                SoundManager::GetInstance().Play(GetRandomValue(0, 1) == 0 ? "TrexBite" : "TrexBite2");
+                SoundManager::GetInstance().Play(RandomInt(0, 1) == 0 ? "TrexBite" : "TrexBite2");
                 break;
             }
             
@@ -1596,7 +1651,7 @@ void Character::UpdateTrexAI(float deltaTime, Player& player){
         case CharacterState::Death:
         {
             if (!isDead) {
-                SoundManager::GetInstance().Play(GetRandomValue(0, 1) == 0 ? "TrexHurt" : "TrexHurt2");
+                SoundManager::GetInstance().Play(RandomInt(0, 1) == 0 ? "TrexHurt" : "TrexHurt2");
                 isDead = true;
                 deathTimer = 0.0f;// Start counting
             }
@@ -1641,14 +1696,14 @@ void Character::UpdateDactylAI(float deltaTime, Player& player)
                     position,
                     /*minR*/ 3000.0f,
                     /*maxR*/ 8200.0f,
-                    heightmap.width,   // pixels
+                    gHeightField.Width(),   // pixels
                     terrainScale.x,     // world units per pixel
                     /*edgeMargin*/ 400.0f
                 );
                 //pick a random altitude before patrolling
                 float altitudes[3] = {800.0f, 1200.0f, 1600.0f};
-                int idx = GetRandomValue(0, 2);
-                patrolAlt = altitudes[idx];
+                int idx = RandomInt(0, 2);
+                if (DactylData* dactyl = enemies.Dactyl(handle)) dactyl->patrolAlt = altitudes[idx];
 
                 hasPatrolTarget = true;
                 ChangeState(CharacterState::Patrol);
@@ -1713,7 +1768,7 @@ void Character::UpdateDactylAI(float deltaTime, Player& player)
                     Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
                     Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
-                    decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
+                    decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
                     
                     player.TakeDamage(10);
                 }
@@ -1810,7 +1865,7 @@ void Character::UpdateDactylAI(float deltaTime, Player& player)
                 canBleed = true;
                 ChangeState(CharacterState::Chase);
                 
-                chaseDuration = GetRandomValue(4, 8); 
+                chaseDuration = RandomInt(4, 8); 
             }
         } break;
 
@@ -1922,7 +1977,7 @@ void Character::UpdateRaptorAI(float deltaTime, Player& player)
                     Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
                     Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
-                    decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
+                    decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("biteSheet"), 4, 0.4f, 0.1f, 50.0f);
                     
                     player.TakeDamage(10);
                 }
@@ -2021,7 +2076,7 @@ void Character::UpdateRaptorAI(float deltaTime, Player& player)
                 canBleed = true;
                 ChangeState(CharacterState::Chase);
                 
-                chaseDuration = GetRandomValue(4, 8); 
+                chaseDuration = RandomInt(4, 8); 
             }
         } break;
 
@@ -2131,7 +2186,7 @@ void Character::UpdateWizardAI(float deltaTime, Player& player) {
 
             // 4) Advance along path (with repulsion)
             if (!currentWorldPath.empty() && state != CharacterState::Stagger) {
-                Vector3 repel = ComputeRepulsionForce(enemyPtrs, 300, 500); // your existing call
+                Vector3 repel = ComputeRepulsionForce(300, 500); // your existing call
                 MoveAlongPath(currentWorldPath, position, rotationY, skeleSpeed, deltaTime, 100.0f, repel);
 
                 // Reached the end but still no LOS? stop chasing
@@ -2228,7 +2283,7 @@ void Character::UpdateWizardAI(float deltaTime, Player& player) {
                         Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
                         Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
-                        decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("slashSheetLeft"), 5, 0.5f, 0.1f, 50.0f);
+                        decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("slashSheetLeft"), 5, 0.5f, 0.1f, 50.0f);
                     }
                 }
             }
@@ -2287,7 +2342,7 @@ void Character::UpdateWizardAI(float deltaTime, Player& player) {
             UpdateMovementAnim();
             // Advance along path (with repulsion)
             if (!currentWorldPath.empty() && state != CharacterState::Stagger) {
-                Vector3 repel = ComputeRepulsionForce(enemyPtrs, 300, 500); // your existing call
+                Vector3 repel = ComputeRepulsionForce(300, 500); // your existing call
                 MoveAlongPath(currentWorldPath, position, rotationY, skeleSpeed, deltaTime, 100.0f, repel);
 
                 // Reached the end but still no LOS? stop chasing
@@ -2555,7 +2610,7 @@ void Character::UpdatePirateAI(float deltaTime, Player& player) {
                 state != CharacterState::Stagger)
             {
                 Vector3 repel =
-                    ComputeRepulsionForce(enemyPtrs, 300, 500);
+                    ComputeRepulsionForce(300, 500);
 
                 MoveAlongPath(
                     currentWorldPath,
@@ -2727,7 +2782,7 @@ void Character::UpdatePirateAI(float deltaTime, Player& player) {
                             Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
                             Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
-                            decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("blockSheet"), 4, 0.4f, 0.1f, 50.0f);
+                            decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("blockSheet"), 4, 0.4f, 0.1f, 50.0f);
                             SoundManager::GetInstance().Play(rand()%2 ? "swordBlock" : "swordBlock2");
                         }
                         else
@@ -2738,7 +2793,7 @@ void Character::UpdatePirateAI(float deltaTime, Player& player) {
                             Vector3 camDir = Vector3Normalize(Vector3Subtract(position, player.position));
                             Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
-                            decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("slashSheetLeft"), 5, 0.5f, 0.1f, 50.0f);
+                            decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("slashSheetLeft"), 5, 0.5f, 0.1f, 50.0f);
                         }
                     }
                     else
@@ -2752,7 +2807,7 @@ void Character::UpdatePirateAI(float deltaTime, Player& player) {
                         Vector3 camDir = Vector3Normalize(Vector3Subtract(position, victimPos));
                         Vector3 offsetPos = Vector3Add(position, Vector3Scale(camDir, -100.0f));
 
-                        decals.emplace_back(offsetPos, DecalType::Explosion, R.GetTexture("slashSheetLeft"), 5, 0.5f, 0.1f, 50.0f);
+                        decals.Spawn(offsetPos, DecalType::Explosion, R.GetTexture("slashSheetLeft"), 5, 0.5f, 0.1f, 50.0f);
                     }
                 }
             }
@@ -2826,7 +2881,7 @@ void Character::UpdatePirateAI(float deltaTime, Player& player) {
             UpdateMovementAnim();
             // Advance along path (with repulsion)
             if (!currentWorldPath.empty() && state != CharacterState::Stagger) {
-                Vector3 repel = ComputeRepulsionForce(enemyPtrs, 300, 500); // your existing call
+                Vector3 repel = ComputeRepulsionForce(300, 500); // your existing call
                 MoveAlongPath(currentWorldPath, position, rotationY, skeleSpeed, deltaTime, 100.0f, repel);
 
                 // Reached the end but still no LOS? stop chasing
@@ -3108,8 +3163,11 @@ bool Character::ChooseFleeTarget()
     return false;
 }
 
-Vector3 Character::ComputeRepulsionForce(const std::vector<Character*>& allRaptors, float repulsionRadius, float repulsionStrength)
+Vector3 Character::ComputeRepulsionForce(float repulsionRadius, float repulsionStrength)
 {
+    // Reads the start-of-frame positions in enemies.Hot(), so the result doesn't depend
+    // on who updated first and other enemies are never dereferenced.
+    // After Think, only the neighbours it found are checked instead of every enemy.
     //return only XZ repulsion. Y stays 0
     Vector3 repulsion = { 0.0f, 0.0f, 0.0f };
 
@@ -3118,16 +3176,23 @@ Vector3 Character::ComputeRepulsionForce(const std::vector<Character*>& allRapto
     const float minDist  = 1.0f;
     const float minDistSq = minDist * minDist;
 
-    for (Character* other : allRaptors) {
-        if (other == this) continue;
-        if (other->isDead) continue;
+    const EnemyHotData& hot = enemies.Hot();
+    const std::vector<Character*>& others = enemies.Ptrs();
+
+    const bool useNeighbors = think.valid && radius <= THINK_NEIGHBOR_RADIUS;
+    const size_t count = useNeighbors ? think.neighbors.size() : hot.size();
+
+    for (size_t k = 0; k < count; k++) {
+        size_t i = useNeighbors ? think.neighbors[k] : k;
+        if (others[i] == this) continue;
+        if (!hot.alive[i]) continue;
         //if (type == CharacterType::Zombie && other->type == CharacterType::Pirate) continue; // zombies aren't repulsed by pirates.
 
         // Horizontal separation only (XZ plane)
         Vector3 delta = {
-            position.x - other->position.x,
+            position.x - hot.position[i].x,
             0.0f,
-            position.z - other->position.z
+            position.z - hot.position[i].z
         };
 
         float distSq = delta.x * delta.x + delta.z * delta.z;
@@ -3325,7 +3390,7 @@ void Character::UpdateChaseSteering(float dt)
         desiredAlt = Lerp(DIVE_ALT, PATROL_ALT, t);
     }
 
-    float groundY = GetHeightAtWorldPosition(position, heightmap, terrainScale);
+    float groundY = GetHeightAtWorldPosition(position);
 
     UpdateAltitude(dt, groundY, desiredAlt);
     float distance = Vector3Distance(position, player.position);
@@ -3458,7 +3523,7 @@ void Character::UpdateChase(float deltaTime)
     // Safety: still obey water edge logic (nav grid *should* avoid water, but no harm)
     bool blocked = StopAtWaterEdge(position, vel, 65);
 
-    Vector3 repel = ComputeRepulsionForce(enemyPtrs, 300, 800.0f);
+    Vector3 repel = ComputeRepulsionForce(300, 800.0f);
 
     if (!blocked)
     {
@@ -3484,7 +3549,7 @@ static inline Vector3 PickFleeTargetXZ(
     const Vector3& playerPos,
     float minR,
     float maxR,
-    const Image& heightmap,
+    const HeightField& field,
     float terrainScale,
     float edgeMargin = 0.0f
 ){
@@ -3495,18 +3560,18 @@ static inline Vector3 PickFleeTargetXZ(
     float len = sqrtf(away.x*away.x + away.z*away.z);
     if (len < 1e-4f) {
         // degenerate: pick random direction
-        float a = GetRandomValue(0, 360) * DEG2RAD;
+        float a = RandomInt(0, 360) * DEG2RAD;
         away = { cosf(a), 0.0f, sinf(a) };
     } else {
         away.x /= len; away.z /= len;
     }
 
     // Radius (uniform by area)
-    float t = (float)GetRandomValue(0, 10000) / 10000.0f;
+    float t = (float)RandomInt(0, 10000) / 10000.0f;
     float r = sqrtf(minR*minR + (maxR*maxR - minR*minR) * t);
 
     // Add some angular noise so they don't all flee in a straight line
-    float jitter = ((float)GetRandomValue(-1000, 1000) / 1000.0f) * 0.75f; // radians-ish
+    float jitter = ((float)RandomInt(-1000, 1000) / 1000.0f) * 0.75f; // radians-ish
     float s = sinf(jitter), c = cosf(jitter);
 
     // rotate away vector by jitter
@@ -3518,8 +3583,8 @@ static inline Vector3 PickFleeTargetXZ(
     p.y = enemyPos.y;
 
     // Clamp to world bounds
-    float worldW = (heightmap.width  - 1) * terrainScale;
-    float worldD = (heightmap.height - 1) * terrainScale;
+    float worldW = (field.Width()  - 1) * terrainScale;
+    float worldD = (field.Height() - 1) * terrainScale;
 
     p.x = Clamp(p.x, edgeMargin, worldW - edgeMargin);
     p.z = Clamp(p.z, edgeMargin, worldD - edgeMargin);
@@ -3552,7 +3617,7 @@ void Character::UpdateRunawaySteering(float dt)
             position, player.position,
             /*minR*/ 2000.0f,
             /*maxR*/ 4500.0f,
-            heightmap, terrainScale.x,
+            gHeightField, terrainScale.x,
             /*edgeMargin*/ 400.0f
         );
         hasFleeTarget = true;
@@ -3594,7 +3659,7 @@ void Character::UpdateRunawaySteering(float dt)
     float distFromPlayer = DistXZ(position, player.position);
 
     //--- altitude ---
-    float groundY = GetHeightAtWorldPosition(position, heightmap, terrainScale);
+    float groundY = GetHeightAtWorldPosition(position);
     UpdateAltitude(dt, groundY, FLEE_ALT);
     float altT = Clamp((position.y - groundY) / FLEE_ALT, 0.0f, 1.0f);
     float horizScale = (altT < 0.5f) ? 0.5f : 1.0f;
@@ -3716,7 +3781,7 @@ void Character::UpdateRunaway(float deltaTime)
     }
 
     // Separation: avoid stacking with other raptors
-    Vector3 vSep = ComputeRepulsionForce(enemyPtrs, /*radius*/500.0f, /*strength*/600.0f);
+    Vector3 vSep = ComputeRepulsionForce(/*radius*/500.0f, /*strength*/600.0f);
     vSep = Limit(vSep, SEP_CAP);
 
     desired = Vector3Add(desired, vSep);
@@ -3769,7 +3834,7 @@ void Character::UpdatePatrolSteering(float dt)
     {
         // Use your new ring picker (no nav path)
         patrolTarget = RandomPointOnHeightmapRingXZ(position, 3000.0f, 8200.0f,
-                                           heightmap.width, terrainScale.x, 400.0f);
+                                           gHeightField.Width(), terrainScale.x, 400.0f);
         hasPatrolTarget = true;
 
         float maxDist = 10000;
@@ -3786,10 +3851,11 @@ void Character::UpdatePatrolSteering(float dt)
     const float VISION_ENTER = 4000.0f;
 
     // --- desired velocity (seek or arrive) ---
-    float groundY = GetHeightAtWorldPosition(position, heightmap, terrainScale);
+    float groundY = GetHeightAtWorldPosition(position);
 
 
-    UpdateAltitude(dt, groundY, patrolAlt);
+    const DactylData* dactyl = enemies.Dactyl(handle);
+    UpdateAltitude(dt, groundY, dactyl ? dactyl->patrolAlt : DactylData{}.patrolAlt);
 
     float currentAlt = position.y - groundY;
 
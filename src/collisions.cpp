@@ -12,6 +12,7 @@
 #include "lighting.h"
 #include "utilities.h"
 #include "switch_tile.h"
+#include "replay.h"
 
 
 bool CheckCircleInEntranceDoorColliderXZ(Vector3 p, float radius, const EntranceDoorCollider& c)
@@ -499,7 +500,7 @@ void HandleMeleeHitboxCollision(Camera& camera) {
 
             if (barrel.containsGold) {
                 Vector3 pos = {barrel.position.x, barrel.position.y + 100, barrel.position.z};
-                int gvalue = GetRandomValue(1, 100);
+                int gvalue = RandomInt(1, 100);
                 Collectable gold = Collectable(CollectableType::Gold, pos, R.GetTexture("coinTexture"), 40);
                 gold.value = gvalue;
                 collectables.push_back(gold);
@@ -600,9 +601,9 @@ void BulletRicochetPuff(Bullet& b, Vector3 dir, Color c)
     // Random jitter (same vibe you already like)
     float r = 50;
     Vector3 jitter = {
-        (float)GetRandomValue(-r, r),
-        (float)GetRandomValue(-r, r),
-        (float)GetRandomValue(-r, r)
+        (float)RandomInt(-r, r),
+        (float)RandomInt(-r, r),
+        (float)RandomInt(-r, r)
     };
 
     Vector3 puffVel = Vector3Add(base, jitter);
@@ -631,9 +632,9 @@ void BulletParticleRicochetNormal(Bullet& b, Vector3 n, Color c)
     // Random jitter
     float r = 50.0f;
     Vector3 jitter = {
-        (float)GetRandomValue(-r, r),
-        (float)GetRandomValue(-r, r),
-        (float)GetRandomValue(-r, r)
+        (float)RandomInt(-r, r),
+        (float)RandomInt(-r, r),
+        (float)RandomInt(-r, r)
     };
 
     Vector3 smokeVel = Vector3Add(base, jitter);
@@ -657,9 +658,9 @@ void BulletParticleBounce(Bullet& b, Color c){
     // Add randomness
     float r = 50.0f; // magnitude of random jitter
     Vector3 jitter = {
-        (float)GetRandomValue(-r, r),
-        (float)GetRandomValue(-r, r),
-        (float)GetRandomValue(-r, r)
+        (float)RandomInt(-r, r),
+        (float)RandomInt(-r, r),
+        (float)RandomInt(-r, r)
     };
 
     // Final smoke velocity
@@ -692,7 +693,7 @@ bool TryBulletRicochet(Bullet& b, Vector3 n, float damp, float minSpeed, float h
     } 
 
     // Apply probability: e.g. only 50% of eligible hits actually bounce.
-    if (GetRandomValue(1, 100) > 50) {
+    if (RandomInt(1, 100) > 50) {
         return false; // 50% just die
     }
 
@@ -713,8 +714,20 @@ bool TryBulletRicochet(Bullet& b, Vector3 n, float damp, float minSpeed, float h
     return true;
 }
 
+// Sphere vs the enemy's AABB straight from the hot arrays, no Character touched.
+static bool HotBoxHitsSphere(const EnemyHotData& hot, size_t i, Vector3 c, float r) {
+    Vector3 p = hot.position[i];
+    Vector3 h = hot.halfExtents[i];
+    float dx = fmaxf(fabsf(c.x - p.x) - h.x, 0.0f);
+    float dy = fmaxf(fabsf(c.y - p.y) - h.y, 0.0f);
+    float dz = fmaxf(fabsf(c.z - p.z) - h.z, 0.0f);
+    return dx * dx + dy * dy + dz * dz <= r * r;
+}
+
 void CheckBulletHits(Camera& camera) {
     float qDamage = player.quadDamage ? 4.0f : 1.0f;
+    const EnemyHotData& hot = enemies.Hot();
+
     for (Bullet& b : activeBullets) {
         if (!b.IsAlive()) continue;
 
@@ -756,7 +769,11 @@ void CheckBulletHits(Camera& camera) {
         }
 
         // 🔹 2. Hit enemy
-        for (Character* enemy : enemyPtrs) {
+        for (size_t ei = 0; ei < hot.size(); ei++) {
+            if (!hot.alive[ei]) continue;
+            if (!HotBoxHitsSphere(hot, ei, b.GetPosition(), b.GetRadius())) continue;
+
+            Character* enemy = enemyPtrs[ei];
             if (enemy == nullptr) continue;
             if (enemy->isDead) continue;
 
@@ -810,7 +827,7 @@ void CheckBulletHits(Camera& camera) {
 
                         // Stick this harpoon to the enemy
                         b.stuck = true;
-                        b.stuckEnemyId = enemy->id;   
+                        b.stuckEnemy = enemy->handle;
                         b.stuckOffset = Vector3Subtract(b.position, enemy->position);
 
                         // Stop the bullet moving
@@ -924,7 +941,6 @@ void CheckBulletHits(Camera& camera) {
                         player.grappleTarget = gp.position;
                         player.grappleSpeed = 3500.0f;          // or gp.pullSpeed
                         player.grappleStopDist = 70.0f;        // or gp.stopDistance
-                        player.grappleBulletId = b.id;          // optional, for rope rendering/cleanup
                         player.harpoonLifeTimer = 3.0f; //start life timer to prevent grappling to an area you can't reach and getting stuck in grapple state
                         SoundManager::GetInstance().Play("ratchet");
                         
@@ -954,7 +970,7 @@ void CheckBulletHits(Camera& camera) {
                     // Optional: stick the harpoon bullet to the collectable for rope visuals
                     b.lifeTime = 0.0f;
                     b.stuck = false;
-                    b.stuckEnemyId = -1; // means "not enemy"
+                    b.stuckEnemy = {}; // means "not enemy"
                     b.stuckOffset = Vector3Subtract(b.position, c.position);
                     b.velocity = {0,0,0};
                     b.maxLifetime = 9999.0f;
@@ -1136,7 +1152,7 @@ bool HandleBarrelHitsForBullet(Bullet& b, Camera& camera)
             else if (barrel.containsGold)
             {
                 Collectable gold(CollectableType::Gold, dropPos, R.GetTexture("coinTexture"), 40);
-                gold.value = GetRandomValue(1, 100);
+                gold.value = RandomInt(1, 100);
                 gold.baseY = barrel.position.y + 100.0f;
                 collectables.push_back(gold);
             }
@@ -1295,8 +1311,8 @@ void HandleDoorInteraction(Camera& camera)
 {
     (void)camera;
     const bool interactPressed =
-        IsKeyPressed(KEY_E) ||
-        (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT));
+        Replay::IsKeyPressed(KEY_E) ||
+        (Replay::IsGamepadAvailable(0) && Replay::IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT));
 
     if (!interactPressed) return;
     if (player.isCarrying) return;
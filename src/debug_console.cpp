@@ -10,6 +10,7 @@
 #include <iomanip>
 #include "vegetation_instanced.h"
 #include "dungeon_props.h"
+#include "replay.h"
 #include <iostream>
 
 namespace DebugConsole
@@ -42,11 +43,11 @@ namespace DebugConsole
 
     static void ClearTextInputQueue()
     {
-        int key = GetCharPressed();
+        int key = Replay::GetCharPressed();
 
         while (key > 0)
         {
-            key = GetCharPressed();
+            key = Replay::GetCharPressed();
         }
     }
 
@@ -104,7 +105,7 @@ namespace DebugConsole
 
     static void FlushCharPressedQueue()
     {
-        while (GetCharPressed() > 0)
+        while (Replay::GetCharPressed() > 0)
         {
             // eat all pending typed characters
         }
@@ -425,7 +426,7 @@ namespace DebugConsole
     void Update(float dt)
     {
         // Toggle with ~ / `
-        if (IsKeyPressed(KEY_GRAVE))
+        if (Replay::IsKeyPressed(KEY_GRAVE))
         {
             Toggle();
 
@@ -445,7 +446,7 @@ namespace DebugConsole
         }
 
         // Escape closes console
-        if (IsKeyPressed(KEY_ESCAPE))
+        if (Replay::IsKeyPressed(KEY_ESCAPE))
         {
             Close();
             return;
@@ -460,7 +461,7 @@ namespace DebugConsole
         }
 
         // Text input
-        int key = GetCharPressed();
+        int key = Replay::GetCharPressed();
 
         while (key > 0)
         {
@@ -470,17 +471,17 @@ namespace DebugConsole
                 gInput.push_back(static_cast<char>(key));
             }
 
-            key = GetCharPressed();
+            key = Replay::GetCharPressed();
         }
 
         // Backspace
-        if (IsKeyPressed(KEY_BACKSPACE) && !gInput.empty())
+        if (Replay::IsKeyPressed(KEY_BACKSPACE) && !gInput.empty())
         {
             gInput.pop_back();
         }
 
         // Enter executes command
-        if (IsKeyPressed(KEY_ENTER))
+        if (Replay::IsKeyPressed(KEY_ENTER))
         {
             if (!gInput.empty())
             {
@@ -88,7 +88,7 @@ void DrawDebugOverlay(const DebugOverlayInfo& info) {
     const float titleFontSize = 20.0f * scale;
 
     const int columns = 2;
-    const int rowsPerColumn = 11;
+    const int rowsPerColumn = 13;
 
     const int panelW = static_cast<int>(575 * scale); // was 720
     const int panelX = screenW - panelW - static_cast<int>(20 * scale) + static_cast<int>(1 * scale);
@@ -195,6 +195,8 @@ void DrawDebugOverlay(const DebugOverlayInfo& info) {
     std::snprintf(buffer, sizeof(buffer), "%.1f", info.fovY);
     DrawRow("FOV Y", buffer);
 
+    DrawRow("Res Scale", TextFormat("%.0f%%", info.renderScale * 100.0f));
+
     std::snprintf(
         buffer,
         sizeof(buffer),
@@ -226,10 +228,15 @@ void DrawDebugOverlay(const DebugOverlayInfo& info) {
     DrawRow("SKY", buffer);
 
     DrawRow("Dungeon", TextFormat("%d x %d", info.dungeonWidth, info.dungeonHeight));
+    if (info.visibleRooms >= 0) DrawRow("Rooms", TextFormat("%d / %d", info.visibleRooms, info.totalRooms));
+    else DrawRow("Rooms", "off");
     DrawRow("Static L", TextFormat("%d", info.staticLights));
     DrawRow("Dynamic L", TextFormat("%d", info.dynamicLights));
     DrawRow("Lightmap", TextFormat("%d x %d", info.lightmapWidth, info.lightmapHeight));
     DrawRow("Enemies", TextFormat("%d", info.activeEnemies));
+    DrawRow("Enemy AI", TextFormat("%.2f ms", info.enemyUpdateMs));
+    DrawRow("AI Tiers", TextFormat("%d / %d / %d", info.aiFull, info.aiReduced, info.aiDormant));
+    DrawRow("AI Thinks", TextFormat("%d (%d late, %d budget)", info.aiThinks, info.aiDeferred, info.aiBudget));
     DrawRow("Bullets", TextFormat("%d", info.activeBullets));
 
     DrawRow("Particles", TextFormat("%d", info.activeParticles));
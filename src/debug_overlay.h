@@ -14,6 +14,19 @@ struct DebugOverlayInfo {
     int levelIndex = 0;
     const char* levelName = "None";
     int activeEnemies;
+    float enemyUpdateMs = 0.0f;
+
+    // AI level of detail
+    int aiFull = 0;
+    int aiReduced = 0;
+    int aiDormant = 0;
+    int aiThinks = 0;
+    int aiDeferred = 0;
+    int aiBudget = 0;
+
+    // Room/portal culling, visibleRooms is -1 when off
+    int totalRooms = 0;
+    int visibleRooms = -1;
     int activeBullets;
     int maxParticles;
     int activeParticles;
@@ -31,6 +44,7 @@ struct DebugOverlayInfo {
     // Camera / settings
     float drawDistance = 0.0f;
     float fovY = 0.0f;
+    float renderScale = 1.0f; // dynamic resolution, per axis
 
     // Rendering stats
     int visibleInstances = 0;
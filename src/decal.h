@@ -1,10 +1,9 @@
 
 #pragma once
 #include "raylib.h"
-#include <vector>
-#include <iostream>
+#include <array>
+#include <utility>
 #include "raymath.h"
-#include "emitter.h"
 
 
 // What kind of decal this is
@@ -22,10 +21,12 @@ enum class DecalType {
     Bone,
 };
 
+// Plain record, no owned memory, so the pool can copy it around for free.
+// Blood from flying gibs goes into the shared decalBlood emitter (world.h), not the decal.
 struct Decal {
-    Vector3 position;
-    DecalType type;
-    Texture2D texture;
+    Vector3 position = {0.0f, 0.0f, 0.0f};
+    DecalType type = DecalType::Smoke;
+    Texture2D texture = {};
     int maxFrames = 1;
     float lifetime = 1.0f;
     float frameTime = 0.1f;
@@ -33,13 +34,13 @@ struct Decal {
     float timer = 0.0f;
     int currentFrame = 0;
     bool alive = true;
-    Vector3 velocity;
+    Vector3 velocity = {0.0f, 0.0f, 0.0f};
     float drag = 1.0f;
     float gravity = 900.0f;
-    bool canBounce;
-    bool hasBounced;
-    Emitter bloodEmitter;
+    bool canBounce = false;
+    bool hasBounced = false;
 
+    Decal() = default;
     Decal(Vector3 pos, DecalType t, Texture2D tex, int frameCount, float life, float frameDuration, float scale = 1.0f)
         : position(pos), type(t), texture(tex), maxFrames(frameCount),
           lifetime(life), frameTime(frameDuration), size(scale)
@@ -63,7 +64,6 @@ struct Decal {
         }
 
         if (type == DecalType::ZombieHead || type == DecalType::ZombieArm || type == DecalType::ZombieGib || type == DecalType::Bone) {
-            bloodEmitter.UpdateBlood(deltaTime);
             //gravity
             velocity.y -= gravity * deltaTime;
             //move
@@ -103,4 +103,52 @@ struct Decal {
     //decals are drawn in transparentDraw after GatherDecals
 
 
+};
+
+// Fixed-capacity decal storage. Live decals are packed at the front, dead ones are
+// swap-removed, so spawning and expiring never allocates or shifts the array.
+// When full, the decal closest to expiring is recycled for the new one.
+class DecalPool {
+public:
+    static constexpr int CAPACITY = 1024;
+
+    template<typename... Args>
+    Decal& Spawn(Args&&... args) {
+        int slot = (count < CAPACITY) ? count++ : MostExpired();
+        items[slot] = Decal(std::forward<Args>(args)...);
+        return items[slot];
+    }
+
+    void Update(float deltaTime) {
+        for (int i = 0; i < count; ) {
+            items[i].Update(deltaTime);
+            if (!items[i].alive) {
+                items[i] = items[--count]; // swap-remove, re-check the moved one
+                continue;
+            }
+            i++;
+        }
+    }
+
+    void clear() { count = 0; }
+    int size() const { return count; }
+
+    Decal* begin() { return items.data(); }
+    Decal* end() { return items.data() + count; }
+    const Decal* begin() const { return items.data(); }
+    const Decal* end() const { return items.data() + count; }
+
+private:
+    int MostExpired() const {
+        int best = 0;
+        float bestT = -1.0f;
+        for (int i = 0; i < count; i++) {
+            float t = items[i].timer / items[i].lifetime;
+            if (t > bestT) { bestT = t; best = i; }
+        }
+        return best;
+    }
+
+    std::array<Decal, CAPACITY> items;
+    int count = 0;
 };
\ No newline at end of file
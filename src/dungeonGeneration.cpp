@@ -8,13 +8,16 @@
 #include "sound_manager.h"
 #include "transparentDraw.h"
 #include "pathfinding.h"
+#include "tile_fov.h"
 #include "resourceManager.h"
 #include "utilities.h"
 #include "dungeonColors.h"
 #include "lighting.h"
 #include <cstdint>
 #include "spiderEgg.h"
-#include "viewCone.h"
+#include "frustum.h"
+#include "dungeon_visibility.h"
+#include "static_bvh.h"
 #include <algorithm>
 #include "ui.h"
 #include "box.h"
@@ -25,6 +28,7 @@
 #include "dungeon_props.h"
 #include "dungeonInstancing.h"
 #include "load_timer.h"
+#include "replay.h"
 
 
 Texture2D ceilingVoidMaskTex;
@@ -85,6 +89,7 @@ void DebugOpenAllDoors(){
         walkableBat[door.tileX][door.tileY] = false;
 
     }
+    TileFOV::Invalidate();
 }
 
 void ScheduleDoorAction(int doorIndex, bool open, bool relockOnClose)
@@ -296,7 +301,7 @@ void UpdateDungeonChests() {
 
     for (ChestInstance& chest : chestInstances) {
         float distToPlayer = Vector3Distance(player.position, chest.position);
-        if (distToPlayer < 300 && IsKeyPressed(KEY_E) && !chest.open){
+        if (distToPlayer < 300 && Replay::IsKeyPressed(KEY_E) && !chest.open){
             chest.animPlaying = true;
             chest.animFrame = 0.0f;
 
@@ -305,7 +310,7 @@ void UpdateDungeonChests() {
         }
 
         if (chest.animPlaying) {
-            chest.animFrame += GetFrameTime() * 50.0f;
+            chest.animFrame += Replay::GetFrameTime() * 50.0f;
 
             if (chest.animFrame > OPEN_END_FRAME) {
                 chest.animFrame = OPEN_END_FRAME;
@@ -1645,7 +1650,7 @@ void GenerateBarrels(float baseY) {
                     pos.z + halfSize
                 };
                 //Decide what the barrel will drop. 
-                int roll = GetRandomValue(0, 99);
+                int roll = RandomInt(0, 99);
                 bool willContainPotion = false;
                 bool willContainMana = false;
                 bool willContainGold = false;
@@ -1866,7 +1871,7 @@ void GenerateBatsFromImage(float baseY) {
                 );
 
 
-                bat.isElite = (GetRandomValue(0, 99) < GameSettings::BossPercentage); // 2% chance
+                bat.isElite = (RandomInt(0, 99) < GameSettings::BossPercentage); // 2% chance
 
                 if (bat.isElite) {
                     bat.maxHealth = 300;
@@ -1879,14 +1884,11 @@ void GenerateBatsFromImage(float baseY) {
 
                 }
 
-                bat.id = gEnemyCounter++;
-                bat.bobPhase = Rand01() * 2.0f * PI; //random starting offset
+                BatData& batData = *enemies.Bat(enemies.Add(bat).handle);
+                batData.bobPhase = Rand01() * 2.0f * PI; //random starting offset
                 if (EqualsRGB(current, ColorOf(Code::bloatBat))){
-                    bat.bloatBat = true; //exploding bats (110, 0, 110)
+                    batData.bloatBat = true; //exploding bats (110, 0, 110)
                 }
-
-                enemies.push_back(bat);
-                enemyPtrs.push_back(&enemies.back()); 
             }
         }
     }
@@ -1913,7 +1915,7 @@ void GenerateSpiderFromImage(float baseY) {
                     CharacterType::Spider
                 );
       
-                spider.isElite = (GetRandomValue(0, 99) < GameSettings::BossPercentage); // 2% chance
+                spider.isElite = (RandomInt(0, 99) < GameSettings::BossPercentage); // 2% chance
 
                 if (spider.isElite){
                     spider.maxHealth = 300;
@@ -1925,9 +1927,7 @@ void GenerateSpiderFromImage(float baseY) {
 
                 }
 
-                spider.id = gEnemyCounter++;
-                enemies.push_back(spider);
-                enemyPtrs.push_back(&enemies.back()); 
+                enemies.Add(spider);
             }
         }
     }
@@ -1949,8 +1949,7 @@ void SpawnSpiderFromEgg(Vector3 spawnPos){
     spider.maxHealth = 100;
     spider.currentHealth = 100; //2 sword attacks
     
-    enemies.push_back(spider);
-    enemyPtrs.push_back(&enemies.back()); 
+    enemies.Add(spider);
 
 }
 
@@ -2012,8 +2011,7 @@ void GenerateGhostsFromImage(float baseY) {
                 ghost.maxHealth = 200;
                 ghost.currentHealth = 200; 
 
-                enemies.push_back(ghost);
-                enemyPtrs.push_back(&enemies.back()); 
+                enemies.Add(ghost);
 
             }
         }
@@ -2043,9 +2041,7 @@ void GenerateGiantSpiderFromImage(float baseY) {
                 );
                 giantSpider.maxHealth = 2000; //3k was to much, try 2k
                 giantSpider.currentHealth = giantSpider.maxHealth; 
-                giantSpider.id = gEnemyCounter++;
-                enemies.push_back(giantSpider);
-                enemyPtrs.push_back(&enemies.back()); 
+                enemies.Add(giantSpider);
             }
         }
     }
@@ -2178,7 +2174,7 @@ void GenerateZombiesFromImage(float baseY) {
                     CharacterType::Zombie
                 );
 
-                zombie.isElite = (GetRandomValue(0, 99) < GameSettings::BossPercentage); // 3% chance
+                zombie.isElite = (RandomInt(0, 99) < GameSettings::BossPercentage); // 3% chance
 
                 if (zombie.isElite){
                     zombie.maxHealth = 500;
@@ -2189,9 +2185,8 @@ void GenerateZombiesFromImage(float baseY) {
                     zombie.currentHealth = 200; //at least 2 shots. 4 sword swings 
                 }
 
-                zombie.id = gEnemyCounter++;
                 
-                enemies.push_back(zombie);
+                enemies.Add(zombie);
             
             }
         }
@@ -2221,7 +2216,7 @@ void GenerateSkeletonsFromImage(float baseY) {
                     CharacterType::Skeleton
                 );
                 skeleton.baseScale = 0.8;
-                skeleton.isElite = (GetRandomValue(0, 99) < GameSettings::BossPercentage); // 2% chance
+                skeleton.isElite = (RandomInt(0, 99) < GameSettings::BossPercentage); // 2% chance
 
                 if (skeleton.isElite){
                     skeleton.maxHealth = 500;
@@ -2232,9 +2227,8 @@ void GenerateSkeletonsFromImage(float baseY) {
                     skeleton.currentHealth = 200; //at least 2 shots. 4 sword swings 
                 }
 
-                skeleton.id = gEnemyCounter++;
                 
-                enemies.push_back(skeleton);
+                enemies.Add(skeleton);
                 //enemyPtrs.push_back(&enemies.back()); 
             }
         }
@@ -2264,7 +2258,7 @@ void GeneratePiratesFromImage(float baseY) {
                     CharacterType::Pirate
                 );
        
-                pirate.isElite = (GetRandomValue(0, 99) < GameSettings::BossPercentage); // 2% chance
+                pirate.isElite = (RandomInt(0, 99) < GameSettings::BossPercentage); // 2% chance
 
                 if (pirate.isElite){
                     
@@ -2277,9 +2271,7 @@ void GeneratePiratesFromImage(float baseY) {
                 }
 
 
-                pirate.id = gEnemyCounter++;
-                enemies.push_back(pirate);
-                enemyPtrs.push_back(&enemies.back()); 
+                enemies.Add(pirate);
 
             }
 
@@ -2299,9 +2291,7 @@ void GeneratePiratesFromImage(float baseY) {
                 captain.maxHealth = 1000.0f;
                 captain.currentHealth = 1000.0f;
 
-                captain.id = gEnemyCounter++;
-                enemies.push_back(captain);
-                enemyPtrs.push_back(&enemies.back()); // is this neseccary when we update the Ptrs every frame?
+                enemies.Add(captain);
 
 
             }
@@ -2330,7 +2320,7 @@ void GenerateWizardsFromImage(float baseY) {
                     CharacterType::Wizard
                 );
 
-                wizard.isElite = (GetRandomValue(0, 99) < GameSettings::BossPercentage); // 2% chance
+                wizard.isElite = (RandomInt(0, 99) < GameSettings::BossPercentage); // 2% chance
 
                 if (iceWizard) wizard.iceWizard = true;
 
@@ -2344,9 +2334,7 @@ void GenerateWizardsFromImage(float baseY) {
                 }
 
 
-                wizard.id = gEnemyCounter++;
-                enemies.push_back(wizard);
-                enemyPtrs.push_back(&enemies.back()); 
+                enemies.Add(wizard);
 
             }
         }
@@ -2543,7 +2531,7 @@ void GenerateLightSources(float baseY) {
                 }
                 Fire newFire;
                 newFire.tint = fireTint;
-                newFire.fireFrame = GetRandomValue(0, 59);
+                newFire.fireFrame = RandomInt(0, 59);
                 fires.push_back(newFire);
             }
 
@@ -2761,7 +2749,7 @@ void UpdateLauncherTraps(float dt)
 }
 
 
-void DrawFlatWeb(Texture2D texture, Vector3 position, float width, float height, float rotationY, Color tint)
+void DrawFlatWeb(Texture2D texture, Rectangle source, Vector3 position, float width, float height, float rotationY, Color tint)
 {
     // Compute 4 corners of the quad in local space
     Vector3 p1 = {-width/2, -height/2, 0};
@@ -2783,20 +2771,24 @@ void DrawFlatWeb(Texture2D texture, Vector3 position, float width, float height,
     p3 = Vector3Add(p3, position);
     p4 = Vector3Add(p4, position);
 
-    // Draw the textured quad
+    // source in pixels, so atlas regions work as well as whole textures
+    float u0 = source.x / texture.width;
+    float u1 = (source.x + source.width) / texture.width;
+    float v0 = source.y / texture.height;
+    float v1 = (source.y + source.height) / texture.height;
+
+    // Draw the textured quad. No rlSetTexture(0) after, so webs sharing a texture stay in one draw.
     rlSetTexture(texture.id);
 
     rlBegin(RL_QUADS);
         rlColor4ub(tint.r, tint.g, tint.b, tint.a);
 
-        rlTexCoord2f(0, 1); rlVertex3f(p1.x, p1.y, p1.z);
-        rlTexCoord2f(1, 1); rlVertex3f(p2.x, p2.y, p2.z);
-        rlTexCoord2f(1, 0); rlVertex3f(p3.x, p3.y, p3.z);
-        rlTexCoord2f(0, 0); rlVertex3f(p4.x, p4.y, p4.z);
+        rlTexCoord2f(u0, v1); rlVertex3f(p1.x, p1.y, p1.z);
+        rlTexCoord2f(u1, v1); rlVertex3f(p2.x, p2.y, p2.z);
+        rlTexCoord2f(u1, v0); rlVertex3f(p3.x, p3.y, p3.z);
+        rlTexCoord2f(u0, v0); rlVertex3f(p4.x, p4.y, p4.z);
 
     rlEnd();
-
-    rlSetTexture(0);
 }
 
 
@@ -2937,15 +2929,56 @@ void DrawSwitches(){
 }
 
 
+// Model, position and scale a doorway is drawn with. Shared by the draw and its culling bounds.
+static void GetDoorwayDrawParams(const DoorwayInstance& d, ModelId windowWayId, ModelId woodDoorWayId, ModelId doorWayGrayId,
+                                 ModelId& outModel, Vector3& outPos, Vector3& outScale)
+{
+    if (d.window){
+        outModel = windowWayId;
+        outPos = d.position;
+        outScale = {500, 620, 500};
+    }else{
+        outModel = d.wood ? woodDoorWayId : doorWayGrayId;
+        outPos = {d.position.x, d.position.y + 100, d.position.z};
+        outScale = {490, 595, 476};
+    }
+}
+
+static Matrix MakeModelExTransform(Vector3 pos, float rotationYDeg, Vector3 scale)
+{
+    // same scale -> rotate -> translate DrawModelEx builds
+    Matrix m = MatrixMultiply(MatrixScale(scale.x, scale.y, scale.z), MatrixRotateY(rotationYDeg * DEG2RAD));
+    return MatrixMultiply(m, MatrixTranslate(pos.x, pos.y, pos.z));
+}
+
 void DrawDungeonGeometry(Camera& camera, float maxDrawDist){
     const Vector3 baseScale   = {700, 700, 700};
 
-    ViewConeParams vp = MakeViewConeParams(
-        camera,
-        55.0f,  //narrower cone for dungeons because we can get away with it.     
-        maxDrawDist,
-        400.0f    
-    );
+    //models are all loaded at boot, resolve the handles once
+    static const ModelId windowWayId   = R.FindModelId("windowWay");
+    static const ModelId woodDoorWayId = R.FindModelId("woodDoorWay");
+    static const ModelId doorWayGrayId = R.FindModelId("doorWayGray");
+    static const ModelId lavaTileId    = R.FindModelId("lavaTile");
+    static const ModelId ceilingId     = R.FindModelId("ceilingPlane");
+    static const ModelId shipMastId    = R.FindModelId("shipMast");
+
+    Frustum frustum = MakeCameraFrustum(camera, maxDrawDist);
+
+    // Doorways are static once the level is built; rebuild the tree when the level or count changes.
+    static StaticBVH doorwayBvh;
+    static int doorwayBvhLevel = -1;
+    static std::vector<int> visibleDoorways;
+    if (doorwayBvhLevel != gCurrentLevelIndex || doorwayBvh.ItemCount() != (int)doorways.size()){
+        std::vector<BoundingBox> boxes;
+        boxes.reserve(doorways.size());
+        for (const DoorwayInstance& d : doorways){
+            ModelId id; Vector3 pos, scale;
+            GetDoorwayDrawParams(d, windowWayId, woodDoorWayId, doorWayGrayId, id, pos, scale);
+            boxes.push_back(TransformAABB(GetModelBoundingBox(R.GetModel(id)), MakeModelExTransform(pos, d.rotationY * RAD2DEG, scale)));
+        }
+        doorwayBvh.Build(boxes);
+        doorwayBvhLevel = gCurrentLevelIndex;
+    }
 
 
         //instanced floors
@@ -2953,34 +2986,27 @@ void DrawDungeonGeometry(Camera& camera, float maxDrawDist){
     DrawDungeonInstancedFloors();
     DrawDungeonInstancedWalls();
 
-    //Doorways
-    for (const DoorwayInstance& d : doorways) { 
-        //if (!IsInViewCone(vp, d.position)) continue;  //dont cull doorways because of dungeon entrances outside are doorways
-        
-
-        if (d.window){
-            Vector3 dPos = {d.position.x, d.position.y, d.position.z};
-            DrawModelEx(R.GetModel("windowWay"), dPos, {0, 1, 0}, d.rotationY * RAD2DEG, {500, 620, 500}, d.tint);
-        }else if (d.wood){
-            Vector3 dPos = {d.position.x, d.position.y + 100, d.position.z};
-            DrawModelEx(R.GetModel("woodDoorWay"), dPos, {0, 1, 0}, d.rotationY * RAD2DEG, {490, 595, 476}, d.tint);
-
-        } else{
-            Vector3 dPos = {d.position.x, d.position.y + 100, d.position.z};
-            DrawModelEx(R.GetModel("doorWayGray"), dPos, {0, 1, 0}, d.rotationY * RAD2DEG, {490, 595, 476}, d.tint);
-      
-        }
-
-        
+    //Doorways. Culled by their model bounds, so dungeon entrances seen from outside stay drawn.
+    visibleDoorways.clear();
+    doorwayBvh.Query(frustum, visibleDoorways);
+    for (int i : visibleDoorways) { 
+        const DoorwayInstance& d = doorways[i];
+        if (!DungeonVisibility::IsTileVisible(d.tileX, d.tileY)) continue;
+        ModelId id; Vector3 dPos, dScale;
+        GetDoorwayDrawParams(d, windowWayId, woodDoorWayId, doorWayGrayId, id, dPos, dScale);
+        DrawModelEx(R.GetModel(id), dPos, {0, 1, 0}, d.rotationY * RAD2DEG, dScale, d.tint);
     }
 
 
 
     //Lava floor
     for (const FloorTile& lavaTile : lavaTiles){
-        if (!IsInViewCone(vp, lavaTile.position) && !debugInfo) continue;
+        BoundingBox lavaBox = { Vector3Subtract(lavaTile.position, {tileSize, tileSize, tileSize}),
+                                Vector3Add(lavaTile.position, {tileSize, tileSize, tileSize}) };
+        if (!FrustumContainsAABB(frustum, lavaBox) && !debugInfo) continue;
+        if (!DungeonVisibility::IsWorldPosVisible(lavaTile.position)) continue;
 
-        DrawModelEx(R.GetModel("lavaTile"), lavaTile.position, {0, 1, 0}, 0.0f, baseScale, lavaTile.tint);
+        DrawModelEx(R.GetModel(lavaTileId), lavaTile.position, {0, 1, 0}, 0.0f, baseScale, lavaTile.tint);
 
     }
 
@@ -2988,12 +3014,12 @@ void DrawDungeonGeometry(Camera& camera, float maxDrawDist){
     //rlEnableBackfaceCulling();
     float scale = dungeonWidth * tileSize;
     if (drawCeiling && isDungeon){
-        DrawModelEx(R.GetModel("ceilingPlane"), Vector3 {scale/2, ceilingHeight, scale/2}, {0,1,0}, 0.0f, Vector3{scale, scale, scale}, WHITE); 
+        DrawModelEx(R.GetModel(ceilingId), Vector3 {scale/2, ceilingHeight, scale/2}, {0,1,0}, 0.0f, Vector3{scale, scale, scale}, WHITE); 
     }
     
     //Ship
     for (const ShipMast mast : masts) {
-        DrawModelEx(R.GetModel("shipMast"), mast.position, Vector3{0, 1, 0}, 90.0f, Vector3{100, 100, 100}, LIGHTGRAY);
+        DrawModelEx(R.GetModel(shipMastId), mast.position, Vector3{0, 1, 0}, 90.0f, Vector3{100, 100, 100}, LIGHTGRAY);
     }
 
     //Switches
@@ -3077,12 +3103,7 @@ void DrawFlatDoor(Texture2D tex,
     Vector3 topRight    = Vector3Add(bottomRight,(Vector3){0, h, 0});
 
 
-    BeginBlendMode(BLEND_ALPHA);
-    if (!isDungeon) BeginShaderMode(R.GetShader("treeShader"));
-
-    rlEnableDepthTest();
-    rlDisableDepthMask();
-
+    // Shader, blend and depth mask are set by the billboard batcher, just add the quad.
     rlSetTexture(tex.id);
     rlBegin(RL_QUADS);
         rlColor4ub(tint.r, tint.g, tint.b, tint.a);
@@ -3092,13 +3113,6 @@ void DrawFlatDoor(Texture2D tex,
         rlTexCoord2f(1, 0); rlVertex3f(topRight.x,    topRight.y,    topRight.z);
         rlTexCoord2f(0, 0); rlVertex3f(topLeft.x,     topLeft.y,     topLeft.z);
     rlEnd();
-
-    rlSetTexture(0);
-    rlColor4ub(255, 255, 255, 255);
-    rlEnableDepthMask();
-
-    EndBlendMode();
-    if (!isDungeon) EndShaderMode();
 }
 
 
@@ -401,7 +401,7 @@ void DrawDungeonChests();
 void DrawDungeonPillars();
 void DrawBoxes();
 //void DrawFlatDoor(Texture2D tex, Vector3 pos, float width, float height, float rotY, Color tint);
-void DrawFlatWeb(Texture2D texture, Vector3 position, float width, float height, float rotationY, Color tint);
+void DrawFlatWeb(Texture2D texture, Rectangle source, Vector3 position, float width, float height, float rotationY, Color tint);
 
 void GenerateWeapons(float Height);
 //void DrawDungeonCeiling(Model ceilingTileModel, float ceilingOffsetY);
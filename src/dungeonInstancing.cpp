@@ -1,14 +1,18 @@
 #include "dungeonInstancing.h"
 
 #include "raymath.h"
+#include "rlgl.h"
 #include "resourceManager.h"      // keep lowercase for Linux
 #include "dungeonGeneration.h"    // FloorTile, FloorType, CurrentLevelIs, etc.
 #include "shaderSetup.h"          // if gDynamic lives there, or include wherever it really lives
 #include "world.h"
 #include <iostream>
-#include "viewCone.h"
+#include <algorithm>
+#include "frustum.h"
+#include "static_bvh.h"
 #include "lighting.h"
 #include "game_settings.h"
+#include "dungeon_visibility.h"
 
 
 // ------------------------------------------------------------
@@ -24,20 +28,33 @@ DungeonInstancingBatch gStoneWallInstancing;
 DungeonInstancingBatch gWoodWallInstancing;
 DungeonInstancingBatch gWoodHalfWallInstancing;
 
+// Culling tree and resident GPU buffers over gDungeonInstanceSources,
+// rebuilt on the first draw after sources change.
+static StaticBVH gDungeonInstanceBvh;
+static bool gDungeonInstancesDirty = true;
+static std::vector<int> gVisibleDungeonSources;
+
+// Hidden instances in a gap shorter than this get drawn anyway, one draw call costs more.
+static constexpr int RANGE_MERGE_GAP = 16;
+
+static DungeonInstancingBatch* AllDungeonBatches[] = {
+    &gGrayFloorInstancing,
+    &gWoodFloorInstancing,
+    &gStoneWallInstancing,
+    &gWoodWallInstancing,
+    &gWoodHalfWallInstancing
+};
+
 void UpdateDungeonInstancingDebugCounts()
 {
 
     GameSettings::gTotalDungeonInstanceCount =
         (int)gDungeonInstanceSources.size();
 
-    GameSettings::gVisibleDungeonInstanceCount =
-        (int)(
-            gGrayFloorInstancing.transforms.size() +
-            gWoodFloorInstancing.transforms.size() +
-            gStoneWallInstancing.transforms.size() +
-            gWoodWallInstancing.transforms.size() +
-            gWoodHalfWallInstancing.transforms.size()
-        );
+    int visible = 0;
+    for (DungeonInstancingBatch* batch : AllDungeonBatches) visible += (int)batch->visibleSlots.size();
+
+    GameSettings::gVisibleDungeonInstanceCount = visible;
 }
 
 static void SetDungeonInstancingShaderValues(DungeonInstancingBatch& batch)
@@ -46,17 +63,11 @@ static void SetDungeonInstancingShaderValues(DungeonInstancingBatch& batch)
 
     Shader& sh = batch.material.shader;
 
-    sh.locs[SHADER_LOC_MATRIX_MVP] =
-        GetShaderLocation(sh, "mvp");
-
-    sh.locs[SHADER_LOC_MATRIX_MODEL] =
-        GetShaderLocationAttrib(sh, "instanceTransform");
-
-    sh.locs[SHADER_LOC_MAP_DIFFUSE] =
-        GetShaderLocation(sh, "texture0");
-
-    sh.locs[SHADER_LOC_MAP_EMISSION] =
-        GetShaderLocation(sh, "texture4");
+    // locs is shared with the lighting shader, so put ours back before every draw.
+    sh.locs[SHADER_LOC_MATRIX_MVP]   = batch.loc_mvp;
+    sh.locs[SHADER_LOC_MATRIX_MODEL] = batch.loc_instanceTransform;
+    sh.locs[SHADER_LOC_MAP_DIFFUSE]  = batch.loc_texture0;
+    sh.locs[SHADER_LOC_MAP_EMISSION] = batch.loc_texture4;
 
     // Do NOT overwrite diffuse.
     // Only refresh the runtime lightmap/emission texture.
@@ -67,10 +78,6 @@ static void SetDungeonInstancingShaderValues(DungeonInstancingBatch& batch)
     }
 
 
-    int locGrid   = GetShaderLocation(sh, "gridBounds");
-    int locDynStr = GetShaderLocation(sh, "dynStrength");
-    int locAmb    = GetShaderLocation(sh, "ambientBoost");
-
     float grid[4] = {
         gDynamic.minX,
         gDynamic.minZ,
@@ -81,14 +88,14 @@ static void SetDungeonInstancingShaderValues(DungeonInstancingBatch& batch)
     float dynStrength  = lightConfig.dynStrength;
     float ambientBoost = lightConfig.ambient;
 
-    if (locGrid >= 0)
-        SetShaderValue(sh, locGrid, grid, SHADER_UNIFORM_VEC4);
+    if (batch.loc_grid >= 0)
+        SetShaderValue(sh, batch.loc_grid, grid, SHADER_UNIFORM_VEC4);
 
-    if (locDynStr >= 0)
-        SetShaderValue(sh, locDynStr, &dynStrength, SHADER_UNIFORM_FLOAT);
+    if (batch.loc_dynStr >= 0)
+        SetShaderValue(sh, batch.loc_dynStr, &dynStrength, SHADER_UNIFORM_FLOAT);
 
-    if (locAmb >= 0)
-        SetShaderValue(sh, locAmb, &ambientBoost, SHADER_UNIFORM_FLOAT);
+    if (batch.loc_amb >= 0)
+        SetShaderValue(sh, batch.loc_amb, &ambientBoost, SHADER_UNIFORM_FLOAT);
 }
 
 // ------------------------------------------------------------
@@ -152,13 +159,19 @@ static void InitDungeonInstancingBatch(
     batch.shader = R.GetShader(shaderKey);
     batch.kind = kind;
 
-    batch.shader.locs[SHADER_LOC_MATRIX_MVP] =
-        GetShaderLocation(batch.shader, "mvp");
+    batch.loc_mvp               = GetShaderLocation(batch.shader, "mvp");
+    batch.loc_instanceTransform = GetShaderLocationAttrib(batch.shader, "instanceTransform");
+    batch.loc_texture0          = GetShaderLocation(batch.shader, "texture0");
+    batch.loc_texture4          = GetShaderLocation(batch.shader, "texture4");
+    batch.loc_grid              = GetShaderLocation(batch.shader, "gridBounds");
+    batch.loc_dynStr            = GetShaderLocation(batch.shader, "dynStrength");
+    batch.loc_amb               = GetShaderLocation(batch.shader, "ambientBoost");
+
+    batch.shader.locs[SHADER_LOC_MATRIX_MVP] = batch.loc_mvp;
 
     // raylib DrawMeshInstanced expects this attrib location to be
     // stored in SHADER_LOC_MATRIX_MODEL.
-    batch.shader.locs[SHADER_LOC_MATRIX_MODEL] =
-        GetShaderLocationAttrib(batch.shader, "instanceTransform");
+    batch.shader.locs[SHADER_LOC_MATRIX_MODEL] = batch.loc_instanceTransform;
 
     if (batch.shader.locs[SHADER_LOC_MATRIX_MODEL] < 0)
     {
@@ -204,42 +217,46 @@ static void InitDungeonInstancingBatch(
     // Runtime lightmap/emission.
     batch.material.maps[MATERIAL_MAP_EMISSION].texture = gDynamic.tex;
 
-    batch.transforms.reserve(4096);
-
     batch.initialized = true;
 }
 
-static void PushVisibleTransformToCorrectBatch(const DungeonInstanceSource& src)
+static DungeonInstancingBatch& BatchFor(DungeonInstanceKind kind)
 {
-    switch (src.kind)
+    switch (kind)
     {
-        case DungeonInstanceKind::FloorGray:
-            gGrayFloorInstancing.transforms.push_back(src.transform);
-            break;
+        case DungeonInstanceKind::FloorWood:    return gWoodFloorInstancing;
+        case DungeonInstanceKind::WallStone:    return gStoneWallInstancing;
+        case DungeonInstanceKind::WallWood:     return gWoodWallInstancing;
+        case DungeonInstanceKind::WallWoodHalf: return gWoodHalfWallInstancing;
+        default:                                return gGrayFloorInstancing;
+    }
+}
 
-        case DungeonInstanceKind::FloorWood:
-            gWoodFloorInstancing.transforms.push_back(src.transform);
-            break;
+static void PushVisibleSlotToCorrectBatch(const DungeonInstanceSource& src)
+{
+    if (src.slot < 0) return;
+    BatchFor(src.kind).visibleSlots.push_back(src.slot);
+}
 
+// Sorted visible slots -> runs of the resident buffer, bridging short hidden gaps.
+static void BuildVisibleRanges(DungeonInstancingBatch& batch)
+{
+    batch.ranges.clear();
+    batch.drawnInstances = 0;
+    if (batch.visibleSlots.empty()) return;
 
-        case DungeonInstanceKind::WallStone:
-            gStoneWallInstancing.transforms.push_back(src.transform);
-            break;
+    std::sort(batch.visibleSlots.begin(), batch.visibleSlots.end());
 
-        case DungeonInstanceKind::WallWood:
-            gWoodWallInstancing.transforms.push_back(src.transform);
-            break;
+    for (int slot : batch.visibleSlots) AppendInstanceRange(batch.ranges, slot, 1, RANGE_MERGE_GAP);
 
-        case DungeonInstanceKind::WallWoodHalf:
-            gWoodHalfWallInstancing.transforms.push_back(src.transform);
-            break;
-    }
+    for (const InstanceRange& r : batch.ranges) batch.drawnInstances += r.count;
 }
 
+// Transforms already live in batch.instanceVbo, only the visible ranges change per frame.
 static void DrawDungeonInstancingBatch(DungeonInstancingBatch& batch)
 {
     if (!batch.initialized) return;
-    if (batch.transforms.empty()) return;
+    if (batch.ranges.empty()) return;
 
     // Important if gDynamic gets recreated/reloaded between levels.
     if (batch.kind == DungeonInstanceKind::WallStone && GameSettings::useDDALighting){
@@ -251,7 +268,18 @@ static void DrawDungeonInstancingBatch(DungeonInstancingBatch& batch)
 
     SetDungeonInstancingShaderValues(batch);
 
-    DrawMeshInstanced(batch.mesh, batch.material, batch.transforms.data(), (int)batch.transforms.size());
+    if (batch.instanceVbo == 0)
+    {
+        // no resident buffer (upload failed), send the visible ranges the old way
+        static std::vector<Matrix> scratch;
+        scratch.clear();
+        for (const InstanceRange& r : batch.ranges)
+            scratch.insert(scratch.end(), batch.transforms.begin() + r.first, batch.transforms.begin() + r.first + r.count);
+        DrawMeshInstanced(batch.mesh, batch.material, scratch.data(), (int)scratch.size());
+        return;
+    }
+
+    DrawMeshInstancedRanges(batch.mesh, batch.material, batch.instanceVbo, batch.ranges);
 }
 
 // ------------------------------------------------------------
@@ -261,9 +289,18 @@ static void DrawDungeonInstancingBatch(DungeonInstancingBatch& batch)
 void ClearDungeonInstancingSources()
 {
     gDungeonInstanceSources.clear();
+    gDungeonInstanceBvh.Clear();
+    gDungeonInstancesDirty = true;
 
-    gGrayFloorInstancing.transforms.clear();
-    gWoodFloorInstancing.transforms.clear();
+    for (DungeonInstancingBatch* batch : AllDungeonBatches)
+    {
+        if (batch->instanceVbo != 0) rlUnloadVertexBuffer(batch->instanceVbo);
+        batch->instanceVbo = 0;
+        batch->transforms.clear();
+        batch->visibleSlots.clear();
+        batch->ranges.clear();
+        batch->drawnInstances = 0;
+    }
 }
 
 void InitDungeonInstancing()
@@ -326,6 +363,7 @@ void AddWallInstanceSource(const WallInstance& wall)
     }
 
     gDungeonInstanceSources.push_back(src);
+    gDungeonInstancesDirty = true;
 }
 
 // void AddFloorInstanceSource(const FloorTile& tile)
@@ -357,32 +395,96 @@ void AddFloorInstanceSource(Vector3 position, FloorType floorType)
         : DungeonInstanceKind::FloorGray;
 
     gDungeonInstanceSources.push_back(src);
+    gDungeonInstancesDirty = true;
 }
 
-void BuildVisibleDungeonInstanceTransforms(Camera& camera, float maxDrawDist)
+// World bounds from the batch mesh under each transform. Needs the batches initialized,
+// so it runs lazily on the first draw instead of in AddXInstanceSource.
+static void RebuildDungeonInstanceBvh()
 {
-    gGrayFloorInstancing.transforms.clear();
-    gWoodFloorInstancing.transforms.clear();
-
-    gStoneWallInstancing.transforms.clear();
-    gWoodWallInstancing.transforms.clear();
-    gWoodHalfWallInstancing.transforms.clear();
-
-    ViewConeParams vp = MakeViewConeParams(
-        camera,
-        55.0f,
-        maxDrawDist,
-        400.0f
-    );
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(gDungeonInstanceSources.size());
 
     for (const DungeonInstanceSource& src : gDungeonInstanceSources)
     {
-        if (!IsInViewCone(vp, src.position))
-            continue;
+        const DungeonInstancingBatch& batch = BatchFor(src.kind);
+        if (batch.initialized)
+        {
+            boxes.push_back(TransformAABB(GetMeshBoundingBox(batch.mesh), src.transform));
+        }
+        else
+        {
+            // no mesh to measure, a generous tile sized box
+            Vector3 h = { tileSize, tileSize * 2.0f, tileSize };
+            boxes.push_back({ Vector3Subtract(src.position, h), Vector3Add(src.position, h) });
+        }
+    }
+
+    gDungeonInstanceBvh.Build(boxes);
+}
+
+// Z-order key of the tile under a position.
+static uint32_t TileOrderKey(const Vector3& pos)
+{
+    uint32_t x = (uint32_t)std::max(0, (int)(pos.x / tileSize));
+    uint32_t z = (uint32_t)std::max(0, (int)(pos.z / tileSize));
+    return ZOrderKey(x, z);
+}
+
+// Every transform goes to the GPU once here, per frame only the ranges change.
+static void RebuildDungeonInstanceBuffers()
+{
+    std::vector<int> order(gDungeonInstanceSources.size());
+    for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [](int a, int b) {
+        return TileOrderKey(gDungeonInstanceSources[a].position) < TileOrderKey(gDungeonInstanceSources[b].position);
+    });
+
+    for (DungeonInstancingBatch* batch : AllDungeonBatches)
+    {
+        if (batch->instanceVbo != 0) rlUnloadVertexBuffer(batch->instanceVbo);
+        batch->instanceVbo = 0;
+        batch->transforms.clear();
+    }
+
+    for (int i : order)
+    {
+        DungeonInstanceSource& src = gDungeonInstanceSources[i];
+        DungeonInstancingBatch& batch = BatchFor(src.kind);
+        src.slot = (int)batch.transforms.size();
+        batch.transforms.push_back(src.transform);
+    }
+
+    for (DungeonInstancingBatch* batch : AllDungeonBatches)
+    {
+        if (!batch->initialized || batch->transforms.empty()) continue;
+        batch->instanceVbo = UploadInstanceTransforms(batch->transforms);
+        if (batch->instanceVbo == 0) TraceLog(LOG_WARNING, "Dungeon instancing: failed to upload %d transforms", (int)batch->transforms.size());
+    }
+}
+
+void BuildVisibleDungeonInstanceTransforms(Camera& camera, float maxDrawDist)
+{
+    for (DungeonInstancingBatch* batch : AllDungeonBatches) batch->visibleSlots.clear();
 
-        PushVisibleTransformToCorrectBatch(src);
+    if (gDungeonInstancesDirty)
+    {
+        RebuildDungeonInstanceBvh();
+        RebuildDungeonInstanceBuffers();
+        gDungeonInstancesDirty = false;
     }
 
+    gVisibleDungeonSources.clear();
+    gDungeonInstanceBvh.Query(MakeCameraFrustum(camera, maxDrawDist), gVisibleDungeonSources);
+
+    for (int i : gVisibleDungeonSources)
+    {
+        if (!DungeonVisibility::IsWorldPosVisible(gDungeonInstanceSources[i].position)) continue;
+        PushVisibleSlotToCorrectBatch(gDungeonInstanceSources[i]);
+    }
+
+    for (DungeonInstancingBatch* batch : AllDungeonBatches) BuildVisibleRanges(*batch);
+
     UpdateDungeonInstancingDebugCounts();
 }
 
@@ -4,6 +4,7 @@
 
 #include <vector>
 #include "dungeonGeneration.h"
+#include "instanced_draw.h"
 
 // Later you can add:
 // NormalWallGray,
@@ -26,6 +27,7 @@ struct DungeonInstanceSource
     Matrix transform = {};
 
     DungeonInstanceKind kind = DungeonInstanceKind::FloorGray;
+    int slot = -1; // index into its batch's resident transforms, set when the GPU buffers are built
 };
 
 struct DungeonInstancingBatch
@@ -34,9 +36,27 @@ struct DungeonInstancingBatch
     Shader shader;
     Material material;
 
+    // Every instance of this kind, sorted along a Z-order curve so neighbouring tiles sit next
+    // to each other. Uploaded once per level into instanceVbo and never touched per frame.
     std::vector<Matrix> transforms;
+    unsigned int instanceVbo = 0;
+
+    // Per frame: visible slots into transforms, merged into ranges of the resident buffer.
+    std::vector<int> visibleSlots;
+    std::vector<InstanceRange> ranges;
+    int drawnInstances = 0;
+
     DungeonInstanceKind kind = DungeonInstanceKind::FloorGray;
 
+    // Cached locations, resolved once in InitDungeonInstancingBatch
+    int loc_mvp = -1;
+    int loc_instanceTransform = -1;
+    int loc_texture0 = -1;
+    int loc_texture4 = -1;
+    int loc_grid = -1;
+    int loc_dynStr = -1;
+    int loc_amb = -1;
+
     bool initialized = false;
 };
 
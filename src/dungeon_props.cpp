@@ -4,10 +4,14 @@
 #include "world.h"
 #include "dungeonColors.h"
 #include "weapon.h"
-#include "viewCone.h"
+#include "frustum.h"
+#include "static_bvh.h"
 #include "game_settings.h"
+#include "dungeon_visibility.h"
+#include "sprite_atlas.h"
 #include "debug_console.h"
 #include "pathfinding.h"
+#include "shaderSetup.h"
 #include <cmath>
 #include <iostream>
 
@@ -15,6 +19,12 @@ using namespace dungeonColors;
 
 std::vector<DungeonProp> gDungeonProps;
 
+// Culling tree over the model props, rebuilt on the next draw after the list changes.
+static StaticBVH gPropBvh;
+static std::vector<int> gPropBvhIndices; // BVH item -> gDungeonProps index
+static bool gPropBvhDirty = true;
+static size_t gPropBvhSourceCount = 0;
+
 static BillboardDrawRequest MakePropBillboardRequest(
     const DungeonProp& prop,
     const Vector3& cameraPos,
@@ -35,6 +45,7 @@ static BillboardDrawRequest MakePropBillboardRequest(
         (float)req.texture.width,
         (float)req.texture.height
     };
+    SpriteAtlas::Remap(req.texture, req.sourceRect);
 
     req.size = prop.size;
     req.tint = prop.tint;
@@ -135,6 +146,7 @@ void GatherDungeonPropDrawRequests(
 void ClearDungeonProps()
 {
     gDungeonProps.clear();
+    gPropBvhDirty = true;
 }
 
 DungeonProp MakeDefaultProp(DungeonPropType type, Vector3 position, float rotationY)
@@ -247,8 +259,10 @@ static unsigned int gLastPropSeed = 0;
 void GenerateProps(float baseY) {
     //debug command: Props = regenerate props. 
     gDungeonProps.clear();
+    gPropBvhDirty = true;
     
-    gLastPropSeed = (unsigned int)GetRandomValue(1, 999999999);
+    gLastPropSeed = (unsigned int)RandomInt(1, 999999999);
+    unsigned long long gameplayRandomState = GetRandomState();
 
     //if (CurrentLevelIs("Dungeon1")) gLastPropSeed = 922767668; //good seed for dungeon1
 
@@ -257,7 +271,7 @@ void GenerateProps(float baseY) {
     DebugConsole::Log("Prop Seed: " + seedString);
 
     
-    SetRandomSeed(gLastPropSeed);
+    SeedRandom(gLastPropSeed);
 
     if (CurrentLevelIs("Dungeon1")) GenerateDungeonPropsForCurrentLevel(); //hardcoded props. 
 
@@ -276,9 +290,9 @@ void GenerateProps(float baseY) {
         }
     }
 
-    // Re-randomize the global RNG so gameplay randomness is not locked
-    // to the prop seed forever.
-    SetRandomSeed((unsigned int)GetTime() * 1000000u);
+    // Restore the gameplay RNG so gameplay randomness is not locked
+    // to the prop seed forever, and replays stay deterministic.
+    SetRandomState(gameplayRandomState);
 }
 
 
@@ -398,7 +412,7 @@ static DungeonProp MakeAutoCornerProp(
         case DungeonPropType::TableSet:
             prop.ambientBoost = 0.0f;
 
-            prop.rotationY = GetRandomValue(0,1) ? 0.0f : 90.0f;
+            prop.rotationY = RandomInt(0,1) ? 0.0f : 90.0f;
             break;
 
         case DungeonPropType::WallBanner:
@@ -419,7 +433,7 @@ static DungeonPropType PickAutoCornerPropType()
 {
     // Special case: spider boss / web-heavy level.
 
-    int roll = GetRandomValue(0, 4);
+    int roll = RandomInt(0, 4);
 
     if (roll == 0){
         return DungeonPropType::SpiderWebCorner;
@@ -474,7 +488,7 @@ void GenerateAutoCornerProps(float baseY)
 
         int spawnChancePercent = GetAutoCornerSpawnChance(type); // 
 
-        if (GetRandomValue(1, 100) > spawnChancePercent) return;
+        if (RandomInt(1, 100) > spawnChancePercent) return;
         
 
         if (!IsWalkable(x, y, dungeonImg)) return;
@@ -554,26 +568,42 @@ float GetPropBrightness(DungeonProp& prop){
     }
 }
 
-void  DrawDungeonPropModels(Camera& camera){
-    Shader& sh = R.GetShader("lightingShader");
+static void RebuildPropBvh()
+{
+    std::vector<BoundingBox> boxes;
+    gPropBvhIndices.clear();
 
-    ViewConeParams vp = MakeViewConeParams( 
-        camera,
-        55.0f,
-        GameSettings::maxDrawDist,
-        400.0f
-    );
+    for (int i = 0; i < (int)gDungeonProps.size(); i++){
+        const DungeonProp& prop = gDungeonProps[i];
+        if (prop.renderMode != DungeonPropRenderMode::Model) continue;
 
-    int propAmbientLoc = GetShaderLocation(sh, "propAmbientBoost");
-    int maxBrightnessLoc = GetShaderLocation(sh, "maxBrightness");
+        // same scale -> rotate -> translate DrawModelEx uses
+        Matrix m = MatrixMultiply(MatrixScale(prop.modelSize.x, prop.modelSize.y, prop.modelSize.z), MatrixRotateY(prop.rotationY * DEG2RAD));
+        m = MatrixMultiply(m, MatrixTranslate(prop.position.x, prop.position.y, prop.position.z));
 
+        boxes.push_back(TransformAABB(GetModelBoundingBox(R.GetModel(prop.modelName)), m));
+        gPropBvhIndices.push_back(i);
+    }
 
-    for (DungeonProp& prop : gDungeonProps){
-        if (prop.renderMode != DungeonPropRenderMode::Model) continue;
-  
-        if (!IsInViewCone(vp, prop.position)) continue;//frustum cull
+    gPropBvh.Build(boxes);
+    gPropBvhDirty = false;
+    gPropBvhSourceCount = gDungeonProps.size();
+}
 
-        
+void  DrawDungeonPropModels(Camera& camera){
+    Shader& sh = *ShaderSetup::gPropLighting.shader;
+    const int propAmbientLoc = ShaderSetup::gPropLighting.loc_propAmbientBoost;
+    const int maxBrightnessLoc = ShaderSetup::gPropLighting.loc_maxBrightness;
+
+    if (gPropBvhDirty || gPropBvhSourceCount != gDungeonProps.size()) RebuildPropBvh();
+
+    static std::vector<int> visible;
+    visible.clear();
+    gPropBvh.Query(MakeCameraFrustum(camera, GameSettings::maxDrawDist), visible);
+
+    for (int item : visible){
+        DungeonProp& prop = gDungeonProps[gPropBvhIndices[item]];
+        if (!DungeonVisibility::IsWorldPosVisible(prop.position)) continue;
 
         SetShaderValue(sh, propAmbientLoc, &prop.ambientBoost, SHADER_UNIFORM_FLOAT);
         SetShaderValue(sh, maxBrightnessLoc, &prop.maxBrightness, SHADER_UNIFORM_FLOAT);
@@ -0,0 +1,317 @@
+#include "dungeon_visibility.h"
+
+#include <algorithm>
+#include <vector>
+#include "raymath.h"
+#include "dungeonGeneration.h"
+#include "dungeonColors.h"
+#include "frustum.h"
+#include "load_timer.h"
+#include "world.h"
+
+using namespace dungeonColors;
+
+namespace DungeonVisibility
+{
+    static constexpr int NO_ROOM = -1;
+    static constexpr int PORTAL_TILE = -2;
+    static constexpr int MAX_PORTAL_STEPS = 4096; // per frame safety net, rooms left on the stack past it count as visible
+
+    struct Portal
+    {
+        int roomA = NO_ROOM;
+        int roomB = NO_ROOM;
+        int tileX = 0;
+        int tileY = 0;
+        int doorIndex = -1;   // into doors, -1 = open archway
+        BoundingBox bounds;
+    };
+
+    struct ScreenRect
+    {
+        float x0, y0, x1, y1; // NDC
+
+        bool Empty() const { return x0 >= x1 || y0 >= y1; }
+        ScreenRect Intersect(const ScreenRect& o) const
+        {
+            return { std::max(x0, o.x0), std::max(y0, o.y0), std::min(x1, o.x1), std::min(y1, o.y1) };
+        }
+        ScreenRect Union(const ScreenRect& o) const
+        {
+            return { std::min(x0, o.x0), std::min(y0, o.y0), std::max(x1, o.x1), std::max(y1, o.y1) };
+        }
+        bool Contains(const ScreenRect& o) const
+        {
+            return x0 <= o.x0 && y0 <= o.y0 && x1 >= o.x1 && y1 >= o.y1;
+        }
+    };
+
+    static const ScreenRect EMPTY_RECT = { 1e30f, 1e30f, -1e30f, -1e30f };
+    static const ScreenRect FULL_SCREEN = { -1.0f, -1.0f, 1.0f, 1.0f };
+
+    static std::vector<int> gRoomOfTile;                 // dungeonWidth * dungeonHeight
+    static std::vector<std::vector<int>> gRoomPortals;   // per room, indices into gPortals
+    static std::vector<Portal> gPortals;
+    static int gRoomCount = 0;
+    static int gWidth = 0;
+    static int gHeight = 0;
+
+    static std::vector<uint8_t> gRoomVisible;
+    static std::vector<ScreenRect> gRoomRect;          // per room, union of every rect it was reached through this frame
+    static bool gActive = false;
+    static int gVisibleRooms = 0;
+
+    static bool BlocksView(Color c)
+    {
+        if (c.a == 0) return false;
+        return EqualsRGB(c, ColorOf(Code::Wall)) || EqualsRGB(c, ColorOf(Code::woodWall));
+    }
+
+    static int RoomAt(int x, int y)
+    {
+        if (x < 0 || y < 0 || x >= gWidth || y >= gHeight) return NO_ROOM;
+        return gRoomOfTile[y * gWidth + x];
+    }
+
+    void Clear()
+    {
+        gRoomOfTile.clear();
+        gRoomPortals.clear();
+        gPortals.clear();
+        gRoomVisible.clear();
+        gRoomRect.clear();
+        gRoomCount = 0;
+        gWidth = gHeight = 0;
+        gActive = false;
+        gVisibleRooms = 0;
+    }
+
+    void Build()
+    {
+        Clear();
+        if (!isDungeon || !dungeonPixels || dungeonWidth <= 0 || dungeonHeight <= 0) return;
+        LoadTimer timer("DungeonVisibility::Build");
+
+        gWidth = dungeonWidth;
+        gHeight = dungeonHeight;
+        gRoomOfTile.assign(gWidth * gHeight, NO_ROOM);
+
+        for (const DoorwayInstance& d : doorways)
+        {
+            if (d.tileX >= 0 && d.tileY >= 0 && d.tileX < gWidth && d.tileY < gHeight)
+                gRoomOfTile[d.tileY * gWidth + d.tileX] = PORTAL_TILE;
+        }
+
+        // flood fill rooms
+        std::vector<int> stack;
+        for (int start = 0; start < gWidth * gHeight; start++)
+        {
+            if (gRoomOfTile[start] != NO_ROOM || BlocksView(dungeonPixels[start])) continue;
+
+            int room = gRoomCount++;
+            gRoomOfTile[start] = room;
+            stack.push_back(start);
+
+            while (!stack.empty())
+            {
+                int t = stack.back();
+                stack.pop_back();
+                int x = t % gWidth, y = t / gWidth;
+
+                const int nx[4] = { x - 1, x + 1, x, x };
+                const int ny[4] = { y, y, y - 1, y + 1 };
+                for (int k = 0; k < 4; k++)
+                {
+                    if (nx[k] < 0 || ny[k] < 0 || nx[k] >= gWidth || ny[k] >= gHeight) continue;
+                    int n = ny[k] * gWidth + nx[k];
+                    if (gRoomOfTile[n] != NO_ROOM || BlocksView(dungeonPixels[n])) continue;
+                    gRoomOfTile[n] = room;
+                    stack.push_back(n);
+                }
+            }
+        }
+
+        // portals: the doorway tile links the rooms on its two open sides
+        gRoomPortals.assign(gRoomCount, {});
+        for (const DoorwayInstance& d : doorways)
+        {
+            int rooms[4] = { RoomAt(d.tileX - 1, d.tileY), RoomAt(d.tileX + 1, d.tileY),
+                             RoomAt(d.tileX, d.tileY - 1), RoomAt(d.tileX, d.tileY + 1) };
+
+            Portal p;
+            p.tileX = d.tileX;
+            p.tileY = d.tileY;
+            for (int r : rooms)
+            {
+                if (r < 0) continue;
+                if (p.roomA == NO_ROOM) p.roomA = r;
+                else if (r != p.roomA) p.roomB = r;
+            }
+            if (p.roomA == NO_ROOM || p.roomB == NO_ROOM) continue; // dead end or both sides already one room
+
+            for (int i = 0; i < (int)doors.size(); i++)
+            {
+                if (doors[i].tileX == d.tileX && doors[i].tileY == d.tileY) { p.doorIndex = i; break; }
+            }
+
+            float half = tileSize * 0.5f;
+            p.bounds = { { d.position.x - half, d.position.y - 200.0f, d.position.z - half },
+                         { d.position.x + half, d.position.y + 600.0f, d.position.z + half } };
+
+            int index = (int)gPortals.size();
+            gPortals.push_back(p);
+            gRoomPortals[p.roomA].push_back(index);
+            gRoomPortals[p.roomB].push_back(index);
+        }
+
+        gRoomVisible.assign(gRoomCount, 0);
+        gRoomRect.assign(gRoomCount, EMPTY_RECT);
+        TraceLog(LOG_INFO, "DUNGEON: %d rooms, %d portals", gRoomCount, (int)gPortals.size());
+    }
+
+    static bool PortalOpen(const Portal& p)
+    {
+        if (p.doorIndex < 0 || p.doorIndex >= (int)doors.size()) return true;
+        const Door& door = doors[p.doorIndex];
+        return door.isOpen || door.window;
+    }
+
+    // Screen bounds of a box. Anything crossing the camera plane gets the whole screen.
+    static ScreenRect ProjectBox(const BoundingBox& box, const Matrix& viewProj)
+    {
+        ScreenRect r = { 1e30f, 1e30f, -1e30f, -1e30f };
+        for (int i = 0; i < 8; i++)
+        {
+            Vector3 c = { (i & 1) ? box.max.x : box.min.x,
+                          (i & 2) ? box.max.y : box.min.y,
+                          (i & 4) ? box.max.z : box.min.z };
+
+            float x = viewProj.m0 * c.x + viewProj.m4 * c.y + viewProj.m8 * c.z + viewProj.m12;
+            float y = viewProj.m1 * c.x + viewProj.m5 * c.y + viewProj.m9 * c.z + viewProj.m13;
+            float w = viewProj.m3 * c.x + viewProj.m7 * c.y + viewProj.m11 * c.z + viewProj.m15;
+            if (w <= 0.001f) return { -1.0f, -1.0f, 1.0f, 1.0f };
+
+            r.x0 = std::min(r.x0, x / w);
+            r.y0 = std::min(r.y0, y / w);
+            r.x1 = std::max(r.x1, x / w);
+            r.y1 = std::max(r.y1, y / w);
+        }
+        return r;
+    }
+
+    void Update(const Camera& camera, float maxDrawDist)
+    {
+        gActive = false;
+        gVisibleRooms = 0;
+        if (!isDungeon || gRoomCount == 0) return;
+
+        int cx = GetDungeonImageX(camera.position.x, tileSize, dungeonWidth);
+        int cy = GetDungeonImageY(camera.position.z, tileSize, dungeonHeight);
+        if (cx < 0 || cy < 0 || cx >= gWidth || cy >= gHeight) return;
+
+        // start room(s): the camera's room, or both sides of the doorway it stands in
+        static std::vector<int> startRooms;
+        startRooms.clear();
+        int here = gRoomOfTile[cy * gWidth + cx];
+        if (here >= 0)
+        {
+            startRooms.push_back(here);
+        }
+        else if (here == PORTAL_TILE)
+        {
+            for (const Portal& p : gPortals)
+            {
+                if (p.tileX != cx || p.tileY != cy) continue;
+                startRooms.push_back(p.roomA);
+                startRooms.push_back(p.roomB);
+            }
+        }
+        if (startRooms.empty()) return; // inside a wall
+
+        Matrix viewProj = MakeViewProjection(camera, ScreenAspect(), 1.0f, maxDrawDist);
+        Frustum frustum = MakeFrustum(camera, ScreenAspect(), 1.0f, maxDrawDist);
+
+        std::fill(gRoomVisible.begin(), gRoomVisible.end(), 0);
+        std::fill(gRoomRect.begin(), gRoomRect.end(), EMPTY_RECT);
+
+        // Each room keeps the union of the rects it was reached through, and is only pushed
+        // again when a portal grows that union. Loops and doubled portals between two rooms
+        // stop as soon as they add nothing new.
+        struct Step { int room; ScreenRect rect; };
+        static std::vector<Step> stack;
+        stack.clear();
+        for (int r : startRooms)
+        {
+            gRoomRect[r] = FULL_SCREEN;
+            stack.push_back({ r, FULL_SCREEN });
+        }
+
+        int steps = 0;
+        while (!stack.empty() && steps++ < MAX_PORTAL_STEPS)
+        {
+            Step s = stack.back();
+            stack.pop_back();
+            gRoomVisible[s.room] = 1;
+
+            for (int pi : gRoomPortals[s.room])
+            {
+                const Portal& p = gPortals[pi];
+                if (!PortalOpen(p)) continue;
+                if (!FrustumContainsAABB(frustum, p.bounds)) continue;
+
+                ScreenRect narrowed = s.rect.Intersect(ProjectBox(p.bounds, viewProj));
+                if (narrowed.Empty()) continue;
+
+                int other = (p.roomA == s.room) ? p.roomB : p.roomA;
+                ScreenRect& seen = gRoomRect[other];
+                if (seen.Contains(narrowed)) continue;
+
+                seen = seen.Union(narrowed);
+                stack.push_back({ other, seen });
+            }
+        }
+
+        // hit the cap: stay conservative, whatever was still queued counts as visible
+        for (const Step& s : stack) gRoomVisible[s.room] = 1;
+
+        for (uint8_t v : gRoomVisible) gVisibleRooms += v;
+        gActive = true;
+    }
+
+    bool IsTileVisible(int x, int y)
+    {
+        if (!gActive) return true;
+        if (x < 0 || y < 0 || x >= gWidth || y >= gHeight) return true;
+
+        int room = gRoomOfTile[y * gWidth + x];
+        if (room >= 0) return gRoomVisible[room] != 0;
+
+        // wall or doorway: visible from any room touching it
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                int r = RoomAt(x + dx, y + dy);
+                if (r >= 0 && gRoomVisible[r]) return true;
+            }
+        }
+        return false;
+    }
+
+    bool IsWorldPosVisible(Vector3 pos)
+    {
+        if (!gActive) return true;
+        return IsTileVisible(GetDungeonImageX(pos.x, tileSize, dungeonWidth),
+                             GetDungeonImageY(pos.z, tileSize, dungeonHeight));
+    }
+
+    int RoomCount()
+    {
+        return gRoomCount;
+    }
+
+    int VisibleRoomCount()
+    {
+        return gActive ? gVisibleRooms : -1;
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "raylib.h"
+
+// Room/portal visibility for dungeons.
+//
+// Build() runs once after the doorways are generated. It splits the dungeon PNG into rooms:
+// 4-connected floor tiles, with full walls (black / wood) and doorway tiles as borders.
+// Each doorway tile is a portal between the rooms on either side. A closed door blocks its
+// portal, except for windows.
+//
+// Update() runs once per frame. It starts in the camera's room and walks through the portals.
+// Each step narrows a screen rectangle to the portal's projected bounds, so a room is only
+// reached if some part of it can be seen through every door on the way.
+//
+// IsTileVisible / IsWorldPosVisible answer true when the system is off:
+//   overworld, no graph, or the camera outside every room (free cam in a wall).
+// Wall tiles count as visible when any room next to them is.
+
+namespace DungeonVisibility
+{
+    void Build();
+    void Clear();
+
+    void Update(const Camera& camera, float maxDrawDist);
+
+    bool IsTileVisible(int x, int y);
+    bool IsWorldPosVisible(Vector3 pos);
+
+    int RoomCount();
+    int VisibleRoomCount();   // -1 when culling is off this frame
+}
@@ -0,0 +1,146 @@
+#include "dynamic_resolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include "raylib.h"
+#include "raymath.h"
+#include "game_settings.h"
+
+namespace DynamicResolution
+{
+    static const float STEP            = 0.05f;  // per axis
+    static const float AVERAGE_RATE    = 0.1f;   // moving average weight of the newest frame
+    static const float CHANGE_COOLDOWN = 0.25f;  // seconds between changes, lets the averages catch up
+    static const float OVER_BUDGET     = 1.08f;  // avg frame above budget * this = too slow
+    static const float CPU_BOUND       = 0.9f;   // avg CPU above budget * this = pixels aren't the problem
+    static const float HEADROOM        = 0.9f;   // step up early when the predicted frame stays under budget * this
+    static const float PROBE_HOLD_MIN  = 2.0f;   // seconds in budget before trying a step up blind
+    static const float PROBE_HOLD_MAX  = 16.0f;
+    static const float PROBE_FAIL_TIME = 1.5f;   // going over budget this soon after a blind step up = failed probe
+    static const float MAX_SAMPLE      = 0.25f;  // longer frames are loads / hitches, not render cost
+
+    static float scale = 1.0f;
+
+    static double frameStart = 0.0;
+    static float lastCpu = 0.0f;
+
+    static bool haveAverage = false;
+    static float avgFrame = 0.0f;
+    static float avgCpu = 0.0f;
+
+    static float cooldown = 0.0f;
+    static float stableTime = 0.0f;
+    static float probeHold = PROBE_HOLD_MIN;
+    static float sinceProbe = PROBE_FAIL_TIME;
+
+    static float TargetFrameSeconds()
+    {
+        float fps = GameSettings::dynResTargetFps;
+        if (fps <= 0.0f)
+        {
+            int hz = GetMonitorRefreshRate(GetCurrentMonitor());
+            fps = (hz > 0) ? (float)hz : 60.0f;
+        }
+        return 1.0f / fps;
+    }
+
+    void BeginFrame()
+    {
+        frameStart = GetTime();
+    }
+
+    void EndCpuWork()
+    {
+        lastCpu = (float)(GetTime() - frameStart);
+    }
+
+    void Reset()
+    {
+        scale = 1.0f;
+        haveAverage = false;
+        avgFrame = avgCpu = 0.0f;
+        cooldown = 0.0f;
+        stableTime = 0.0f;
+        probeHold = PROBE_HOLD_MIN;
+        sinceProbe = PROBE_FAIL_TIME;
+    }
+
+    void Update(bool enabled)
+    {
+        if (!enabled)
+        {
+            if (scale != 1.0f || haveAverage) Reset();
+            return;
+        }
+
+        float frame = GetFrameTime();
+        if (frame <= 0.0f || frame > MAX_SAMPLE) return;
+
+        if (!haveAverage)
+        {
+            avgFrame = frame;
+            avgCpu = lastCpu;
+            haveAverage = true;
+        }
+        else
+        {
+            avgFrame += (frame - avgFrame) * AVERAGE_RATE;
+            avgCpu += (lastCpu - avgCpu) * AVERAGE_RATE;
+        }
+
+        sinceProbe += frame;
+        cooldown -= frame;
+        if (cooldown > 0.0f) return;
+
+        const float budget = TargetFrameSeconds();
+        const float minScale = Clamp(GameSettings::dynResMinScale, 0.25f, 1.0f);
+        const float gpu = std::max(avgFrame - avgCpu, 0.0f); // roughly the part that scales with pixels
+
+        if (avgFrame > budget * OVER_BUDGET)
+        {
+            stableTime = 0.0f;
+            if (avgCpu > budget * CPU_BOUND || scale <= minScale) return;
+
+            if (sinceProbe < PROBE_FAIL_TIME) probeHold = std::min(probeHold * 2.0f, PROBE_HOLD_MAX);
+            sinceProbe = PROBE_FAIL_TIME;
+
+            // pixel cost goes with scale^2, aim for the scale the GPU share fits in, at least one step
+            float gpuBudget = std::max(budget * 0.95f - avgCpu, gpu * 0.25f);
+            float fit = scale * sqrtf(gpuBudget / std::max(gpu, 0.0001f));
+            scale = Clamp(std::min(fit, scale - STEP), minScale, 1.0f);
+            cooldown = CHANGE_COOLDOWN;
+            return;
+        }
+
+        if (scale >= 1.0f)
+        {
+            probeHold = PROBE_HOLD_MIN;
+            return;
+        }
+
+        stableTime += frame;
+
+        float next = std::min(scale + STEP, 1.0f);
+        float predicted = avgCpu + gpu * (next * next) / (scale * scale);
+        bool visibleHeadroom = predicted < budget * HEADROOM;
+
+        if (visibleHeadroom || stableTime >= probeHold)
+        {
+            scale = next;
+            stableTime = 0.0f;
+            cooldown = CHANGE_COOLDOWN;
+            if (!visibleHeadroom) sinceProbe = 0.0f;
+        }
+    }
+
+    float Scale()
+    {
+        return scale;
+    }
+
+    void ScaledSize(int fullW, int fullH, int& outW, int& outH)
+    {
+        outW = std::max(1, std::min(fullW, (int)(fullW * scale + 0.5f)));
+        outH = std::max(1, std::min(fullH, (int)(fullH * scale + 0.5f)));
+    }
+}
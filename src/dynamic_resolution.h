@@ -0,0 +1,32 @@
+#pragma once
+
+// Dynamic resolution for the 3D scene.
+//
+// The scene is drawn into the lower-left renderW x renderH corner of sceneTexture (just a
+// viewport, the target is never reallocated) and bloom.fs stretches that corner over the
+// window, with an optional sharpen. Weapons and UI are drawn after that at native resolution.
+//
+// The scale (per axis, GameSettings::dynResMinScale..1) follows moving averages of the frame
+// time and the CPU part of it against the target frame time:
+//  - over budget and not CPU bound: drop to the scale the GPU share should fit in
+//  - CPU bound: leave it, fewer pixels won't help
+//  - in budget: step back up when the headroom is visible (uncapped), or after holding in
+//    budget for a while (vsync hides headroom). A step up that immediately goes over budget
+//    doubles the hold, so a machine sitting on the edge doesn't flicker between two scales.
+
+namespace DynamicResolution
+{
+    // Top of the main loop. CPU time is measured from here...
+    void BeginFrame();
+    // ...to here, after the frame's draw calls are issued and before EndDrawing waits on the swap.
+    void EndCpuWork();
+
+    // Feed the last frame into the controller. Once per rendered frame, before the scene.
+    // Disabled = full resolution (menus, benchmark runs).
+    void Update(bool enabled);
+
+    float Scale();
+    void ScaledSize(int fullW, int fullH, int& outW, int& outH);
+
+    void Reset();
+}
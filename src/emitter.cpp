@@ -85,18 +85,18 @@ void Emitter::EmitBlood(Vector3 pos, int count, Color color) {
                 p.position = position;
 
                 p.color = color;
-                p.gravity = 1800.0f + GetRandomValue(-200, 200);  
+                p.gravity = 1800.0f + RandomInt(-200, 200);  
 
                 // Directionless for now; you can bias this later
                 p.velocity = {
-                    (float)GetRandomValue(-120, 120),
-                    (float)GetRandomValue(80, 500),
-                    (float)GetRandomValue(-120, 120)
+                    (float)RandomInt(-120, 120),
+                    (float)RandomInt(80, 500),
+                    (float)RandomInt(-120, 120)
                 };
 
-                p.maxLife = 0.4f + GetRandomValue(0, 80) / 100.0f; // 0.4–1.2 sec
+                p.maxLife = 0.4f + RandomInt(0, 80) / 100.0f; // 0.4–1.2 sec
                 p.life    = p.maxLife;
-                p.size    = 3.0f + GetRandomValue(0, 25) / 10.0f;  // 3–5.5
+                p.size    = 3.0f + RandomInt(0, 25) / 10.0f;  // 3–5.5
 
                 break;
             }
@@ -104,6 +104,12 @@ void Emitter::EmitBlood(Vector3 pos, int count, Color color) {
     }
 }
 
+void Emitter::Clear() {
+    for (auto& p : particles) {
+        p.active = false;
+    }
+}
+
 int Emitter::GetMaxParticleCount() const
 {
     return (int)particles.size();
@@ -35,6 +35,7 @@ public:
     void SetCanBurst(bool value);
     void SetParticleType(ParticleType type) { particleType = type; }
     void UpdateTrail(float dt);
+    void Clear(); //kill every live particle
     std::size_t GetActiveParticleCount() const;
     int GetMaxParticleCount() const;
 
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+// Stable reference to an enemy in the EnemyStore (world.h `enemies`).
+// Stays valid while other enemies are added and removed; once its own enemy is
+// removed the slot's generation moves on and enemies.Get() returns nullptr.
+struct EnemyHandle
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+    bool IsValid() const { return index != UINT32_MAX; }
+};
@@ -0,0 +1,126 @@
+#include "enemy_store.h"
+
+#include "raymath.h"
+#include "world.h"
+
+Character& EnemyStore::Add(const Character& c) {
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = (uint32_t)slots.size();
+        slots.emplace_back();
+    }
+
+    Slot& s = slots[index];
+    s.value.emplace(c);
+
+    Character& e = *s.value;
+    e.id = gEnemyCounter++;
+    e.handle = { index, s.generation };
+
+    if (e.type == CharacterType::Pterodactyl) dactyls.Add(index);
+    else if (e.type == CharacterType::Bat) bats.Add(index);
+
+    ptrs.push_back(&e);
+    hot.position.emplace_back();
+    hot.velocity.emplace_back();
+    hot.halfExtents.emplace_back();
+    hot.state.emplace_back();
+    hot.health.emplace_back();
+    hot.alive.emplace_back();
+    WriteHot(ptrs.size() - 1, e);
+
+    idToSlot[e.id] = index;
+    return e;
+}
+
+void EnemyStore::reserve(size_t n) {
+    ptrs.reserve(n);
+    idToSlot.reserve(n);
+    hot.position.reserve(n);
+    hot.velocity.reserve(n);
+    hot.halfExtents.reserve(n);
+    hot.state.reserve(n);
+    hot.health.reserve(n);
+    hot.alive.reserve(n);
+}
+
+void EnemyStore::WriteHot(size_t i, const Character& c) {
+    BoundingBox box = c.GetBoundingBox();
+    hot.position[i] = c.position;
+    hot.velocity[i] = c.velocity;
+    hot.halfExtents[i] = Vector3Scale(Vector3Subtract(box.max, box.min), 0.5f);
+    hot.state[i] = c.state;
+    hot.health[i] = c.currentHealth;
+    hot.alive[i] = c.isDead ? 0 : 1;
+}
+
+void EnemyStore::SyncHot() {
+    for (size_t i = 0; i < ptrs.size(); i++) {
+        WriteHot(i, *ptrs[i]);
+    }
+}
+
+Character* EnemyStore::Get(EnemyHandle h) const {
+    if (!h.IsValid() || h.index >= slots.size()) return nullptr;
+    const Slot& s = slots[h.index];
+    if (s.generation != h.generation || !s.value) return nullptr;
+    return const_cast<Character*>(&*s.value);
+}
+
+DactylData* EnemyStore::Dactyl(EnemyHandle h) {
+    return Get(h) ? dactyls.Find(h.index) : nullptr;
+}
+
+BatData* EnemyStore::Bat(EnemyHandle h) {
+    return Get(h) ? bats.Find(h.index) : nullptr;
+}
+
+Character* EnemyStore::FindById(int id) const {
+    auto it = idToSlot.find(id);
+    if (it == idToSlot.end()) return nullptr;
+    const Slot& s = slots[it->second];
+    return s.value ? const_cast<Character*>(&*s.value) : nullptr;
+}
+
+void EnemyStore::RemoveAt(size_t denseIndex) {
+    Character* gone = ptrs[denseIndex];
+    uint32_t index = gone->handle.index;
+
+    // move the last entry into the hole, the characters themselves don't move
+    ptrs[denseIndex] = ptrs.back();
+    ptrs.pop_back();
+
+    auto swapPop = [denseIndex](auto& v) { v[denseIndex] = v.back(); v.pop_back(); };
+    swapPop(hot.position);
+    swapPop(hot.velocity);
+    swapPop(hot.halfExtents);
+    swapPop(hot.state);
+    swapPop(hot.health);
+    swapPop(hot.alive);
+
+    idToSlot.erase(gone->id);
+    dactyls.Remove(index);
+    bats.Remove(index);
+
+    Slot& s = slots[index];
+    s.value.reset();
+    s.generation++;
+    freeSlots.push_back(index);
+}
+
+void EnemyStore::clear() {
+    ptrs.clear();
+    hot = EnemyHotData{};
+    dactyls.clear();
+    bats.clear();
+    idToSlot.clear();
+    freeSlots.clear();
+    for (uint32_t i = 0; i < (uint32_t)slots.size(); i++) {
+        slots[i].value.reset();
+        slots[i].generation++; // outstanding handles go stale
+        freeSlots.push_back(i);
+    }
+}
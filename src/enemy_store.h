@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "character.h"
+#include "enemy_handle.h"
+
+// Owns every enemy Character.
+//
+// Enemies live in fixed slots that never move, so a Character* stays good until that
+// enemy is removed. Ptrs() is the dense list systems iterate (what enemyPtrs used to be);
+// it is patched in place on add/remove (swap-remove), never rebuilt.
+// Anything held across frames (targets, harpoon victims) should keep an EnemyHandle
+// and resolve it with Get(), which returns nullptr once that enemy is gone.
+//
+// Hot() is a structure-of-arrays copy of the per-frame state, in the same order as Ptrs().
+// Systems that only test positions/bounds (repulsion, AI tiers, bullet broadphase) walk these
+// arrays instead of chasing each Character. SyncHot() runs once per frame, right after the
+// enemies move in UpdateEnemies, so bullet collision sees this frame's positions and the next
+// frame's AI reads a snapshot that doesn't change while enemies update.
+//
+// Type-specific state lives in side tables keyed by the enemy's slot, with entries only for
+// enemies of that type: Dactyl(h), Bat(h). Add() creates the entry from the Character's type.
+
+struct EnemyHotData
+{
+    std::vector<Vector3> position;
+    std::vector<Vector3> velocity;
+    std::vector<Vector3> halfExtents;      // of GetBoundingBox()
+    std::vector<CharacterState> state;
+    std::vector<int> health;
+    std::vector<uint8_t> alive;            // !isDead
+
+    size_t size() const { return position.size(); }
+};
+
+struct DactylData
+{
+    float verticalVel   = 0.0f;   // Y velocity
+    float desiredAlt    = 0.0f;   // target altitude above ground
+    bool  inAir         = false;  // optional latch: are we airborne?
+    float patrolAlt     = 1200.0f;
+};
+
+struct BatData
+{
+    //bob
+    float bobPhase = 0.0f;        // radians
+    float bobSpeed = 3.5f;        // radians per second
+    float bobAmplitude = 18.0f;   // world units
+    float hoverHeight = 225.0f;   // base offset above ground
+
+    //bloat
+    bool bloatBat = false;
+    bool hasExploded = false;
+};
+
+// Sparse per-slot table: slot -> packed entry, swap-removed like Ptrs().
+template<typename T>
+class EnemySideTable {
+public:
+    T& Add(uint32_t slot) {
+        if (slot >= slotToDense.size()) slotToDense.resize(slot + 1, -1);
+        if (slotToDense[slot] >= 0) return dense[slotToDense[slot]] = T{};
+        slotToDense[slot] = (int)dense.size();
+        denseSlot.push_back(slot);
+        dense.emplace_back();
+        return dense.back();
+    }
+
+    T* Find(uint32_t slot) {
+        if (slot >= slotToDense.size() || slotToDense[slot] < 0) return nullptr;
+        return &dense[slotToDense[slot]];
+    }
+
+    void Remove(uint32_t slot) {
+        if (slot >= slotToDense.size() || slotToDense[slot] < 0) return;
+        int i = slotToDense[slot];
+        dense[i] = dense.back();
+        denseSlot[i] = denseSlot.back();
+        slotToDense[denseSlot[i]] = i;
+        dense.pop_back();
+        denseSlot.pop_back();
+        slotToDense[slot] = -1;
+    }
+
+    void clear() {
+        slotToDense.clear();
+        dense.clear();
+        denseSlot.clear();
+    }
+
+    size_t size() const { return dense.size(); }
+
+private:
+    std::vector<int> slotToDense;   // -1 = no entry
+    std::vector<T> dense;
+    std::vector<uint32_t> denseSlot;
+};
+
+class EnemyStore {
+public:
+    // Copies the enemy into a free slot and gives it a fresh id and handle.
+    Character& Add(const Character& c);
+
+    Character* Get(EnemyHandle h) const;
+    Character* FindById(int id) const;
+
+    // nullptr when the handle is stale or the enemy isn't that type
+    DactylData* Dactyl(EnemyHandle h);
+    BatData* Bat(EnemyHandle h);
+
+    // Removes every enemy pred(c) is true for.
+    template<typename Pred>
+    void RemoveIf(Pred pred) {
+        for (size_t i = 0; i < ptrs.size(); ) {
+            if (pred(*ptrs[i])) { RemoveAt(i); continue; }
+            i++;
+        }
+    }
+
+    void clear();
+    void reserve(size_t n);
+
+    const std::vector<Character*>& Ptrs() const { return ptrs; }
+    const EnemyHotData& Hot() const { return hot; }
+    void SyncHot();
+    size_t size() const { return ptrs.size(); }
+    bool empty() const { return ptrs.empty(); }
+
+private:
+    struct Slot
+    {
+        std::optional<Character> value;
+        uint32_t generation = 0;
+    };
+
+    void RemoveAt(size_t denseIndex);
+    void WriteHot(size_t denseIndex, const Character& c);
+
+    std::deque<Slot> slots;        // deque: growing never moves existing slots
+    std::vector<uint32_t> freeSlots;
+    std::vector<Character*> ptrs;
+    EnemyHotData hot;
+    EnemySideTable<DactylData> dactyls;
+    EnemySideTable<BatData> bats;
+    std::unordered_map<int, uint32_t> idToSlot;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+
+// View frustum built from the actual camera projection (fovy, aspect, near/far),
+// tested against world-space AABBs. Conservative: a box is only rejected when it is
+// completely behind one of the six planes, so nothing partly on screen gets culled.
+//
+// Replaces the IsInViewCone center-point test for static geometry.
+
+struct Frustum {
+    Vector4 planes[6]; // xyz = inward normal, w = distance. Inside when dot(n, p) + w >= 0
+};
+
+enum class FrustumResult {
+    Outside,
+    Intersects,
+    Inside
+};
+
+inline Vector4 NormalizePlane(Vector4 p)
+{
+    float len = sqrtf(p.x * p.x + p.y * p.y + p.z * p.z);
+    if (len > 0.0f) { p.x /= len; p.y /= len; p.z /= len; p.w /= len; }
+    return p;
+}
+
+inline float ScreenAspect()
+{
+    return (GetScreenHeight() > 0) ? (float)GetScreenWidth() / (float)GetScreenHeight() : 1.0f;
+}
+
+// view * projection, the same pair BeginMode3D sets up
+inline Matrix MakeViewProjection(const Camera3D& cam, float aspect, float nearDist, float farDist)
+{
+    Matrix view = MatrixLookAt(cam.position, cam.target, cam.up);
+    Matrix proj;
+    if (cam.projection == CAMERA_ORTHOGRAPHIC) {
+        double top = cam.fovy * 0.5;
+        double right = top * aspect;
+        proj = MatrixOrtho(-right, right, -top, top, nearDist, farDist);
+    } else {
+        proj = MatrixPerspective(cam.fovy * DEG2RAD, aspect, nearDist, farDist);
+    }
+    return MatrixMultiply(view, proj);
+}
+
+// Planes straight out of view * projection (Gribb/Hartmann).
+inline Frustum MakeFrustum(const Camera3D& cam, float aspect, float nearDist, float farDist)
+{
+    Matrix m = MakeViewProjection(cam, aspect, nearDist, farDist);
+
+    // rows of the combined matrix (raymath stores columns)
+    Vector4 r0 = { m.m0, m.m4, m.m8,  m.m12 };
+    Vector4 r1 = { m.m1, m.m5, m.m9,  m.m13 };
+    Vector4 r2 = { m.m2, m.m6, m.m10, m.m14 };
+    Vector4 r3 = { m.m3, m.m7, m.m11, m.m15 };
+
+    auto add = [](Vector4 a, Vector4 b) { return Vector4{ a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w }; };
+    auto sub = [](Vector4 a, Vector4 b) { return Vector4{ a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w }; };
+
+    Frustum f;
+    f.planes[0] = NormalizePlane(add(r3, r0)); // left
+    f.planes[1] = NormalizePlane(sub(r3, r0)); // right
+    f.planes[2] = NormalizePlane(add(r3, r1)); // bottom
+    f.planes[3] = NormalizePlane(sub(r3, r1)); // top
+    f.planes[4] = NormalizePlane(add(r3, r2)); // near
+    f.planes[5] = NormalizePlane(sub(r3, r2)); // far
+    return f;
+}
+
+// Screen aspect, far plane at the draw distance.
+inline Frustum MakeCameraFrustum(const Camera3D& cam, float farDist)
+{
+    return MakeFrustum(cam, ScreenAspect(), 1.0f, farDist);
+}
+
+inline FrustumResult FrustumTestAABB(const Frustum& f, const BoundingBox& box)
+{
+    FrustumResult result = FrustumResult::Inside;
+
+    for (const Vector4& p : f.planes) {
+        // corner furthest along the normal, and the one furthest against it
+        Vector3 pos = { p.x >= 0.0f ? box.max.x : box.min.x,
+                        p.y >= 0.0f ? box.max.y : box.min.y,
+                        p.z >= 0.0f ? box.max.z : box.min.z };
+        Vector3 neg = { p.x >= 0.0f ? box.min.x : box.max.x,
+                        p.y >= 0.0f ? box.min.y : box.max.y,
+                        p.z >= 0.0f ? box.min.z : box.max.z };
+
+        if (p.x * pos.x + p.y * pos.y + p.z * pos.z + p.w < 0.0f) return FrustumResult::Outside;
+        if (p.x * neg.x + p.y * neg.y + p.z * neg.z + p.w < 0.0f) result = FrustumResult::Intersects;
+    }
+
+    return result;
+}
+
+inline bool FrustumContainsAABB(const Frustum& f, const BoundingBox& box)
+{
+    return FrustumTestAABB(f, box) != FrustumResult::Outside;
+}
+
+// World AABB of a local box under a transform (all 8 corners).
+inline BoundingBox TransformAABB(const BoundingBox& local, const Matrix& transform)
+{
+    BoundingBox out = { { 1e30f, 1e30f, 1e30f }, { -1e30f, -1e30f, -1e30f } };
+    for (int i = 0; i < 8; i++) {
+        Vector3 c = { (i & 1) ? local.max.x : local.min.x,
+                      (i & 2) ? local.max.y : local.min.y,
+                      (i & 4) ? local.max.z : local.min.z };
+        c = Vector3Transform(c, transform);
+        out.min = Vector3Min(out.min, c);
+        out.max = Vector3Max(out.max, c);
+    }
+    return out;
+}
@@ -21,6 +21,12 @@ namespace GameSettings
     inline constexpr float minFovY = 30.0f;
     inline constexpr float maxFovY = 80.0f;
 
+    //dynamic resolution: scene renders at dynResMinScale..1 per axis to hold the frame time
+    inline bool dynamicResolution = true;
+    inline float dynResMinScale = 0.5f;
+    inline float dynResTargetFps = 0.0f;   // 0 = monitor refresh rate
+    inline float dynResSharpen = 0.3f;     // unsharp mask on upscaled frames, 0 = off
+
     inline float maxDrawDist = 25000.0f;
     inline constexpr float minDrawDist = 5000.0f;
     inline constexpr float maxDrawDistLimit = 50000.0f;
@@ -49,6 +55,11 @@ namespace GameSettings
     inline float instancedFogStart = 3000.0f;
     inline float instancedFogEnd = 20000.0f;
 
+    //grass density falloff, per vegetation cell
+    inline float grassFullDensityDist = 5000.0f;
+    inline float grassMinDensityDist = 15000.0f;
+    inline float grassMinDensity = 0.25f;
+
     //randomized boss mobs. 3 percent chance for a large version of the enemy. 
     inline int BossPercentage = 3;
 
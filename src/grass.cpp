@@ -23,7 +23,7 @@ namespace Grass
     }
 
 void GenerateFromHeightmap(
-    Image& heightmap,
+    const HeightField& field,
     Vector3 terrainScale,
     float grassSpacing,
     float heightThreshold,
@@ -33,71 +33,63 @@ void GenerateFromHeightmap(
         Clear();
         gGrassInstanceSources.reserve(maxGrassCards);
 
-        if (heightmap.data == nullptr)
+        if (!field.IsValid())
         {
-            std::cout << "Grass::GenerateFromHeightmap failed: heightmap.data is null\n";
+            std::cout << "Grass::GenerateFromHeightmap failed: no heightfield loaded\n";
             return;
         }
 
-        Image heightCopy = ImageCopy(heightmap);
-        ImageFormat(&heightCopy, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE);
-
-        unsigned char* pixels = (unsigned char*)heightCopy.data;
+        const int width = field.Width();
+        const int height = field.Height();
 
         int step = (int)grassSpacing;
         if (step < 1) step = 1;
 
         const float jitterAmount = grassSpacing * 0.45f;
 
-        for (int z = 0; z < heightCopy.height; z += step)
+        for (int z = 0; z < height; z += step)
         {
-            for (int x = 0; x < heightCopy.width; x += step)
+            for (int x = 0; x < width; x += step)
             {
                 if ((int)gGrassInstanceSources.size() >= maxGrassCards)
-                {
-                    UnloadImage(heightCopy);
                     return;
-                }
 
                 // Randomly offset the sample so the grass does not form a perfect grid.
-                int jitterX = GetRandomValue((int)-jitterAmount, (int)jitterAmount);
-                int jitterZ = GetRandomValue((int)-jitterAmount, (int)jitterAmount);
+                int jitterX = RandomInt((int)-jitterAmount, (int)jitterAmount);
+                int jitterZ = RandomInt((int)-jitterAmount, (int)jitterAmount);
 
                 int sampleX = x + jitterX;
                 int sampleZ = z + jitterZ;
 
-                sampleX = Clamp(sampleX, 0, heightCopy.width - 1);
-                sampleZ = Clamp(sampleZ, 0, heightCopy.height - 1);
-
-                int index = sampleZ * heightCopy.width + sampleX;
+                sampleX = Clamp(sampleX, 0, width - 1);
+                sampleZ = Clamp(sampleZ, 0, height - 1);
 
-                unsigned char heightValue = pixels[index];
-                float height01 = heightValue / 255.0f;
+                float height01 = field.Texel01(sampleX, sampleZ);
 
                 if (height01 < heightThreshold)
                     continue;
 
                 // Optional: skip some valid spots so it looks more natural.
                 // Higher number = less grass.
-                if (GetRandomValue(0, 100) > 50)
+                if (RandomInt(0, 100) > 50)
                     continue;
 
-                float worldX = ((float)sampleX / (float)heightCopy.width)  * terrainScale.x - terrainScale.x * 0.5f;
-                float worldZ = ((float)sampleZ / (float)heightCopy.height) * terrainScale.z - terrainScale.z * 0.5f;
+                float worldX = ((float)sampleX / (float)width)  * terrainScale.x - terrainScale.x * 0.5f;
+                float worldZ = ((float)sampleZ / (float)height) * terrainScale.z - terrainScale.z * 0.5f;
                 float worldY = height01 * terrainScale.y;
 
-                float sinkAmount = (float)GetRandomValue(5, 25);
+                float sinkAmount = (float)RandomInt(5, 25);
                 worldY -= sinkAmount;
 
                 GrassInstanceSource grass;
                 grass.position = { worldX, worldY, worldZ };
 
-                grass.yawDeg = (float)GetRandomValue(0, 359);
+                grass.yawDeg = (float)RandomInt(0, 359);
 
                 float randomScale = RandomFloat(0.15f, 0.4f);
                 grass.scale = randomScale;
 
-                grass.textureIndex = GetRandomValue(0, 3);
+                grass.textureIndex = RandomInt(0, 3);
 
                 grass.transform = BuildGrassTransform(
                     grass.position,
@@ -108,7 +100,5 @@ void GenerateFromHeightmap(
                 gGrassInstanceSources.push_back(grass);
             }
         }
-
-        UnloadImage(heightCopy);
     }
 }
@@ -3,6 +3,7 @@
 #include "raylib.h"
 #include "raymath.h"
 #include <vector>
+#include "heightfield.h"
 
 struct GrassInstanceSource
 {
@@ -27,7 +28,7 @@ namespace Grass
     // For now, this can use your existing grass generation logic.
     // The goal is just to fill gGrassInstanceSources.
     void GenerateFromHeightmap(
-        Image& heightmap,
+        const HeightField& field,
         Vector3 terrainScale,
         float grassSpacing,
         float heightThreshold,
@@ -0,0 +1,304 @@
+#include "heightfield.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "raymath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HEIGHTFIELD_SSE2 1
+#endif
+
+HeightField gHeightField;
+
+// <image>.hf16: this header, then width * height little-endian uint16 samples
+struct HeightFieldCacheHeader
+{
+    char magic[4];       // "HF16"
+    int32_t version;
+    int32_t width;
+    int32_t height;
+    int64_t sourceTime;  // GetFileModTime of the image it was made from
+};
+
+static const int HEIGHTFIELD_CACHE_VERSION = 1;
+
+bool HeightField::Load(const std::string& imagePath, Vector3 terrainScale)
+{
+    Clear();
+
+    const std::string cachePath = imagePath + ".hf16";
+    const long sourceTime = GetFileModTime(imagePath.c_str());
+
+    if (ReadCache(cachePath, sourceTime))
+    {
+        SetExtents(terrainScale);
+        return true;
+    }
+
+    // slow path: decode, convert to 8-bit gray once, widen into the field, drop the image
+    Image img = LoadImage(imagePath.c_str());
+    if (!img.data)
+    {
+        TraceLog(LOG_WARNING, "HeightField: could not load %s", imagePath.c_str());
+        return false;
+    }
+    ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE);
+    Build(img, terrainScale);
+    UnloadImage(img);
+
+    if (IsValid()) WriteCache(cachePath, sourceTime);
+    return IsValid();
+}
+
+void HeightField::Build(const Image& gray, Vector3 terrainScale)
+{
+    Clear();
+    if (!gray.data || gray.width < 2 || gray.height < 2) return;
+    if (gray.format != PIXELFORMAT_UNCOMPRESSED_GRAYSCALE)
+    {
+        TraceLog(LOG_WARNING, "HeightField: heightmap is not 8-bit grayscale");
+        return;
+    }
+
+    width = gray.width;
+    height = gray.height;
+
+    // v * 257 maps 0..255 onto 0..65535 exactly
+    const unsigned char* px = (const unsigned char*)gray.data;
+    samples.resize((size_t)width * height);
+    for (size_t i = 0; i < samples.size(); i++) samples[i] = (uint16_t)(px[i] * 257);
+
+    SetExtents(terrainScale);
+}
+
+void HeightField::SetExtents(Vector3 terrainScale)
+{
+    heightScale = terrainScale.y / 65535.0f;
+
+    // the terrain spans -scale/2..+scale/2, sample i sits at i / (w - 1) of the way across
+    minX = -terrainScale.x * 0.5f;
+    minZ = -terrainScale.z * 0.5f;
+    maxGX = (float)(width - 1);
+    maxGZ = (float)(height - 1);
+    toGridX = maxGX / terrainScale.x;
+    toGridZ = maxGZ / terrainScale.z;
+}
+
+void HeightField::Clear()
+{
+    samples.clear();
+    samples.shrink_to_fit();
+    DropMips();
+    width = height = 0;
+}
+
+bool HeightField::ReadCache(const std::string& path, long sourceTime)
+{
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+
+    HeightFieldCacheHeader h = {};
+    bool ok = fread(&h, sizeof(h), 1, f) == 1
+        && memcmp(h.magic, "HF16", 4) == 0
+        && h.version == HEIGHTFIELD_CACHE_VERSION
+        && h.sourceTime == (int64_t)sourceTime
+        && h.width >= 2 && h.height >= 2;
+
+    if (ok)
+    {
+        // straight into the final buffer, no intermediate image
+        width = h.width;
+        height = h.height;
+        samples.resize((size_t)width * height);
+        ok = fread(samples.data(), sizeof(uint16_t), samples.size(), f) == samples.size();
+    }
+    fclose(f);
+
+    if (!ok)
+    {
+        // stale or truncated, rebuilt from the image
+        samples.clear();
+        width = height = 0;
+        return false;
+    }
+    return true;
+}
+
+void HeightField::WriteCache(const std::string& path, long sourceTime) const
+{
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f)
+    {
+        TraceLog(LOG_INFO, "HeightField: could not write cache %s", path.c_str());
+        return;
+    }
+
+    HeightFieldCacheHeader h = {};
+    memcpy(h.magic, "HF16", 4);
+    h.version = HEIGHTFIELD_CACHE_VERSION;
+    h.width = width;
+    h.height = height;
+    h.sourceTime = (int64_t)sourceTime;
+
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+        && fwrite(samples.data(), sizeof(uint16_t), samples.size(), f) == samples.size();
+    fclose(f);
+
+    if (!ok)
+    {
+        TraceLog(LOG_WARNING, "HeightField: failed writing cache %s", path.c_str());
+        remove(path.c_str());
+    }
+}
+
+void HeightField::BuildMips(int minSize)
+{
+    DropMips();
+    if (!IsValid()) return;
+
+    int w = width, h = height;
+    while (w / 2 >= minSize && h / 2 >= minSize)
+    {
+        const uint16_t* src = mips.empty() ? samples.data() : mips.back().samples.data();
+
+        MipLevel m;
+        m.width = w / 2;
+        m.height = h / 2;
+        m.samples.resize((size_t)m.width * m.height);
+
+        // 2x2 box filter (an odd last row/column is dropped)
+        for (int z = 0; z < m.height; z++)
+        {
+            const uint16_t* row0 = src + (size_t)(z * 2) * w;
+            const uint16_t* row1 = row0 + w;
+            uint16_t* out = &m.samples[(size_t)z * m.width];
+            for (int x = 0; x < m.width; x++)
+            {
+                unsigned sum = row0[x * 2] + row0[x * 2 + 1] + row1[x * 2] + row1[x * 2 + 1];
+                out[x] = (uint16_t)((sum + 2) / 4);
+            }
+        }
+
+        w = m.width;
+        h = m.height;
+        mips.push_back(std::move(m));
+    }
+}
+
+void HeightField::DropMips()
+{
+    mips.clear();
+    mips.shrink_to_fit();
+}
+
+float HeightField::MipTexel01(int level, int x, int z) const
+{
+    if (level == 0) return Texel01(x, z);
+
+    const MipLevel& m = mips[level - 1];
+    x = std::clamp(x, 0, m.width - 1);
+    z = std::clamp(z, 0, m.height - 1);
+    return m.samples[(size_t)z * m.width + x] * (1.0f / 65535.0f);
+}
+
+void HeightField::Locate(float worldX, float worldZ, int& x0, int& z0, float& tx, float& tz) const
+{
+    float gx = Clamp((worldX - minX) * toGridX, 0.0f, maxGX);
+    float gz = Clamp((worldZ - minZ) * toGridZ, 0.0f, maxGZ);
+
+    // last cell includes the far edge, so x0 + 1 is always in range
+    x0 = std::min((int)gx, width - 2);
+    z0 = std::min((int)gz, height - 2);
+    tx = gx - (float)x0;
+    tz = gz - (float)z0;
+}
+
+float HeightField::Sample(float worldX, float worldZ) const
+{
+    int x0, z0;
+    float tx, tz;
+    Locate(worldX, worldZ, x0, z0, tx, tz);
+
+    const uint16_t* row0 = &samples[(size_t)z0 * width + x0];
+    const uint16_t* row1 = row0 + width;
+
+    float h0 = row0[0] + ((float)row0[1] - row0[0]) * tx;
+    float h1 = row1[0] + ((float)row1[1] - row1[0]) * tx;
+    return (h0 + (h1 - h0) * tz) * heightScale;
+}
+
+void HeightField::SampleHeights(const Vector3* points, float* outHeights, size_t count) const
+{
+    size_t i = 0;
+
+#ifdef HEIGHTFIELD_SSE2
+    // Coordinates and lerps four wide. The corner fetches stay scalar (no gather in SSE2).
+    const __m128 minXv = _mm_set1_ps(minX), minZv = _mm_set1_ps(minZ);
+    const __m128 toGXv = _mm_set1_ps(toGridX), toGZv = _mm_set1_ps(toGridZ);
+    const __m128 maxGXv = _mm_set1_ps(maxGX), maxGZv = _mm_set1_ps(maxGZ);
+    const __m128 lastCellXv = _mm_set1_ps((float)(width - 2)), lastCellZv = _mm_set1_ps((float)(height - 2));
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 scale = _mm_set1_ps(heightScale);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const Vector3* p = points + i;
+        __m128 gx = _mm_mul_ps(_mm_sub_ps(_mm_set_ps(p[3].x, p[2].x, p[1].x, p[0].x), minXv), toGXv);
+        __m128 gz = _mm_mul_ps(_mm_sub_ps(_mm_set_ps(p[3].z, p[2].z, p[1].z, p[0].z), minZv), toGZv);
+        gx = _mm_min_ps(_mm_max_ps(gx, zero), maxGXv);
+        gz = _mm_min_ps(_mm_max_ps(gz, zero), maxGZv);
+
+        __m128i x0 = _mm_cvttps_epi32(_mm_min_ps(gx, lastCellXv));
+        __m128i z0 = _mm_cvttps_epi32(_mm_min_ps(gz, lastCellZv));
+        __m128 tx = _mm_sub_ps(gx, _mm_cvtepi32_ps(x0));
+        __m128 tz = _mm_sub_ps(gz, _mm_cvtepi32_ps(z0));
+
+        alignas(16) int xs[4];
+        alignas(16) int zs[4];
+        _mm_store_si128((__m128i*)xs, x0);
+        _mm_store_si128((__m128i*)zs, z0);
+
+        alignas(16) float h00[4], h10[4], h01[4], h11[4];
+        for (int k = 0; k < 4; k++)
+        {
+            const uint16_t* row0 = &samples[(size_t)zs[k] * width + xs[k]];
+            const uint16_t* row1 = row0 + width;
+            h00[k] = row0[0]; h10[k] = row0[1];
+            h01[k] = row1[0]; h11[k] = row1[1];
+        }
+
+        __m128 a = _mm_load_ps(h00), b = _mm_load_ps(h10);
+        __m128 c = _mm_load_ps(h01), d = _mm_load_ps(h11);
+        __m128 top = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), tx));
+        __m128 bot = _mm_add_ps(c, _mm_mul_ps(_mm_sub_ps(d, c), tx));
+        __m128 h = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bot, top), tz));
+        _mm_storeu_ps(outHeights + i, _mm_mul_ps(h, scale));
+    }
+#endif
+
+    for (; i < count; i++) outHeights[i] = Sample(points[i].x, points[i].z);
+}
+
+Vector2 HeightField::Gradient(float worldX, float worldZ) const
+{
+    int x0, z0;
+    float tx, tz;
+    Locate(worldX, worldZ, x0, z0, tx, tz);
+
+    const uint16_t* row0 = &samples[(size_t)z0 * width + x0];
+    const uint16_t* row1 = row0 + width;
+    const float h00 = row0[0], h10 = row0[1], h01 = row1[0], h11 = row1[1];
+
+    // derivative of the bilinear patch, per grid step, then per world unit
+    float dx = ((h10 - h00) * (1.0f - tz) + (h11 - h01) * tz) * heightScale * toGridX;
+    float dz = ((h01 - h00) * (1.0f - tx) + (h11 - h10) * tx) * heightScale * toGridZ;
+    return { dx, dz };
+}
+
+Vector3 HeightField::Normal(float worldX, float worldZ) const
+{
+    Vector2 g = Gradient(worldX, worldZ);
+    return Vector3Normalize({ -g.x, 1.0f, -g.y });
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "raylib.h"
+
+// The level's terrain heights, loaded once and shared by everything that needs them: ground
+// snapping, terrain chunks, grass, vegetation and the nav grid all borrow this instead of
+// keeping their own copy or conversion of the heightmap image.
+//
+// Samples are 16-bit (0..65535 of terrainScale.y), half the size of a float grid and lossless
+// for the 8-bit source images. World -> grid is a subtract and a multiply (reciprocal scales
+// kept), world queries are bilinear so ground snapping follows the terrain mesh.
+//
+// Load() keeps a raw copy next to the image (<image>.hf16) and reads that straight into the
+// sample buffer on later loads, skipping the PNG decode and format conversion.
+
+class HeightField
+{
+public:
+    bool Load(const std::string& imagePath, Vector3 terrainScale);
+    void Build(const Image& gray, Vector3 terrainScale);
+    void Clear();
+    bool IsValid() const { return !samples.empty(); }
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+    // raw samples, clamped to the edges: normalized 0..1, or world units
+    float Texel01(int x, int z) const { return At(x, z) * (1.0f / 65535.0f); }
+    float TexelHeight(int x, int z) const { return At(x, z) * heightScale; }
+
+    // bilinear, clamped to the terrain edges
+    float Sample(float worldX, float worldZ) const;
+    float Sample(Vector3 p) const { return Sample(p.x, p.z); }
+
+    // outHeights[i] = Sample(points[i]), four points per step where SSE2 is available
+    void SampleHeights(const Vector3* points, float* outHeights, size_t count) const;
+
+    // d(height)/dx and d(height)/dz of the bilinear surface, and the normal built from them
+    Vector2 Gradient(float worldX, float worldZ) const;
+    Vector3 Normal(float worldX, float worldZ) const;
+
+    // Box-filtered half-size copies for coarse consumers (nav grid). Level 0 is the full
+    // grid, each level halves both sides, stopping before either side drops below minSize.
+    // Build them for the load step that needs them and drop them after.
+    void BuildMips(int minSize);
+    void DropMips();
+    int MipCount() const { return 1 + (int)mips.size(); }
+    int MipWidth(int level) const { return level == 0 ? width : mips[level - 1].width; }
+    int MipHeight(int level) const { return level == 0 ? height : mips[level - 1].height; }
+    float MipTexel01(int level, int x, int z) const;
+
+private:
+    struct MipLevel
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<uint16_t> samples;
+    };
+
+    std::vector<uint16_t> samples; // width * height
+    std::vector<MipLevel> mips;    // levels 1..n
+    int width = 0;
+    int height = 0;
+
+    float heightScale = 0.0f; // world units per sample step, terrainScale.y / 65535
+    float minX = 0.0f;        // world position of sample (0, 0)
+    float minZ = 0.0f;
+    float toGridX = 0.0f;     // samples per world unit
+    float toGridZ = 0.0f;
+    float maxGX = 0.0f;       // width - 1
+    float maxGZ = 0.0f;
+
+    uint16_t At(int x, int z) const
+    {
+        x = x < 0 ? 0 : (x >= width ? width - 1 : x);
+        z = z < 0 ? 0 : (z >= height ? height - 1 : z);
+        return samples[(size_t)z * width + x];
+    }
+
+    void SetExtents(Vector3 terrainScale);
+    bool ReadCache(const std::string& path, long sourceTime);
+    void WriteCache(const std::string& path, long sourceTime) const;
+
+    // grid cell and fractions for a world position
+    void Locate(float worldX, float worldZ, int& x0, int& z0, float& tx, float& tz) const;
+};
+
+extern HeightField gHeightField;
@@ -3,6 +3,8 @@
 #include <queue>
 #include <limits>
 #include <cmath>
+#include <algorithm>
+#include <cassert>
 
 // --------------------------------------
 // HeightmapNavGrid helpers
@@ -54,28 +56,16 @@ void HeightmapNavGrid::WorldToCell(const Vector3& worldPos, int& outX, int& outZ
 
 namespace HeightmapPathfinding
 {
-    // Helper to sample a grayscale height from the original heightmap at normalized coords
-    static float SampleHeightNormalized(const Image& img, float u, float v)
+    // Texel containing normalized coord u on a row of `size` texels. Texel i covers
+    // [i/size, (i+1)/size), so a cell centre on a same-sized grid lands on its own texel.
+    static int TexelAt(float u, int size)
     {
-        // Clamp
-        if (u < 0.0f) u = 0.0f;
-        if (u > 1.0f) u = 1.0f;
-        if (v < 0.0f) v = 0.0f;
-        if (v > 1.0f) v = 1.0f;
-
-        int ix = (int)(u * (img.width  - 1));
-        int iy = (int)(v * (img.height - 1));
-
-        // Assuming PIXELFORMAT_UNCOMPRESSED_GRAYSCALE (1 byte per pixel)
-        unsigned char* data = (unsigned char*)img.data;
-        int idx = iy * img.width + ix;
-
-        unsigned char value = data[idx];
-        return (float)value / 255.0f; // 0..1
+        u = std::clamp(u, 0.0f, 1.0f);
+        return std::min((int)(u * size), size - 1);
     }
 
     HeightmapNavGrid BuildNavGridFromHeightmap(
-        const Image& heightmap,
+        const HeightField& field,
         int gridWidth,
         int gridHeight,
         float seaLevel,
@@ -97,6 +87,16 @@ namespace HeightmapPathfinding
             -worldSizeZ * 0.5f
         };
 
+        // coarsest level that still has a sample per cell; box filtered, so small
+        // bumps average out instead of aliasing into the grid
+        int level = 0;
+        while (level + 1 < field.MipCount() &&
+               field.MipWidth(level + 1) >= gridWidth &&
+               field.MipHeight(level + 1) >= gridHeight)
+        {
+            level++;
+        }
+
         nav.heightSamples.resize(gridWidth * gridHeight);
         nav.walkable.resize(gridWidth * gridHeight);
 
@@ -109,7 +109,14 @@ namespace HeightmapPathfinding
                 float u = (gx + 0.5f) / (float)gridWidth;
                 float v = (gz + 0.5f) / (float)gridHeight;
 
-                float h = SampleHeightNormalized(heightmap, u, v);
+                int ix = TexelAt(u, field.MipWidth(level));
+                int iz = TexelAt(v, field.MipHeight(level));
+
+                // a mip the size of the grid must map cell (gx, gz) to texel (gx, gz)
+                assert(field.MipWidth(level)  != gridWidth  || ix == gx);
+                assert(field.MipHeight(level) != gridHeight || iz == gz);
+
+                float h = field.MipTexel01(level, ix, iz); // 0..1
                 int idx = gz * gridWidth + gx;
 
                 nav.heightSamples[idx] = h;
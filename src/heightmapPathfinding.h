@@ -2,6 +2,7 @@
 
 #include "raylib.h"
 #include <vector>
+#include "heightfield.h"
 
 // Basic grid cell coordinate
 struct HMCell
@@ -38,11 +39,11 @@ struct HeightmapNavGrid
 
 namespace HeightmapPathfinding
 {
-    // Build a coarse nav grid from a grayscale heightmap.
+    // Build a coarse nav grid from the level's HeightField.
     // gridWidth / gridHeight is *nav* resolution (e.g. 256x256, 512x512, etc.),
-    // not the heightmap resolution.
+    // not the heightmap resolution. Samples the smallest mip that still covers it.
     HeightmapNavGrid BuildNavGridFromHeightmap(
-        const Image& heightmap,
+        const HeightField& field,
         int gridWidth,
         int gridHeight,
         float seaLevel,
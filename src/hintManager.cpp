@@ -4,6 +4,7 @@
 #include "world.h"
 #include "boat.h"
 #include "sound_manager.h"
+#include "replay.h"
 
 // ------------------------- Utilities -------------------------
 static float clampf(float x, float a, float b) { return (x < a) ? a : (x > b) ? b : x; }
@@ -90,16 +91,16 @@ void HintManager::UpdateTutorial(){
     if (player.isMoving && currentIndex == 0){//movement check
         Advance();
     }
-    Vector2 delta = GetMouseDelta();
+    Vector2 delta = Replay::GetMouseDelta();
     if (currentIndex == 1 && delta.x != 0 && delta.y != 0){ //mouse check
         Advance();
     }
 
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && currentIndex == 2){ //fire or swing check
+    if (Replay::IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && currentIndex == 2){ //fire or swing check
         Advance();
     }
 
-    if (IsKeyPressed(KEY_Q) && currentIndex == 3){ //switch weapon check
+    if (Replay::IsKeyPressed(KEY_Q) && currentIndex == 3){ //switch weapon check
         Advance();
     }
 
@@ -111,7 +112,7 @@ void HintManager::UpdateTutorial(){
         Advance();
     }
 
-    if (currentIndex == 6 && IsKeyPressed(KEY_LEFT_SHIFT)){ //run check
+    if (currentIndex == 6 && Replay::IsKeyPressed(KEY_LEFT_SHIFT)){ //run check
         Advance();
     }
 
@@ -130,26 +131,26 @@ void HintManager::UpdateTutorial(){
         Clear(); //erase message if you die before taking health potion. 
     }
 
-    if (IsKeyPressed(KEY_ONE) && currentIndex == -1){ //clear on use healthpot
+    if (Replay::IsKeyPressed(KEY_ONE) && currentIndex == -1){ //clear on use healthpot
         Clear(); //clears message and override and sets current index to -1
     }
 
-    if (IsKeyPressed(KEY_E) || IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT)){ //clears tutorial
+    if (Replay::IsKeyPressed(KEY_E) || Replay::IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT)){ //clears tutorial
         Clear();
         
     }
 
-    if (IsKeyPressed(KEY_F)){
+    if (Replay::IsKeyPressed(KEY_F)){
         Clear();
     }
 
-    if (IsKeyPressed(KEY_G)){
+    if (Replay::IsKeyPressed(KEY_G)){
         Clear();
     }
 
   
 
-    if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT) && (player.activeWeapon == WeaponType::Crossbow || player.activeWeapon == WeaponType::Blunderbuss)){
+    if (Replay::IsMouseButtonPressed(MOUSE_BUTTON_RIGHT) && (player.activeWeapon == WeaponType::Crossbow || player.activeWeapon == WeaponType::Blunderbuss)){
         Clear();
     }
 
@@ -12,6 +12,7 @@
 #include "shaderSetup.h"
 #include "game_settings.h"
 #include "dungeon_props.h"
+#include "replay.h"
 
 
 InputMode currentInputMode = InputMode::KeyboardMouse;
@@ -19,12 +20,12 @@ InputMode currentInputMode = InputMode::KeyboardMouse;
 void ControlPlayerWhileFreeCam(float deltaTime){
     //control player with arrow keys while in free cam. 
     Vector3 input = {0, 0, 0};
-    if (IsKeyDown(KEY_UP)) input.z += 1;
-    if (IsKeyDown(KEY_DOWN)) input.z -= 1;
-    if (IsKeyDown(KEY_LEFT)) input.x += 1;
-    if (IsKeyDown(KEY_RIGHT)) input.x -= 1;
+    if (Replay::IsKeyDown(KEY_UP)) input.z += 1;
+    if (Replay::IsKeyDown(KEY_DOWN)) input.z -= 1;
+    if (Replay::IsKeyDown(KEY_LEFT)) input.x += 1;
+    if (Replay::IsKeyDown(KEY_RIGHT)) input.x -= 1;
 
-    player.running = IsKeyDown(KEY_LEFT_SHIFT) && player.canRun;
+    player.running = Replay::IsKeyDown(KEY_LEFT_SHIFT) && player.canRun;
     float speed = player.running ? player.runSpeed : player.walkSpeed;
 
     if (input.x != 0 || input.z != 0) {
@@ -55,7 +56,7 @@ void debugControls(Camera& camera, float deltaTime){
         ControlPlayerWhileFreeCam(deltaTime); //move the player around with the arrow keys while controlling free cam. 
     }
 
-    if (IsKeyPressed(KEY_F3))
+    if (Replay::IsKeyPressed(KEY_F3))
     {
         ToggleThirdPerson();
     }
@@ -77,7 +78,7 @@ void HandleMouseLook()
 
     if (!look) return;
 
-    Vector2 mouseDelta = GetMouseDelta();
+    Vector2 mouseDelta = Replay::GetMouseDelta();
 
     float sensitivity = GameSettings::mouseSensitivity;
 
@@ -129,10 +130,10 @@ float Expo(float x)
 
 void HandleGamepadLook(float dt)
 {
-    if (!IsGamepadAvailable(0)) return;
+    if (!Replay::IsGamepadAvailable(0)) return;
 
-    float rx = GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_X);
-    float ry = GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_Y);
+    float rx = Replay::GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_X);
+    float ry = Replay::GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_Y);
 
     rx = Expo(rx);
     ry = Expo(ry);
@@ -0,0 +1,125 @@
+#include "instanced_draw.h"
+
+#include "raymath.h"
+#include "rlgl.h"
+
+static uint32_t SpreadBits16(uint32_t v)
+{
+    v &= 0xFFFF;
+    v = (v | (v << 8)) & 0x00FF00FF;
+    v = (v | (v << 4)) & 0x0F0F0F0F;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+}
+
+uint32_t ZOrderKey(uint32_t x, uint32_t z)
+{
+    return SpreadBits16(x) | (SpreadBits16(z) << 1);
+}
+
+unsigned int UploadInstanceTransforms(const std::vector<Matrix>& transforms)
+{
+    if (transforms.empty()) return 0;
+    return rlLoadVertexBuffer(transforms.data(), (int)(transforms.size() * sizeof(Matrix)), false);
+}
+
+void AppendInstanceRange(std::vector<InstanceRange>& ranges, int first, int count, int mergeGap)
+{
+    if (count <= 0) return;
+
+    if (!ranges.empty())
+    {
+        InstanceRange& last = ranges.back();
+        int lastEnd = last.first + last.count;
+        if (first >= lastEnd && first - lastEnd <= mergeGap)
+        {
+            last.count = first + count - last.first;
+            return;
+        }
+    }
+    ranges.push_back({ first, count });
+}
+
+static bool IsCubemapMap(int i)
+{
+    return i == MATERIAL_MAP_CUBEMAP || i == MATERIAL_MAP_IRRADIANCE || i == MATERIAL_MAP_PREFILTER;
+}
+
+void DrawMeshInstancedRanges(const Mesh& mesh, const Material& material, unsigned int instanceVbo,
+                             const std::vector<InstanceRange>& ranges)
+{
+    if (instanceVbo == 0 || ranges.empty()) return;
+
+    const Shader& sh = material.shader;
+    const int instanceLoc = sh.locs[SHADER_LOC_MATRIX_MODEL];
+    if (instanceLoc < 0) return;
+
+    rlEnableShader(sh.id);
+
+    if (sh.locs[SHADER_LOC_COLOR_DIFFUSE] != -1)
+    {
+        Color c = material.maps[MATERIAL_MAP_DIFFUSE].color;
+        float values[4] = { c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+        rlSetUniform(sh.locs[SHADER_LOC_COLOR_DIFFUSE], values, RL_SHADER_UNIFORM_VEC4, 1);
+    }
+
+    Matrix matView = rlGetMatrixModelview();
+    Matrix matProjection = rlGetMatrixProjection();
+    Matrix matModelView = MatrixMultiply(rlGetMatrixTransform(), matView);
+
+    if (sh.locs[SHADER_LOC_MATRIX_VIEW] != -1) rlSetUniformMatrix(sh.locs[SHADER_LOC_MATRIX_VIEW], matView);
+    if (sh.locs[SHADER_LOC_MATRIX_PROJECTION] != -1) rlSetUniformMatrix(sh.locs[SHADER_LOC_MATRIX_PROJECTION], matProjection);
+    if (sh.locs[SHADER_LOC_MATRIX_NORMAL] != -1) rlSetUniformMatrix(sh.locs[SHADER_LOC_MATRIX_NORMAL], MatrixTranspose(MatrixInvert(rlGetMatrixTransform())));
+    rlSetUniformMatrix(sh.locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(matModelView, matProjection));
+
+    for (int i = 0; i <= MATERIAL_MAP_BRDF; i++)
+    {
+        if (material.maps[i].texture.id == 0) continue;
+        rlActiveTextureSlot(i);
+        if (IsCubemapMap(i)) rlEnableTextureCubemap(material.maps[i].texture.id);
+        else rlEnableTexture(material.maps[i].texture.id);
+        rlSetUniform(sh.locs[SHADER_LOC_MAP_DIFFUSE + i], &i, RL_SHADER_UNIFORM_INT, 1);
+    }
+
+    rlEnableVertexArray(mesh.vaoId);
+    rlEnableVertexBuffer(instanceVbo);
+    for (int c = 0; c < 4; c++)
+    {
+        rlEnableVertexAttribute(instanceLoc + c);
+        rlSetVertexAttributeDivisor(instanceLoc + c, 1);
+    }
+
+    for (const InstanceRange& r : ranges)
+    {
+        // point the mat4 attribute at the start of this run
+        for (int c = 0; c < 4; c++)
+        {
+            rlSetVertexAttribute(instanceLoc + c, 4, RL_FLOAT, false, sizeof(Matrix),
+                                 r.first * (int)sizeof(Matrix) + c * (int)sizeof(Vector4));
+        }
+
+        if (mesh.indices != nullptr) rlDrawVertexArrayElementsInstanced(0, mesh.triangleCount * 3, 0, r.count);
+        else rlDrawVertexArrayInstanced(0, mesh.vertexCount, r.count);
+    }
+
+    // The VAO belongs to the model as well, leave it the way plain DrawMesh expects.
+    for (int c = 0; c < 4; c++)
+    {
+        rlSetVertexAttributeDivisor(instanceLoc + c, 0);
+        rlDisableVertexAttribute(instanceLoc + c);
+    }
+
+    for (int i = 0; i <= MATERIAL_MAP_BRDF; i++)
+    {
+        if (material.maps[i].texture.id == 0) continue;
+        rlActiveTextureSlot(i);
+        if (IsCubemapMap(i)) rlDisableTextureCubemap();
+        else rlDisableTexture();
+    }
+
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlDisableShader();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "raylib.h"
+
+// Instanced drawing from transforms that already live on the GPU.
+//
+// raylib's DrawMeshInstanced creates a VBO, uploads every matrix and deletes the VBO on each
+// call. For static sets (dungeon tiles, vegetation) upload once with UploadInstanceTransforms
+// and draw runs of that buffer with DrawMeshInstancedRanges. Nothing is uploaded per frame.
+
+// Run of consecutive instances in a resident buffer.
+struct InstanceRange
+{
+    int first = 0;
+    int count = 0;
+};
+
+// Z-order (Morton) key of a 2D cell, low 16 bits of each coordinate interleaved. Sorting a
+// static set by it before upload keeps neighbouring cells next to each other in the buffer,
+// so whatever is on screen turns into a few long ranges.
+uint32_t ZOrderKey(uint32_t x, uint32_t z);
+
+// 0 on failure. Free with rlUnloadVertexBuffer.
+unsigned int UploadInstanceTransforms(const std::vector<Matrix>& transforms);
+
+// Adds [first, first + count) to ranges, extending the last range instead when the hidden
+// gap in between is at most mergeGap instances (drawing a few extra beats another draw call).
+void AppendInstanceRange(std::vector<InstanceRange>& ranges, int first, int count, int mergeGap);
+
+// Same shader/texture setup as DrawMeshInstanced, one instanced draw per range.
+// The instance attribute location is material.shader.locs[SHADER_LOC_MATRIX_MODEL].
+void DrawMeshInstancedRanges(const Mesh& mesh, const Material& material, unsigned int instanceVbo,
+                             const std::vector<InstanceRange>& ranges);
@@ -32,6 +32,10 @@ void Inventory::AddItemAmount(const std::string& itemId, int amount){
     items[itemId] += amount;
 }
 
+void Inventory::SetItemCount(const std::string& itemId, int count){
+    items[itemId] = count;
+}
+
 bool Inventory::UseItem(const std::string& itemId) {
     auto it = items.find(itemId);
     if (it != items.end() && it->second > 0) {
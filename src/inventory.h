@@ -13,6 +13,7 @@ class Inventory {
 public:
     void AddItem(const std::string& itemId);
     void AddItemAmount(const std::string& itemId, int amount = 1);
+    void SetItemCount(const std::string& itemId, int count);
     bool UseItem(const std::string& itemId); // Returns true if successful
     bool HasItem(const std::string& itemId) const;
     int GetItemCount(const std::string& itemId) const;
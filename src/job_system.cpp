@@ -0,0 +1,218 @@
+#include "job_system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "raylib.h"
+
+namespace JobSystem
+{
+    using Job = std::function<void()>;
+
+    // One deque per worker. The owner pushes and pops at the back (newest first, still hot
+    // in cache), thieves take from the front (oldest, usually the biggest chunk of work left).
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    static std::vector<std::thread> gWorkers;
+    static std::vector<std::unique_ptr<WorkerQueue>> gQueues;
+    static std::atomic<int> gQueued{0};          // jobs sitting in any queue
+    static std::atomic<unsigned> gNextQueue{0};  // round robin for jobs from outside the pool
+    static std::mutex gSleepMutex;
+    static std::condition_variable gWake;
+    static bool gStopping = false;
+
+    static thread_local int tWorkerIndex = -1;   // -1 = main thread
+
+    static bool PopOwn(int self, Job& out)
+    {
+        WorkerQueue& q = *gQueues[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.jobs.empty()) return false;
+        out = std::move(q.jobs.back());
+        q.jobs.pop_back();
+        return true;
+    }
+
+    static bool Steal(int self, Job& out)
+    {
+        const int n = (int)gQueues.size();
+        const int start = (self < 0) ? 0 : self + 1;
+        for (int k = 0; k < n; k++)
+        {
+            int victim = (start + k) % n;
+            if (victim == self) continue;
+
+            WorkerQueue& q = *gQueues[victim];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.jobs.empty()) continue;
+            out = std::move(q.jobs.front());
+            q.jobs.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    // Runs one queued job if there is one. Own queue first, then steal.
+    static bool RunOne(int self)
+    {
+        if (gQueued.load() == 0) return false;
+
+        Job job;
+        if ((self >= 0 && PopOwn(self, job)) || Steal(self, job))
+        {
+            gQueued--;
+            job();
+            return true;
+        }
+        return false;
+    }
+
+    static void WorkerLoop(int index)
+    {
+        tWorkerIndex = index;
+        for (;;)
+        {
+            if (RunOne(index)) continue;
+
+            std::unique_lock<std::mutex> lock(gSleepMutex);
+            gWake.wait(lock, [] { return gStopping || gQueued.load() > 0; });
+            if (gStopping && gQueued.load() == 0) return; // stopping and drained
+        }
+    }
+
+    static void Push(Job job)
+    {
+        int n = (int)gQueues.size();
+        int target = (tWorkerIndex >= 0) ? tWorkerIndex : (int)(gNextQueue++ % (unsigned)n);
+        {
+            std::lock_guard<std::mutex> lock(gQueues[target]->mutex);
+            gQueues[target]->jobs.push_back(std::move(job));
+        }
+        gQueued++;
+    }
+
+    static void WakeWorkers(bool all)
+    {
+        // take the sleep lock so a worker between its check and wait() can't miss this
+        { std::lock_guard<std::mutex> lock(gSleepMutex); }
+        if (all) gWake.notify_all();
+        else gWake.notify_one();
+    }
+
+    void Init(int workerCount)
+    {
+        if (!gWorkers.empty()) return;
+
+        if (workerCount <= 0)
+        {
+            int hw = (int)std::thread::hardware_concurrency();
+            workerCount = std::max(1, hw - 1);
+        }
+
+        gStopping = false;
+        gQueues.clear();
+        for (int i = 0; i < workerCount; i++) gQueues.push_back(std::make_unique<WorkerQueue>());
+
+        gWorkers.reserve(workerCount);
+        for (int i = 0; i < workerCount; i++) gWorkers.emplace_back(WorkerLoop, i);
+
+        TraceLog(LOG_INFO, "JOBS: %d worker threads", workerCount);
+    }
+
+    void Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(gSleepMutex);
+            gStopping = true;
+        }
+        gWake.notify_all();
+
+        for (std::thread& t : gWorkers) t.join();
+        gWorkers.clear();
+        gQueues.clear();
+    }
+
+    int WorkerCount()
+    {
+        return (int)gWorkers.size();
+    }
+
+    void Submit(std::function<void()> job)
+    {
+        if (gWorkers.empty()) Init();
+
+        Push(std::move(job));
+        WakeWorkers(false);
+    }
+
+    // One ParallelFor call. Chunks are claimed from `next`, so whoever is free takes the next
+    // one: the caller and the helper jobs. Shared so a helper that only starts after the call
+    // returned finds nothing left and exits without touching the caller's stack.
+    struct ForRange
+    {
+        std::atomic<int> next{0};
+        std::atomic<int> done{0};
+        int chunks = 0;
+        int count = 0;
+        int grain = 1;
+        const std::function<void(int begin, int end)>* fn = nullptr; // only used while chunks are left
+    };
+
+    static void RunChunks(ForRange& r)
+    {
+        for (;;)
+        {
+            int chunk = r.next++;
+            if (chunk >= r.chunks) return;
+
+            int begin = chunk * r.grain;
+            (*r.fn)(begin, std::min(r.count, begin + r.grain));
+            r.done++;
+        }
+    }
+
+    void ParallelFor(int count, int grain, const std::function<void(int begin, int end)>& fn)
+    {
+        if (count <= 0) return;
+        if (gWorkers.empty()) Init();
+        grain = std::max(1, grain);
+
+        // Not worth waking anyone for a single chunk.
+        if (count <= grain)
+        {
+            fn(0, count);
+            return;
+        }
+
+        auto range = std::make_shared<ForRange>();
+        range->chunks = (count + grain - 1) / grain;
+        range->count = count;
+        range->grain = grain;
+        range->fn = &fn;
+
+        // one helper per worker at most, each keeps pulling chunks until the range is empty
+        int helpers = std::min(range->chunks - 1, WorkerCount());
+        for (int i = 0; i < helpers; i++)
+        {
+            Push([range] { RunChunks(*range); });
+        }
+        WakeWorkers(true);
+
+        // The caller works through the range too, then only waits for chunks still running.
+        RunChunks(*range);
+
+        while (range->done.load() < range->chunks)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <functional>
+
+// Small fixed pool of worker threads, one job deque each. An idle worker steals from the
+// others. A thread waiting in ParallelFor helps with that call's own chunks, never with
+// unrelated queued jobs (a long asset decode would stall the frame).
+//
+// Jobs run on a background thread, so they must not touch GL (textures, meshes, shaders)
+// or raylib's audio device. Do the CPU side (file reads, decode, math) in the job and
+// hand the result back to the main thread for anything that talks to the driver.
+
+namespace JobSystem
+{
+    // 0 = one worker per hardware thread minus the main thread (at least 1).
+    // Called lazily by Submit, call it yourself to pick the count.
+    void Init(int workerCount = 0);
+    void Shutdown();
+
+    int WorkerCount();
+
+    void Submit(std::function<void()> job);
+
+    // Splits [0, count) into chunks of `grain` and runs fn(begin, end) on them across the
+    // pool and the calling thread. Returns once every chunk is done.
+    void ParallelFor(int count, int grain, const std::function<void(int begin, int end)>& fn);
+}
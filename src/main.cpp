@@ -21,10 +21,38 @@
 #include "world_update.h"
 #include "game_settings.h"
 #include "saveGame.h"
+#include "replay.h"
+#include "benchmark.h"
+#include "utilities.h"
+#include "asset_loader.h"
+#include "job_system.h"
+#include "dynamic_resolution.h"
+#include <cstring>
+#include <ctime>
 
 //As above, so below.
 
-int main() { 
+int main(int argc, char** argv) { 
+    //command line: --record <file> [--level <index>] | --replay <file> | --benchmark [file.csv] [--drawdist <units>] [--enemies <count>]
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* benchmarkPath = nullptr;
+    int recordLevel = 0;
+    int benchmarkEnemies = 0;
+    for (int i = 1; i < argc; i++){
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayPath = argv[++i];
+        else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) recordLevel = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--enemies") == 0 && i + 1 < argc) benchmarkEnemies = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--drawdist") == 0 && i + 1 < argc) GameSettings::maxDrawDist = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--benchmark") == 0){
+            benchmarkPath = "benchmark.csv";
+            if (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) benchmarkPath = argv[++i];
+        }
+    }
+
+    if (benchmarkPath) GameSettings::useVsync = false; //measure uncapped frame times
+
     if (GameSettings::useVsync) SetConfigFlags(FLAG_VSYNC_HINT); //disable for uncapped frame rate
     
     int screenWidth = GameSettings::squareRes ? 1024 : 1600; //square resolution for youtube shorts...
@@ -32,6 +60,7 @@ int main() {
     //normally start 1600x900 window, toggle fullscreen to fit to monitor.
 
     InitWindow(screenWidth, screenHeight, "Marooned");
+    SeedRandom((unsigned long long)time(nullptr)); //replays reseed with the recorded seed
 
     InitBootScreen(screenWidth, screenHeight);
 
@@ -45,8 +74,9 @@ int main() {
     UnloadImage(icon);
 
     SetExitKey(KEY_NULL); //Escape brings up menu, not quit
-    ResourceManager::Get().LoadAllResources();
-    SoundManager::GetInstance().LoadSounds();
+    ResourceManager::Get().LoadAllResources(); //fonts + shaders now, queues textures and models
+    SoundManager::GetInstance().LoadSounds();  //queues sounds
+    AssetLoader::Flush();                      //decode on worker threads, upload here, draws boot progress
     SoundManager::GetInstance().InitMusic();
     controlPlayer = true; 
 
@@ -71,10 +101,18 @@ int main() {
         MainMenu::InitLevelPreviewFromSavedLevel();
     }
 
+    if (benchmarkPath) Benchmark::Start(benchmarkPath, CameraSystem::Get().Active(), benchmarkEnemies);
+    else if (replayPath) Replay::StartPlayback(replayPath, CameraSystem::Get().Active());
+    else if (recordPath) Replay::StartRecording(recordPath, recordLevel, CameraSystem::Get().Active());
+
 
     //main game loop
     while (!WindowShouldClose()) {
-        float rawDt = GetFrameTime();
+        Replay::BeginFrame(); //capture or feed back this frame's input before anything reads it
+        Benchmark::BeginFrame(CameraSystem::Get().Active());
+        DynamicResolution::BeginFrame();
+        float rawDt = Replay::GetFrameTime();
+        if (Benchmark::IsRunning()) rawDt = Benchmark::StepDt(); //same camera path and frames on every build
         ElapsedTime += rawDt;
 
         float deltaTime = rawDt;
@@ -110,12 +148,15 @@ int main() {
     }
 
 
+    Replay::Stop();
+
     //SaveLastLevel(gCurrentLevelIndex); //last level that was actually loaded.
     save.levelIndex = gCurrentLevelIndex;
     // Cleanup
     ClearLevel();
     ResourceManager::Get().UnloadAll();
     SoundManager::GetInstance().UnloadAll();
+    JobSystem::Shutdown();
     CloseAudioDevice();
     CloseWindow();
 
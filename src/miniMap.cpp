@@ -1,10 +1,13 @@
 #include "miniMap.h"
 #include "raylib.h"
+#include <algorithm>
 #include <cstring>
 #include "world.h"
 #include "dungeonGeneration.h"
 #include "dungeonColors.h"
 #include "pathfinding.h"
+#include "tile_fov.h"
+#include "resourceManager.h"
 #include "iostream"
 
 
@@ -12,6 +15,7 @@ using namespace dungeonColors;
 
 
 static constexpr float REVEAL_FADE_DURATION = 0.2f; 
+static constexpr int   REVEAL_RADIUS = 8; // tiles
 
 MiniMap::MiniMap() {}
 MiniMap::~MiniMap()
@@ -21,6 +25,9 @@ MiniMap::~MiniMap()
 
 void MiniMap::Initialize(int scaleValue)
 {
+    // called again for every dungeon level
+    if (initialized) Unload();
+
     scale = scaleValue;
 
     texWidth  = dungeonWidth  * scale;
@@ -35,6 +42,28 @@ void MiniMap::Initialize(int scaleValue)
     revealTime.assign(dungeonWidth * dungeonHeight, -1.0f); 
     timeSeconds = 0.0f;
 
+    // tile state texture: r = explored, g = visible, b = revealTime
+    tileState.assign(dungeonWidth * dungeonHeight * 4, 0.0f);
+    for (int i = 0; i < dungeonWidth * dungeonHeight; ++i) tileState[i * 4 + 2] = -1.0f;
+    visibleTiles.clear();
+    fovVersion = TileFOV::PlayerVersion() - 1; // first Update always reveals
+
+    Image stateImg{};
+    stateImg.data    = tileState.data();
+    stateImg.width   = dungeonWidth;
+    stateImg.height  = dungeonHeight;
+    stateImg.mipmaps = 1;
+    stateImg.format  = PIXELFORMAT_UNCOMPRESSED_R32G32B32A32;
+    stateTex = LoadTextureFromImage(stateImg);
+    dirtyRowMin = dungeonHeight;
+    dirtyRowMax = -1;
+
+    minimapShader   = R.GetShader("minimapShader");
+    locStateTex     = GetShaderLocation(minimapShader, "stateTex");
+    locMapSize      = GetShaderLocation(minimapShader, "mapSize");
+    locTime         = GetShaderLocation(minimapShader, "timeSeconds");
+    locFadeDuration = GetShaderLocation(minimapShader, "fadeDuration");
+
     // Make on-screen minimap match texture size to avoid scaling seams
     drawSize = (float)texWidth;
 
@@ -47,10 +76,16 @@ void MiniMap::Unload()
     if (wallMask.id != 0)
         UnloadTexture(wallMask);
 
+    if (stateTex.id != 0)
+        UnloadTexture(stateTex);
+
     wallMask = {};
+    stateTex = {};
     explored.clear();
     visible.clear();
     revealTime.clear();
+    tileState.clear();
+    visibleTiles.clear();
     initialized = false;
 }
 
@@ -64,6 +99,30 @@ bool MiniMap::IsExplored(int x, int y) const
     return explored[idx] != 0;
 }
 
+void MiniMap::WriteTileState(int idx)
+{
+    float* s = &tileState[idx * 4];
+    s[0] = explored[idx] ? 1.0f : 0.0f;
+    s[1] = visible[idx]  ? 1.0f : 0.0f;
+    s[2] = revealTime[idx];
+
+    int row = idx / dungeonWidth;
+    dirtyRowMin = std::min(dirtyRowMin, row);
+    dirtyRowMax = std::max(dirtyRowMax, row);
+}
+
+void MiniMap::UploadDirtyRows()
+{
+    if (dirtyRowMax < dirtyRowMin) return;
+
+    int rows = dirtyRowMax - dirtyRowMin + 1;
+    Rectangle rec = { 0.0f, (float)dirtyRowMin, (float)dungeonWidth, (float)rows };
+    UpdateTextureRec(stateTex, rec, &tileState[dirtyRowMin * dungeonWidth * 4]);
+
+    dirtyRowMin = dungeonHeight;
+    dirtyRowMax = -1;
+}
+
 Texture2D MiniMap::GenerateWallMaskTexture()
 {
 
@@ -148,9 +207,8 @@ void MiniMap::RevealDoorsFromPlayer(Vector3 playerPos, const std::vector<Door>&
         playerTileY < 0 || playerTileY >= dungeonHeight)
         return;
 
-    // Use a similar radius to normal reveal
-    const int radius   = 8;
-    const int radiusSq = radius * radius;
+    // Same radius as the normal reveal
+    const int radiusSq = REVEAL_RADIUS * REVEAL_RADIUS;
 
     for (const Door& door : doors)
     {
@@ -172,12 +230,13 @@ void MiniMap::RevealDoorsFromPlayer(Vector3 playerPos, const std::vector<Door>&
         if (explored[idx] != 0)
             continue;
 
-        // If we have line-of-sight *to* the door tile (allowing the last tile to be blocking),
+        // If the door tile is in the player's FOV (blocking tiles are included there),
         // mark it explored so it will always show up on the minimap from now on.
-        if (CanSeeDoorTile(playerTileX, playerTileY, tileX, tileY))
+        if (TileFOV::PlayerCanSee(tileX, tileY))
         {
             explored[idx]   = 1;
             revealTime[idx] = timeSeconds; // nice little fade when it first appears
+            WriteTileState(idx);
         }
     }
 }
@@ -191,48 +250,48 @@ void MiniMap::RevealAroundPlayer(Vector3 playerPos)
         playerTileY < 0 || playerTileY >= dungeonHeight)
         return;
 
-    // Clear per-frame visibility
-    std::fill(visible.begin(), visible.end(), 0);
-
-    const int radius   = 8;
-    const int radiusSq = radius * radius;
-
-    for (int dy = -radius; dy <= radius; ++dy)
-    {
-        for (int dx = -radius; dx <= radius; ++dx)
-        {
-            if (dx*dx + dy*dy > radiusSq) continue;
-
-            int tx = playerTileX + dx;
-            int ty = playerTileY + dy;
-            if (tx < 0 || tx >= dungeonWidth ||
-                ty < 0 || ty >= dungeonHeight)
-                continue;
+    playerU = (playerTileX + 0.5f) / (float)dungeonWidth;
+    playerV = (playerTileY + 0.5f) / (float)dungeonHeight;
 
-            int idx = ty * dungeonWidth + tx;
+    // Shadowcast FOV, only swept again when the player changes tile or a door/box
+    // changes the walkable grid. Nothing to do here otherwise.
+    TileFOV::UpdatePlayer(playerTileX, playerTileY, REVEAL_RADIUS);
+    if (TileFOV::PlayerVersion() == fovVersion) return;
+    fovVersion = TileFOV::PlayerVersion();
 
-            Color c = dungeonPixels[idx];
-            if (c.a == 0) continue; // void
+    // Last sweep's visible tiles become 2 = "was visible". Whatever is still 2 after
+    // this one went out of sight. Only tiles that actually change get written.
+    for (int idx : visibleTiles) visible[idx] = 2;
+    static std::vector<int> previous;
+    previous.clear();
+    previous.swap(visibleTiles);
 
-            // tile-space LOS (your TileLineOfSight using Vector2)
-            Vector2 from = { playerTileX + 0.5f, playerTileY + 0.5f };
-            Vector2 to   = { tx + 0.5f,          ty + 0.5f };
+    for (int idx : TileFOV::PlayerTiles())
+    {
+        // walls, void and closed doors are in the FOV but stay off the map (doors are
+        // handled by RevealDoorsFromPlayer)
+        if (!IsSeeThroughForLOS(idx % dungeonWidth, idx / dungeonWidth)) continue;
 
-            if (TileLineOfSight(from, to))
-            {
-                visible[idx] = 1;
+        bool changed = (visible[idx] == 0);
+        visible[idx] = 1;
+        visibleTiles.push_back(idx);
 
-                if (explored[idx] == 0)
-                {
-                    explored[idx]   = 1;
-                    revealTime[idx] = timeSeconds; // first time we’ve ever seen this tile
-                }
-            }
+        if (explored[idx] == 0)
+        {
+            explored[idx]   = 1;
+            revealTime[idx] = timeSeconds; // first time we’ve ever seen this tile
+            changed = true;
         }
+
+        if (changed) WriteTileState(idx);
     }
 
-    playerU = (playerTileX + 0.5f) / (float)dungeonWidth;
-    playerV = (playerTileY + 0.5f) / (float)dungeonHeight;
+    for (int idx : previous)
+    {
+        if (visible[idx] != 2) continue;
+        visible[idx] = 0;
+        WriteTileState(idx);
+    }
 }
 
 
@@ -247,79 +306,27 @@ void MiniMap::Update(float dt, Vector3 playerPos)
     RevealAroundPlayer(playerPos);
 }
 
-void MiniMap::Draw(int screenX, int screenY, Player& player) const
+void MiniMap::Draw(int screenX, int screenY, Player& player)
 {
     if (!initialized || !isDungeon) return;
 
-    // Background plate (you can tweak alpha if you want a frame)
-    Color bg = { 0, 0, 0, 0 };
-    DrawRectangle(screenX, screenY, (int)drawSize, (int)drawSize, bg);
-
-    float tileW = drawSize / (float)dungeonWidth;
-    float tileH = drawSize / (float)dungeonHeight;
-
-    Color memoryFog = { 0, 0, 0, 80 }; // explored but not currently visible
-
-    for (int y = 0; y < dungeonHeight; ++y)
-    {
-        for (int x = 0; x < dungeonWidth; ++x)
-        {
-            int idx = y * dungeonWidth + x;
-
-            if (explored[idx] == 0)
-            {
-                // Unexplored: draw NOTHING from the map.
-                continue;
-            }
-
-            // --- 1) Draw this tile's part of the minimap texture ---
+    UploadDirtyRows();
 
-            Rectangle src = {
-                (float)(x * scale),
-                (float)(y * scale),
-                (float)scale,
-                (float)scale
-            };
+    // Whole map in one quad. minimap.fs looks up each tile in stateTex and does the
+    // unexplored discard, reveal fade and memory fog per pixel.
+    Vector2 mapSize = { (float)dungeonWidth, (float)dungeonHeight };
+    float fadeDuration = REVEAL_FADE_DURATION;
 
-            Rectangle dst = {
-                screenX + x * tileW,
-                screenY + y * tileH,
-                tileW,
-                tileH
-            };
+    Rectangle src = { 0.0f, 0.0f, (float)texWidth, (float)texHeight };
+    Rectangle dst = { (float)screenX, (float)screenY, drawSize, drawSize };
 
-            Vector2 origin = { 0, 0 };
-            DrawTexturePro(wallMask, src, dst, origin, 0.0f, WHITE);
-
-            // --- 2) Reveal fade-in overlay for newly discovered tiles ---
-
-            float rt = revealTime[idx];
-            if (rt >= 0.0f)
-            {
-                float elapsed = timeSeconds - rt;
-
-                if (elapsed < REVEAL_FADE_DURATION)
-                {
-                    // 0 -> black, 1 -> fully revealed
-                    float t = (elapsed <= 0.0f) ? 0.0f
-                             : (elapsed / REVEAL_FADE_DURATION);
-                    if (t < 1.0f)
-                    {
-                        unsigned char a = (unsigned char)((1.0f - t) * 220.0f);
-                        Color fade = { 0, 0, 0, a };
-                        DrawRectangleRec(dst, fade);
-                    }
-                }
-            }
-
-            // --- 3) Memory fog: explored but not currently in LOS ---
-
-            if (visible[idx] == 0)
-            {
-                DrawRectangleRec(dst, memoryFog);
-            }
-        }
-    }
+    BeginShaderMode(minimapShader);
+        SetShaderValue(minimapShader, locMapSize, &mapSize, SHADER_UNIFORM_VEC2);
+        SetShaderValue(minimapShader, locTime, &timeSeconds, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(minimapShader, locFadeDuration, &fadeDuration, SHADER_UNIFORM_FLOAT);
+        SetShaderValueTexture(minimapShader, locStateTex, stateTex);
+        DrawTexturePro(wallMask, src, dst, Vector2{ 0, 0 }, 0.0f, WHITE);
+    EndShaderMode();
 
     DrawPlayer(player, screenX, screenY);
 
@@ -419,9 +426,8 @@ void MiniMap::DrawEnemies(const std::vector<Character*>& enemies,
         if (explored.empty() || explored[idx] == 0)
             continue;
 
-        // only show if in LOS as well
-        Vector3 eye = pos; eye.y += 40.0f; 
-        if (!HasWorldLineOfSight(player.position, pos)) continue;
+        // only show if in the player's FOV as well
+        if (!TileFOV::PlayerCanSee(tileX, tileY)) continue;
 
         // Convert tile coord → minimap pixel center
         float u = (tileX + 0.5f) / (float)dungeonWidth;
@@ -29,7 +29,7 @@ public:
     void DrawDoors(const std::vector<Door>& doors, int screenX, int screenY) const;
     void DrawMiniMap(); //call the draw functions
     // screenX/screenY = top-left position on screen where minimap is drawn
-    void Draw(int screenX, int screenY, Player& player) const;
+    void Draw(int screenX, int screenY, Player& player);
 
     void RevealDoorsFromPlayer(Vector3 playerPos, const std::vector<Door>& doors);
     void RevealAroundPlayer(Vector3 playerPos);
@@ -61,11 +61,30 @@ private:
 
     float timeSeconds = 0.0f; // minimap-local clock
 
+    // GPU copy of explored / visible / revealTime, one RGBA32F texel per tile.
+    // Only rows touched since the last upload are sent (dirtyRowMin..dirtyRowMax).
+    std::vector<float> tileState;
+    Texture2D stateTex = {};
+    int dirtyRowMin = 0;
+    int dirtyRowMax = -1;
+
+    // tiles set visible by the last RevealAroundPlayer, so the next one can clear just those
+    std::vector<int> visibleTiles;
+    unsigned int fovVersion = 0; // TileFOV::PlayerVersion() those tiles came from
+
+    Shader minimapShader = {};
+    int locStateTex     = -1;
+    int locMapSize      = -1;
+    int locTime         = -1;
+    int locFadeDuration = -1;
+
     // Last known player minimap UV (0..1 in each axis); used for drawing player dot
     float playerU = 0.5f;
     float playerV = 0.5f;
 
     Texture2D GenerateWallMaskTexture();
+    void WriteTileState(int idx);
+    void UploadDirtyRows();
 
 
 };
@@ -11,6 +11,7 @@
 #include <cmath>
 #include <limits>
 #include "lighting.h"
+#include "tile_fov.h"
 
 using namespace dungeonColors;
 std::vector<std::vector<bool>> walkable; //grid of bools that mark walkabe/unwalkable tiles. 
@@ -92,6 +93,7 @@ void ConvertImageToWalkableGrid(const Image& dungeonMap) {
     //set initial walkable state of tiles.
     walkable.clear();
     walkableBat.clear();
+    TileFOV::Clear();
     walkable.resize(dungeonMap.width, std::vector<bool>(dungeonMap.height, false));
     walkableBat.resize(dungeonMap.width, std::vector<bool>(dungeonMap.height, false));
     for (int x = 0; x < dungeonMap.width; ++x) {
@@ -355,6 +357,8 @@ void SetTileWalkable(int x, int y, bool batAlso)
 
     if (batAlso)
         walkableBat[x][y] = true;
+
+    TileFOV::Invalidate();
 }
 
 void SetTileUnwalkable(int x, int y, bool batAlso)
@@ -365,6 +369,8 @@ void SetTileUnwalkable(int x, int y, bool batAlso)
 
     if (batAlso)
         walkableBat[x][y] = false;
+
+    TileFOV::Invalidate();
 }
 
 
@@ -455,9 +461,9 @@ static Vector2 GetRetreatTileAwayFrom(
         // Base direction = away from player
         float baseAngle = atan2f(start.y - playerTile.y, start.x - playerTile.x);
         // Add a little randomness so it isn't perfectly straight
-        float angle = baseAngle + (GetRandomValue(-45, 45) * DEG2RAD);
+        float angle = baseAngle + (RandomInt(-45, 45) * DEG2RAD);
 
-        float dist = targetDistance + GetRandomValue((int)-tolerance, (int)tolerance);
+        float dist = targetDistance + RandomInt((int)-tolerance, (int)tolerance);
 
         int rx = (int)(start.x + cosf(angle) * dist);
         int ry = (int)(start.y + sinf(angle) * dist);
@@ -481,8 +487,8 @@ static Vector2 GetRetreatTile(
 {
     for (int i = 0; i < maxAttempts; ++i)
     {
-        float angle = GetRandomValue(0, 359) * DEG2RAD;
-        float dist  = targetDistance + GetRandomValue((int)-tolerance, (int)tolerance);
+        float angle = RandomInt(0, 359) * DEG2RAD;
+        float dist  = targetDistance + RandomInt((int)-tolerance, (int)tolerance);
 
         int rx = (int)(start.x + cosf(angle) * dist);
         int ry = (int)(start.y + sinf(angle) * dist);
@@ -561,8 +567,8 @@ bool TrySetRetreatPath(
 Vector2 GetRandomReachableTile(const Vector2& start, const Character* self, int maxAttempts) {
     int patrolRadius = 3;
     for (int i = 0; i < maxAttempts; ++i) {
-        int rx = (int)start.x + GetRandomValue(-patrolRadius, patrolRadius);
-        int ry = (int)start.y + GetRandomValue(-patrolRadius, patrolRadius);
+        int rx = (int)start.x + RandomInt(-patrolRadius, patrolRadius);
+        int ry = (int)start.y + RandomInt(-patrolRadius, patrolRadius);
 
         if (rx < 0 || ry < 0 || rx >= dungeonWidth || ry >= dungeonHeight)
             continue;
@@ -1042,7 +1048,7 @@ Vector3 FleeXZ(const Vector3& pos, const Vector3& threat, float maxSpeed) {
 // Keep a wanderAngle per-raptor; call each frame.
 Vector3 WanderXZ(float& wanderAngle, float wanderTurnRate, float wanderSpeed, float dt) {
     // nudge angle
-    wanderAngle += ((float)GetRandomValue(-1000,1000) / 1000.0f) * wanderTurnRate * dt;
+    wanderAngle += ((float)RandomInt(-1000,1000) / 1000.0f) * wanderTurnRate * dt;
     float s = sinf(wanderAngle), c = cosf(wanderAngle);
     return { s * wanderSpeed, 0.0f, c * wanderSpeed };
 }
@@ -1066,7 +1072,7 @@ bool StopAtWaterEdge(const Vector3& pos,
                       pos.z + dir.z / speed * look };
 
     // Sample terrain height at the ahead point
-    float hAhead = GetHeightAtWorldPosition(ahead, heightmap, terrainScale);
+    float hAhead = GetHeightAtWorldPosition(ahead);
 
     if (hAhead <= waterLevel) {
         // hard stop at the shoreline
@@ -1078,7 +1084,7 @@ bool StopAtWaterEdge(const Vector3& pos,
 
 bool IsWaterAtXZ(float x, float z, float waterLevel) {
     Vector3 waterPos = {x, waterLevel, z};
-    return GetHeightAtWorldPosition(waterPos, heightmap, terrainScale) <= waterLevel;
+    return GetHeightAtWorldPosition(waterPos) <= waterLevel;
 }
 
 
@@ -18,6 +18,8 @@
 #include "utilities.h"
 #include "debug_console.h"
 #include "shaderSetup.h"
+#include "replay.h"
+#include "heightfield.h"
 
 Weapon weapon;
 MeleeWeapon meleeWeapon;
@@ -114,7 +116,7 @@ void UpdateBoxInteraction(Player& player, float deltaTime)
     player.showWeapon = player.isCarrying ? false : true;
 
     // 1) Read input ONCE
-    const bool ePressed = IsKeyPressed(KEY_E);
+    const bool ePressed = Replay::IsKeyPressed(KEY_E);
 
     // Clear intents each frame (so they're edge-triggered)
     player.interactPressed = false;
@@ -136,7 +138,7 @@ void UpdateBoxInteraction(Player& player, float deltaTime)
         Vector3 dropTileCenter = GetDungeonWorldPos(tilePos.x, tilePos.y, tileSize, floorHeight);
 
         player.carriedBox->Update(
-            GetFrameTime(),
+            Replay::GetFrameTime(),
             player.position,
             player.forward,      // however you store it
             player.rotation,
@@ -220,7 +222,6 @@ void UpdatePlayerGrapple(Player& player, float dt)
     {
         player.state = PlayerState::Normal;
         player.velocity = {0,0,0};
-        player.grappleBulletId = -1;
         return;
     }
 
@@ -291,12 +292,12 @@ bool ShouldRun(const Vector2& wish, bool canRun)
     if (!canRun) return false;
 
     // Keyboard sprint always wins
-    if (IsKeyDown(KEY_LEFT_SHIFT)){
+    if (Replay::IsKeyDown(KEY_LEFT_SHIFT)){
         return true;
     }
 
 
-    if (IsGamepadAvailable(0)){
+    if (Replay::IsGamepadAvailable(0)){
         // Analog sprint: full stick push
         const float RUN_THRESHOLD = 0.85f;
 
@@ -446,16 +447,16 @@ void HandlePlayerMovement(float deltaTime){
 
     // --- build desired direction in local space 
     Vector2 wish = {0,0};
-    if (IsKeyDown(KEY_W)) wish.y += 1;
-    if (IsKeyDown(KEY_S)) wish.y -= 1;
-    if (IsKeyDown(KEY_A)) wish.x += 1;
-    if (IsKeyDown(KEY_D)) wish.x -= 1;
+    if (Replay::IsKeyDown(KEY_W)) wish.y += 1;
+    if (Replay::IsKeyDown(KEY_S)) wish.y -= 1;
+    if (Replay::IsKeyDown(KEY_A)) wish.x += 1;
+    if (Replay::IsKeyDown(KEY_D)) wish.x -= 1;
 
     // --- gamepad ---
-    if (IsGamepadAvailable(0))
+    if (Replay::IsGamepadAvailable(0))
     {
-        float lx = GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_X);
-        float ly = GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_Y);
+        float lx = Replay::GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_X);
+        float ly = Replay::GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_Y);
 
         const float DEADZONE = 0.2f;
 
@@ -592,7 +593,7 @@ void HandlePlayerMovement(float deltaTime){
 
     } 
 
-    HandleJumpButton(GetTime());
+    HandleJumpButton(Replay::GetTime());
     
     TryQueuedJump();
     
@@ -635,14 +636,14 @@ void HandleKeyboardInput(Camera& camera) {
     player.runSpeed = player.haste ? 1400.0f : 850.0f;
     player.walkSpeed = player.haste ? 1000.0f : 500.0f;
 
-    if (IsKeyPressed(KEY_ENTER) && player.currentPowerUp != PowerUpType::None && !DebugConsole::IsOpen()){
+    if (Replay::IsKeyPressed(KEY_ENTER) && player.currentPowerUp != PowerUpType::None && !DebugConsole::IsOpen()){
         if (player.currentPowerUp != PowerUpType::None){
             ActivatePowerUp();
         }
     }
 
     // Right mouse state //blocking
-    const bool rmb = IsMouseButtonDown(MOUSE_RIGHT_BUTTON) || (IsGamepadAvailable(0) && GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_TRIGGER) > 0.1f);
+    const bool rmb = Replay::IsMouseButtonDown(MOUSE_RIGHT_BUTTON) || (Replay::IsGamepadAvailable(0) && Replay::GetGamepadAxisMovement(0, GAMEPAD_AXIS_LEFT_TRIGGER) > 0.1f);
 
     // Desired block state this frame
     const bool wantBlock = rmb && (player.activeWeapon == WeaponType::Sword);
@@ -669,17 +670,17 @@ void HandleKeyboardInput(Camera& camera) {
         crossbow.FireHarpoon(camera);
     }
 
-    if (IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_TRIGGER_1)){
+    if (Replay::IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_TRIGGER_1)){
         player.activeWeapon = NextOwnedWeapon(player.activeWeapon);
         WeaponDip();
     }
 
-    if (IsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_TRIGGER_1)){
+    if (Replay::IsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_TRIGGER_1)){
         player.activeWeapon = PrevOwnedWeapon(player.activeWeapon);
         WeaponDip();
     }
 
-    if (IsKeyPressed(KEY_Q) && !DebugConsole::IsOpen())
+    if (Replay::IsKeyPressed(KEY_Q) && !DebugConsole::IsOpen())
     {
         meleeWeapon.model.materials[3].maps[MATERIAL_MAP_DIFFUSE].texture = R.GetTexture("swordClean"); //wipe off the blood on sword
         // Swap weapons
@@ -690,7 +691,7 @@ void HandleKeyboardInput(Camera& camera) {
 
     }
 
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || (IsGamepadAvailable(0) && GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_TRIGGER) > 0.1f)) {
+    if (Replay::IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || (Replay::IsGamepadAvailable(0) && Replay::GetGamepadAxisMovement(0, GAMEPAD_AXIS_RIGHT_TRIGGER) > 0.1f)) {
         if (player.state == PlayerState::Frozen) return; //dont attack while frozen.
         if (player.isCarrying) return; // dont attack when carrying box
       
@@ -718,7 +719,7 @@ void HandleKeyboardInput(Camera& camera) {
     // --- Boarding Check ---
     if (!player.onBoard) { //board the boat, lock player position to boat position, keep free look
         float distanceToBoat = Vector3Distance(player.position, player_boat.position);
-        if (distanceToBoat < 300.0f && IsKeyPressed(KEY_E)) {
+        if (distanceToBoat < 300.0f && Replay::IsKeyPressed(KEY_E)) {
             player.onBoard = true;
             player_boat.playerOnBoard = true;
             player.position = Vector3Add(player_boat.position, {0, 200.0f, 0}); // sit up a bit
@@ -727,7 +728,7 @@ void HandleKeyboardInput(Camera& camera) {
     }
 
     // --- Exit Boat ---
-    if (player.onBoard && IsKeyPressed(KEY_E)) {
+    if (player.onBoard && Replay::IsKeyPressed(KEY_E)) {
         player.onBoard = false;
         player_boat.playerOnBoard = false;
         player.position = Vector3Add(player_boat.position, {2.0f, 200.0f, 0.0f}); // step off
@@ -738,7 +739,7 @@ void HandleKeyboardInput(Camera& camera) {
         player.position = Vector3Add(player_boat.position, {0, 200.0f, 0});
     }
 
-    if (IsKeyPressed(KEY_ONE) && player.activeWeapon != WeaponType::Sword && !DebugConsole::IsOpen()){
+    if (Replay::IsKeyPressed(KEY_ONE) && player.activeWeapon != WeaponType::Sword && !DebugConsole::IsOpen()){
         meleeWeapon.model.materials[3].maps[MATERIAL_MAP_DIFFUSE].texture = R.GetTexture("swordClean");
         player.previousWeapon = player.activeWeapon;
         player.activeWeapon = WeaponType::Sword;
@@ -747,28 +748,28 @@ void HandleKeyboardInput(Camera& camera) {
         
     }
 
-    if (IsKeyPressed(KEY_TWO) && hasCrossbow && player.activeWeapon != WeaponType::Crossbow && !DebugConsole::IsOpen()){
+    if (Replay::IsKeyPressed(KEY_TWO) && hasCrossbow && player.activeWeapon != WeaponType::Crossbow && !DebugConsole::IsOpen()){
         player.previousWeapon = player.activeWeapon;
         player.activeWeapon = WeaponType::Crossbow;
         crossbow.reloadDip = 40;
         CancelMeleeAttacksForWeaponSwitch(player.previousWeapon);
     }
 
-    if (IsKeyPressed(KEY_THREE) && hasBlunderbuss && player.activeWeapon != WeaponType::Blunderbuss && !DebugConsole::IsOpen()){
+    if (Replay::IsKeyPressed(KEY_THREE) && hasBlunderbuss && player.activeWeapon != WeaponType::Blunderbuss && !DebugConsole::IsOpen()){
         player.previousWeapon = player.activeWeapon;
         player.activeWeapon = WeaponType::Blunderbuss;
         weapon.reloadDip = 40;
         CancelMeleeAttacksForWeaponSwitch(player.previousWeapon);
     }
 
-    if (IsKeyPressed(KEY_FOUR) && hasStaff && player.activeWeapon != WeaponType::MagicStaff && !DebugConsole::IsOpen()){
+    if (Replay::IsKeyPressed(KEY_FOUR) && hasStaff && player.activeWeapon != WeaponType::MagicStaff && !DebugConsole::IsOpen()){
         player.previousWeapon = player.activeWeapon;
         player.activeWeapon = WeaponType::MagicStaff;
         magicStaff.equipDip = 50;
         CancelMeleeAttacksForWeaponSwitch(player.previousWeapon);
     }
 
-    if (IsKeyPressed(KEY_F) || IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT)){
+    if (Replay::IsKeyPressed(KEY_F) || Replay::IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT)){
         //use health potion
         if (player.inventory.HasItem("HealthPotion") && !player.dying){ //don't use pot when dying
             
@@ -780,7 +781,7 @@ void HandleKeyboardInput(Camera& camera) {
         }
     }
 
-    if (IsKeyPressed(KEY_G) || IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_UP)){
+    if (Replay::IsKeyPressed(KEY_G) || Replay::IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_UP)){
         if (player.inventory.HasItem("ManaPotion")){
             if (player.currentMana < player.maxMana){
                 player.currentMana = player.maxMana;
@@ -791,7 +792,7 @@ void HandleKeyboardInput(Camera& camera) {
     }
 
     //T or Up on the d pad to switch magic type
-    if (IsKeyPressed(KEY_T) || IsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_FACE_UP)){
+    if (Replay::IsKeyPressed(KEY_T) || Replay::IsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_FACE_UP)){
        if (magicStaff.magicType == MagicType::Fireball){
             magicStaff.magicType = MagicType::Iceball;
        }else{
@@ -853,7 +854,7 @@ void PlaySwimOnce()
     }
 
     int idx;
-    do { idx = GetRandomValue(0, (int)KEYS.size() - 1); }
+    do { idx = RandomInt(0, (int)KEYS.size() - 1); }
     while (idx == lastIndex && KEYS.size() > 1);
     lastIndex = idx;
 
@@ -872,7 +873,7 @@ void Player::PlayFootstepSound() {
 
     int index;
     do {
-        index = GetRandomValue(0, footstepKeys.size() - 1);
+        index = RandomInt(0, footstepKeys.size() - 1);
     } while (index == lastIndex && footstepKeys.size() > 1);  // avoid repeat if more than 1
 
     lastIndex = index;
@@ -1180,14 +1181,14 @@ void OnGroundCheck(bool groundedNow, float timeNow) {
 
 void HandleJumpButton(float timeNow){
     OnGroundCheck(player.grounded, timeNow);
-    if (IsKeyPressed(KEY_SPACE) || (IsGamepadAvailable(0) && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))){
+    if (Replay::IsKeyPressed(KEY_SPACE) || (Replay::IsGamepadAvailable(0) && Replay::IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))){
         player.lastJumpPressedTime = timeNow;
     } 
     
 }
 
 void TryQueuedJump(){
-    float now = GetTime();
+    float now = Replay::GetTime();
     bool canCoyote = (now - player.lastGroundedTime) <= player.COYOTE_TIME;
     bool buffered  = (now - player.lastJumpPressedTime) <= player.JUMP_BUFFER;
 
@@ -1382,7 +1383,7 @@ void UpdatePlayer(Player& player, float deltaTime, Camera& camera) {
 
         if (!player.overVoid && !player.overLava){ //dont animate death cam if you fall into a pit. it would warp you back up. same for lava
             CameraSystem::Get().SnapAllToPlayer();
-            CameraSystem::Get().StartDeathCam(100.0f, GetHeightAtWorldPosition(player.position, heightmap, terrainScale));
+            CameraSystem::Get().StartDeathCam(100.0f, GetHeightAtWorldPosition(player.position));
         }
 
         //fall to the ground dead first, then fade out.
@@ -1472,7 +1473,7 @@ void UpdatePlayer(Player& player, float deltaTime, Camera& camera) {
     player.centerGroundY = 0.0f;
     if (!isDungeon)
     {
-        player.centerGroundY = GetHeightAtWorldPosition(player.position, heightmap, terrainScale);
+        player.centerGroundY = GetHeightAtWorldPosition(player.position);
     }
     else
     {
@@ -1485,13 +1486,22 @@ void UpdatePlayer(Player& player, float deltaTime, Camera& camera) {
         if (IsVoid(cx, cy)) player.centerGroundY -= VOID_DROP;
     }
 
-    for (Vector3 p : samples)
+    // island probes in one batch
+    float terrainY[9] = {};
+    if (!isDungeon)
+    {
+        if (gHeightField.IsValid()) gHeightField.SampleHeights(samples, terrainY, 9);
+        else for (int i = 0; i < 9; i++) terrainY[i] = GetHeightAtWorldPosition(samples[i]);
+    }
+
+    for (int si = 0; si < 9; si++)
     {
+        Vector3 p = samples[si];
         float gy = 0.0f;
 
         if (!isDungeon)
         {
-            gy = GetHeightAtWorldPosition(p, heightmap, terrainScale);
+            gy = terrainY[si];
         }
         else
         {
@@ -1712,7 +1722,7 @@ void DrawPlayerDebug(const Player& player) {
 
             float gy = isDungeon
                 ? player.centerGroundY
-                : GetHeightAtWorldPosition(p, heightmap, terrainScale);
+                : GetHeightAtWorldPosition(p);
 
             Vector3 top = { p.x, p.y + 60.0f, p.z };
             Vector3 hit = { p.x, gy,          p.z };
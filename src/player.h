@@ -68,7 +68,6 @@ struct Player {
     Vector3 grappleTarget = {0,0,0};   // where you're being pulled to
     float   grappleSpeed = 3000.0f;
     float   grappleStopDist = 0.0f;
-    int     grappleBulletId = -1;      // optional: link to the harpoon bullet
     float harpoonLifeTimer = 0.0;
 
     float freezeTimer = 0.0f;
@@ -344,7 +344,7 @@ void PortalSystem::Update(Vector3& playerPos, float playerRadius, float dt)
             // Move player AFTER fade out
             playerPos = Vector3Add(gPendingDestPos, Vector3{ 0.0f, 20.0f, 0.0f });
             
-            std::string pSound = (GetRandomValue(0, 1) > 0) ? "portal" : "portal2";
+            std::string pSound = (RandomInt(0, 1) > 0) ? "portal" : "portal2";
             SoundManager::GetInstance().Play(pSound);
 
             // Start fade in elsewhere
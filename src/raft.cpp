@@ -2,12 +2,13 @@
 #include "resourceManager.h"
 #include "rlgl.h"
 #include "cmath"
+#include "replay.h"
 
 void Raft::Update(float dt)
 {
     (void)dt;
     // Optional future bobbing
-    position.y += sin(GetTime()) * 0.1f;
+    position.y += sin(Replay::GetTime()) * 0.1f;
 }
 
 void Raft::Draw()
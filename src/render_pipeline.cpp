@@ -23,6 +23,8 @@
 #include "debug_console.h"
 #include "grass.h"
 #include "dungeon_props.h"
+#include "dynamic_resolution.h"
+#include "benchmark.h"
 
 
 static void EnsureRenderTargetsMatchWindow(RenderTexture2D& rt)
@@ -38,9 +40,30 @@ static void EnsureRenderTargetsMatchWindow(RenderTexture2D& rt)
 
     if (rt.id != 0) UnloadRenderTexture(rt);
     rt = LoadRenderTexture(w, h);
+    SetTextureFilter(rt.texture, TEXTURE_FILTER_BILINEAR); //same as LoadAllResources, the upscale needs it
+    SetTextureWrap(rt.texture, TEXTURE_WRAP_CLAMP);
 
 }
 
+// Scene texture to the backbuffer through bloom.fs. Only the lower left renderW x renderH
+// of the texture holds the scene when dynamic resolution has scaled it down.
+static void DrawSceneTexture(const RenderTexture2D& rt, int renderW, int renderH)
+{
+    float scaleX = (float)renderW / (float)rt.texture.width;
+    float scaleY = (float)renderH / (float)rt.texture.height;
+    bool upscaled = renderW < rt.texture.width || renderH < rt.texture.height;
+    ShaderSetup::SetBloomSceneRegion(ShaderSetup::gBloom, Vector2{ scaleX, scaleY },
+                                     upscaled ? GameSettings::dynResSharpen : 0.0f);
+
+    Rectangle src = { 0, 0,
+                    (float)renderW,
+                    -(float)renderH }; // flip Y!
+    Rectangle dst = { 0, 0,
+                    (float)GetScreenWidth(),
+                    (float)GetScreenHeight() };
+    DrawTexturePro(rt.texture, src, dst, {0,0}, 0.0f, WHITE);
+}
+
 
 
 
@@ -52,6 +75,9 @@ void RenderMenuFrame(Camera3D& camera) {
     EnsureRenderTargetsMatchWindow(sceneTexture);
     //EnsureRenderTargetsMatchWindow(postTexture);
 
+    //menu is always native, drop the scale and averages so gameplay starts fresh at 100%
+    DynamicResolution::Update(false);
+
     // --- 3D scene to sceneTexture ---
     BeginTextureMode(R.GetRenderTexture("sceneTexture")); //MENU FRAME
         ClearBackground(SKYBLUE);
@@ -104,13 +130,7 @@ void RenderMenuFrame(Camera3D& camera) {
         ClearBackground(WHITE);
         BeginShaderMode(R.GetShader("bloomShader"));
             auto& post = R.GetRenderTexture("sceneTexture");
-            Rectangle src = { 0, 0,
-                            (float)post.texture.width,
-                            -(float)post.texture.height }; // flip Y!
-            Rectangle dst = { 0, 0,
-                            (float)GetScreenWidth(),
-                            (float)GetScreenHeight() };
-            DrawTexturePro(post.texture, src, dst, {0,0}, 0.0f, WHITE);
+            DrawSceneTexture(post, post.texture.width, post.texture.height); //menu always native
         EndShaderMode();
 
         if (gFadePhase != FadePhase::FadingOut) MainMenu::Draw(gMenu, levelIndex, levels.data(), (int)levels.size());
@@ -127,8 +147,15 @@ void RenderFrame(Camera3D& camera, Player& player, float dt) {
     RenderTexture2D& sceneTexture = R.GetRenderTexture("sceneTexture");
     (void)dt; //we may need this later
     EnsureRenderTargetsMatchWindow(sceneTexture);
+
+    //benchmark runs stay at native so builds compare like for like
+    DynamicResolution::Update(GameSettings::dynamicResolution && !Benchmark::IsRunning());
+    int renderW, renderH;
+    DynamicResolution::ScaledSize(sceneTexture.texture.width, sceneTexture.texture.height, renderW, renderH);
+
     // --- 3D scene to sceneTexture ---
     BeginTextureMode(R.GetRenderTexture("sceneTexture"));
+        rlViewport(0, 0, renderW, renderH); //same aspect, fewer pixels. EndTextureMode resets it.
         ClearBackground(SKYBLUE);
         float farClip = isDungeon ? 50000.0f : 100000.0f;
         float nearclip = 30.0f;
@@ -194,7 +221,7 @@ void RenderFrame(Camera3D& camera, Player& player, float dt) {
         }
 
         DrawPlayer(player, camera);
-        DrawEnemyShadows();
+        DrawBlobShadows();
         DrawBullets(camera);
         DrawCollectableWeapons();
         DrawPowerUps(camera);
@@ -220,15 +247,7 @@ void RenderFrame(Camera3D& camera, Player& player, float dt) {
         ClearBackground(WHITE);
         BeginShaderMode(R.GetShader("bloomShader"));
             auto& postRT = R.GetRenderTexture("sceneTexture");
-            Rectangle src = { 0, 0,
-                            (float)postRT.texture.width,
-                            -(float)postRT.texture.height }; // flip Y!
-            Rectangle dst = { 0, 0,
-                            (float)GetScreenWidth(),
-                            (float)GetScreenHeight() };
-
-
-            DrawTexturePro(postRT.texture, src, dst, {0,0}, 0.0f, WHITE);
+            DrawSceneTexture(postRT, renderW, renderH); //upscaled when dynamic resolution is below 100%
 
 
             rlDisableDepthTest();
@@ -276,5 +295,6 @@ void RenderFrame(Camera3D& camera, Player& player, float dt) {
             //DrawText(TextFormat("%d FPS", GetFPS()), 350, 10, 20, WHITE);
             
         } 
+        DynamicResolution::EndCpuWork(); //everything after this is swap / vsync wait
     EndDrawing();
 }
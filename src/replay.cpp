@@ -0,0 +1,550 @@
+#include "replay.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <vector>
+#include "world.h"
+#include "utilities.h"
+#include "game_settings.h"
+
+namespace Replay
+{
+    enum class Mode
+    {
+        Off,
+        Recording,
+        Playback
+    };
+
+    static constexpr uint32_t REPLAY_MAGIC = 0x4C50524D; // "MRPL"
+    static constexpr uint32_t REPLAY_VERSION = 1;
+
+    static constexpr int MAX_KEY = KEY_KB_MENU;
+    static constexpr int MOUSE_BUTTON_COUNT = 7;
+    static constexpr int GAMEPAD_AXIS_COUNT = 6;
+    static constexpr int GAMEPAD_BUTTON_COUNT = 18;
+
+    // Everything needed to put the game in the same state the recording started from.
+    struct Header
+    {
+        uint32_t magic = REPLAY_MAGIC;
+        uint32_t version = REPLAY_VERSION;
+        uint64_t seed = 0;
+        double startTime = 0.0;
+        int32_t levelIndex = 0;
+        uint8_t firstLevel = 0;
+
+        int32_t healthPotions = 0;
+        int32_t manaPotions = 0;
+        int32_t gold = 0;
+        int32_t currentPowerUp = 0;
+        uint8_t hasCrossbow = 0;
+        uint8_t hasBlunderbuss = 0;
+        uint8_t hasStaff = 0;
+        uint8_t hasHarpoon = 0;
+        uint8_t hasDoubleShot = 0;
+        uint8_t unlockEntrances = 0;
+
+        float mouseSensitivity = 0.0f;
+    };
+
+    // One main loop iteration of input. Keys are stored as lists of codes on disk,
+    // so a typical frame is ~20 bytes.
+    struct FrameInput
+    {
+        float dt = 0.0f;
+        Vector2 mouseDelta = { 0.0f, 0.0f };
+        uint8_t mouseDown = 0;
+        uint8_t mousePressed = 0;
+        std::bitset<MAX_KEY + 1> keyDown;
+        std::bitset<MAX_KEY + 1> keyPressed;
+        std::vector<int> chars;
+
+        bool gamepad = false;
+        float axes[GAMEPAD_AXIS_COUNT] = {};
+        uint32_t padPressed = 0;
+    };
+
+    static Mode gMode = Mode::Off;
+    static std::string gPath;
+    static std::ofstream gOut;
+    static std::ifstream gIn;
+
+    static FrameInput gFrame;
+    static size_t gCharCursor = 0;
+    static double gClock = 0.0;
+    static int gFrameCount = 0;
+
+    static std::vector<float> gFrameTimesMs; // playback only
+
+    // ------------------------------------------------------------
+    // Serialization
+    // ------------------------------------------------------------
+
+    template <typename T>
+    static void WritePod(std::ofstream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static bool ReadPod(std::ifstream& in, T& value)
+    {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return static_cast<bool>(in);
+    }
+
+    static void WriteHeader(std::ofstream& out, const Header& h)
+    {
+        WritePod(out, h.magic);
+        WritePod(out, h.version);
+        WritePod(out, h.seed);
+        WritePod(out, h.startTime);
+        WritePod(out, h.levelIndex);
+        WritePod(out, h.firstLevel);
+        WritePod(out, h.healthPotions);
+        WritePod(out, h.manaPotions);
+        WritePod(out, h.gold);
+        WritePod(out, h.currentPowerUp);
+        WritePod(out, h.hasCrossbow);
+        WritePod(out, h.hasBlunderbuss);
+        WritePod(out, h.hasStaff);
+        WritePod(out, h.hasHarpoon);
+        WritePod(out, h.hasDoubleShot);
+        WritePod(out, h.unlockEntrances);
+        WritePod(out, h.mouseSensitivity);
+    }
+
+    static bool ReadHeader(std::ifstream& in, Header& h)
+    {
+        return ReadPod(in, h.magic) &&
+               ReadPod(in, h.version) &&
+               ReadPod(in, h.seed) &&
+               ReadPod(in, h.startTime) &&
+               ReadPod(in, h.levelIndex) &&
+               ReadPod(in, h.firstLevel) &&
+               ReadPod(in, h.healthPotions) &&
+               ReadPod(in, h.manaPotions) &&
+               ReadPod(in, h.gold) &&
+               ReadPod(in, h.currentPowerUp) &&
+               ReadPod(in, h.hasCrossbow) &&
+               ReadPod(in, h.hasBlunderbuss) &&
+               ReadPod(in, h.hasStaff) &&
+               ReadPod(in, h.hasHarpoon) &&
+               ReadPod(in, h.hasDoubleShot) &&
+               ReadPod(in, h.unlockEntrances) &&
+               ReadPod(in, h.mouseSensitivity);
+    }
+
+    static void WriteKeyList(std::ofstream& out, const std::bitset<MAX_KEY + 1>& keys)
+    {
+        uint8_t count = (uint8_t)std::min<size_t>(keys.count(), 255);
+        WritePod(out, count);
+
+        for (int key = 0; key <= MAX_KEY && count > 0; key++)
+        {
+            if (!keys.test(key)) continue;
+
+            uint16_t code = (uint16_t)key;
+            WritePod(out, code);
+            count--;
+        }
+    }
+
+    static bool ReadKeyList(std::ifstream& in, std::bitset<MAX_KEY + 1>& keys)
+    {
+        keys.reset();
+
+        uint8_t count = 0;
+        if (!ReadPod(in, count)) return false;
+
+        for (int i = 0; i < count; i++)
+        {
+            uint16_t code = 0;
+            if (!ReadPod(in, code)) return false;
+            if (code <= MAX_KEY) keys.set(code);
+        }
+
+        return true;
+    }
+
+    static void WriteFrame(std::ofstream& out, const FrameInput& f)
+    {
+        WritePod(out, f.dt);
+        WritePod(out, f.mouseDelta.x);
+        WritePod(out, f.mouseDelta.y);
+        WritePod(out, f.mouseDown);
+        WritePod(out, f.mousePressed);
+        WriteKeyList(out, f.keyDown);
+        WriteKeyList(out, f.keyPressed);
+
+        uint8_t charCount = (uint8_t)std::min<size_t>(f.chars.size(), 255);
+        WritePod(out, charCount);
+        for (int i = 0; i < charCount; i++)
+        {
+            int32_t c = f.chars[i];
+            WritePod(out, c);
+        }
+
+        uint8_t gamepad = f.gamepad ? 1 : 0;
+        WritePod(out, gamepad);
+        if (f.gamepad)
+        {
+            for (int i = 0; i < GAMEPAD_AXIS_COUNT; i++) WritePod(out, f.axes[i]);
+            WritePod(out, f.padPressed);
+        }
+    }
+
+    static bool ReadFrame(std::ifstream& in, FrameInput& f)
+    {
+        f = FrameInput{};
+
+        if (!ReadPod(in, f.dt)) return false;
+        if (!ReadPod(in, f.mouseDelta.x) || !ReadPod(in, f.mouseDelta.y)) return false;
+        if (!ReadPod(in, f.mouseDown) || !ReadPod(in, f.mousePressed)) return false;
+        if (!ReadKeyList(in, f.keyDown) || !ReadKeyList(in, f.keyPressed)) return false;
+
+        uint8_t charCount = 0;
+        if (!ReadPod(in, charCount)) return false;
+        for (int i = 0; i < charCount; i++)
+        {
+            int32_t c = 0;
+            if (!ReadPod(in, c)) return false;
+            f.chars.push_back(c);
+        }
+
+        uint8_t gamepad = 0;
+        if (!ReadPod(in, gamepad)) return false;
+        f.gamepad = gamepad != 0;
+        if (f.gamepad)
+        {
+            for (int i = 0; i < GAMEPAD_AXIS_COUNT; i++)
+            {
+                if (!ReadPod(in, f.axes[i])) return false;
+            }
+            if (!ReadPod(in, f.padPressed)) return false;
+        }
+
+        return true;
+    }
+
+    // ------------------------------------------------------------
+    // Session
+    // ------------------------------------------------------------
+
+    static void CaptureFrame(FrameInput& f)
+    {
+        f = FrameInput{};
+        f.dt = ::GetFrameTime();
+        f.mouseDelta = ::GetMouseDelta();
+
+        for (int button = 0; button < MOUSE_BUTTON_COUNT; button++)
+        {
+            if (::IsMouseButtonDown(button)) f.mouseDown |= (uint8_t)(1u << button);
+            if (::IsMouseButtonPressed(button)) f.mousePressed |= (uint8_t)(1u << button);
+        }
+
+        for (int key = KEY_SPACE; key <= MAX_KEY; key++)
+        {
+            if (::IsKeyDown(key)) f.keyDown.set(key);
+            if (::IsKeyPressed(key)) f.keyPressed.set(key);
+        }
+
+        // Drain the typed character queue, consumers pop from the frame instead.
+        for (int c = ::GetCharPressed(); c > 0; c = ::GetCharPressed())
+        {
+            f.chars.push_back(c);
+        }
+
+        f.gamepad = ::IsGamepadAvailable(0);
+        if (f.gamepad)
+        {
+            for (int axis = 0; axis < GAMEPAD_AXIS_COUNT; axis++)
+            {
+                f.axes[axis] = ::GetGamepadAxisMovement(0, axis);
+            }
+
+            for (int button = 0; button < GAMEPAD_BUTTON_COUNT; button++)
+            {
+                if (::IsGamepadButtonPressed(0, button)) f.padPressed |= (1u << button);
+            }
+        }
+    }
+
+    static Header MakeHeaderFromCurrentGame(int levelIndex)
+    {
+        Header h;
+        h.seed = (uint64_t)std::time(nullptr) ^ (uint64_t)(::GetTime() * 1000000.0);
+        h.startTime = ::GetTime();
+        h.levelIndex = levelIndex;
+        h.firstLevel = first ? 1 : 0;
+
+        h.healthPotions = player.inventory.GetItemCount("HealthPotion");
+        h.manaPotions = player.inventory.GetItemCount("ManaPotion");
+        h.gold = player.gold;
+        h.currentPowerUp = static_cast<int32_t>(player.currentPowerUp);
+        h.hasCrossbow = hasCrossbow ? 1 : 0;
+        h.hasBlunderbuss = hasBlunderbuss ? 1 : 0;
+        h.hasStaff = hasStaff ? 1 : 0;
+        h.hasHarpoon = hasHarpoon ? 1 : 0;
+        h.hasDoubleShot = hasDoubleShot ? 1 : 0;
+        h.unlockEntrances = unlockEntrances ? 1 : 0;
+
+        h.mouseSensitivity = GameSettings::mouseSensitivity;
+        return h;
+    }
+
+    static void BeginSession(const Header& h, Camera& camera)
+    {
+        SeedRandom(h.seed);
+
+        first = h.firstLevel != 0;
+        player.inventory.SetItemCount("HealthPotion", h.healthPotions);
+        player.inventory.SetItemCount("ManaPotion", h.manaPotions);
+        player.gold = h.gold;
+        player.currentPowerUp = static_cast<PowerUpType>(h.currentPowerUp);
+        hasCrossbow = h.hasCrossbow != 0;
+        hasBlunderbuss = h.hasBlunderbuss != 0;
+        hasStaff = h.hasStaff != 0;
+        hasHarpoon = h.hasHarpoon != 0;
+        hasDoubleShot = h.hasDoubleShot != 0;
+        unlockEntrances = h.unlockEntrances != 0;
+        GameSettings::mouseSensitivity = h.mouseSensitivity;
+
+        InitLevel(levels[h.levelIndex], camera);
+        currentGameState = GameState::Playing;
+
+        gFrame = FrameInput{};
+        gCharCursor = 0;
+        gClock = h.startTime;
+        gFrameCount = 0;
+    }
+
+    static void WriteFrameTimeReport()
+    {
+        std::ofstream csv(gPath + ".frametimes.csv");
+        if (csv.is_open())
+        {
+            csv << "frame,ms\n";
+            for (size_t i = 0; i < gFrameTimesMs.size(); i++)
+            {
+                csv << i << ',' << gFrameTimesMs[i] << '\n';
+            }
+        }
+
+        // Skip the first frame, it carries the level load hitch.
+        if (gFrameTimesMs.size() < 2) return;
+
+        FrameTimeStats stats = ComputeFrameTimeStats(
+            std::vector<float>(gFrameTimesMs.begin() + 1, gFrameTimesMs.end()));
+
+        TraceLog(LOG_INFO, "REPLAY: %d frames  avg %.2f ms  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f",
+            stats.frames, stats.avgMs, stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs);
+    }
+
+    // ------------------------------------------------------------
+    // Public API
+    // ------------------------------------------------------------
+
+    bool StartRecording(const std::string& path, int levelIndex, Camera& camera)
+    {
+        Stop();
+
+        if (levelIndex < 0 || levelIndex >= (int)levels.size())
+        {
+            TraceLog(LOG_WARNING, "REPLAY: invalid level index %d", levelIndex);
+            return false;
+        }
+
+        gOut.open(path, std::ios::binary | std::ios::trunc);
+        if (!gOut.is_open())
+        {
+            TraceLog(LOG_WARNING, "REPLAY: could not open %s for writing", path.c_str());
+            return false;
+        }
+
+        Header h = MakeHeaderFromCurrentGame(levelIndex);
+        WriteHeader(gOut, h);
+
+        gPath = path;
+        BeginSession(h, camera);
+        gMode = Mode::Recording;
+
+        TraceLog(LOG_INFO, "REPLAY: recording %s (level %d, seed %llu)",
+            path.c_str(), levelIndex, (unsigned long long)h.seed);
+        return true;
+    }
+
+    bool StartPlayback(const std::string& path, Camera& camera)
+    {
+        Stop();
+
+        gIn.open(path, std::ios::binary);
+        if (!gIn.is_open())
+        {
+            TraceLog(LOG_WARNING, "REPLAY: could not open %s", path.c_str());
+            return false;
+        }
+
+        Header h;
+        if (!ReadHeader(gIn, h) || h.magic != REPLAY_MAGIC || h.version != REPLAY_VERSION)
+        {
+            TraceLog(LOG_WARNING, "REPLAY: %s is not a valid replay file", path.c_str());
+            gIn.close();
+            return false;
+        }
+
+        if (h.levelIndex < 0 || h.levelIndex >= (int)levels.size())
+        {
+            TraceLog(LOG_WARNING, "REPLAY: %s references missing level %d", path.c_str(), h.levelIndex);
+            gIn.close();
+            return false;
+        }
+
+        gPath = path;
+        gFrameTimesMs.clear();
+        BeginSession(h, camera);
+        gMode = Mode::Playback;
+
+        TraceLog(LOG_INFO, "REPLAY: playing %s (level %d)", path.c_str(), h.levelIndex);
+        return true;
+    }
+
+    void Stop()
+    {
+        if (gMode == Mode::Recording)
+        {
+            gOut.close();
+            TraceLog(LOG_INFO, "REPLAY: recorded %d frames to %s", gFrameCount, gPath.c_str());
+        }
+        else if (gMode == Mode::Playback)
+        {
+            gIn.close();
+            TraceLog(LOG_INFO, "REPLAY: playback finished after %d frames", gFrameCount);
+            WriteFrameTimeReport();
+        }
+
+        gMode = Mode::Off;
+    }
+
+    bool IsRecording()
+    {
+        return gMode == Mode::Recording;
+    }
+
+    bool IsPlayingBack()
+    {
+        return gMode == Mode::Playback;
+    }
+
+    bool IsActive()
+    {
+        return gMode != Mode::Off;
+    }
+
+    void BeginFrame()
+    {
+        if (gMode == Mode::Off) return;
+
+        // Leaving gameplay ends the session, the menu is not part of a replay.
+        if (currentGameState != GameState::Playing)
+        {
+            Stop();
+            return;
+        }
+
+        if (gMode == Mode::Recording)
+        {
+            CaptureFrame(gFrame);
+            WriteFrame(gOut, gFrame);
+        }
+        else
+        {
+            // Real escape hands control back to the player.
+            if (::IsKeyPressed(KEY_ESCAPE) || !ReadFrame(gIn, gFrame))
+            {
+                Stop();
+                return;
+            }
+
+            gFrameTimesMs.push_back(::GetFrameTime() * 1000.0f);
+        }
+
+        gCharCursor = 0;
+        gClock += gFrame.dt;
+        gFrameCount++;
+    }
+
+    bool IsKeyDown(int key)
+    {
+        if (gMode == Mode::Off) return ::IsKeyDown(key);
+        return key >= 0 && key <= MAX_KEY && gFrame.keyDown.test(key);
+    }
+
+    bool IsKeyPressed(int key)
+    {
+        if (gMode == Mode::Off) return ::IsKeyPressed(key);
+        return key >= 0 && key <= MAX_KEY && gFrame.keyPressed.test(key);
+    }
+
+    bool IsMouseButtonDown(int button)
+    {
+        if (gMode == Mode::Off) return ::IsMouseButtonDown(button);
+        return button >= 0 && button < MOUSE_BUTTON_COUNT && (gFrame.mouseDown & (1u << button));
+    }
+
+    bool IsMouseButtonPressed(int button)
+    {
+        if (gMode == Mode::Off) return ::IsMouseButtonPressed(button);
+        return button >= 0 && button < MOUSE_BUTTON_COUNT && (gFrame.mousePressed & (1u << button));
+    }
+
+    Vector2 GetMouseDelta()
+    {
+        if (gMode == Mode::Off) return ::GetMouseDelta();
+        return gFrame.mouseDelta;
+    }
+
+    int GetCharPressed()
+    {
+        if (gMode == Mode::Off) return ::GetCharPressed();
+        if (gCharCursor >= gFrame.chars.size()) return 0;
+        return gFrame.chars[gCharCursor++];
+    }
+
+    bool IsGamepadAvailable(int gamepad)
+    {
+        if (gMode == Mode::Off) return ::IsGamepadAvailable(gamepad);
+        return gamepad == 0 && gFrame.gamepad;
+    }
+
+    bool IsGamepadButtonPressed(int gamepad, int button)
+    {
+        if (gMode == Mode::Off) return ::IsGamepadButtonPressed(gamepad, button);
+        if (gamepad != 0 || !gFrame.gamepad) return false;
+        return button >= 0 && button < GAMEPAD_BUTTON_COUNT && (gFrame.padPressed & (1u << button));
+    }
+
+    float GetGamepadAxisMovement(int gamepad, int axis)
+    {
+        if (gMode == Mode::Off) return ::GetGamepadAxisMovement(gamepad, axis);
+        if (gamepad != 0 || !gFrame.gamepad) return 0.0f;
+        if (axis < 0 || axis >= GAMEPAD_AXIS_COUNT) return 0.0f;
+        return gFrame.axes[axis];
+    }
+
+    float GetFrameTime()
+    {
+        if (gMode == Mode::Off) return ::GetFrameTime();
+        return gFrame.dt;
+    }
+
+    double GetTime()
+    {
+        if (gMode == Mode::Off) return ::GetTime();
+        return gClock;
+    }
+}
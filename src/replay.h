@@ -0,0 +1,49 @@
+#pragma once
+
+#include "raylib.h"
+#include <string>
+
+// Input + seed replay for reproducible profiling captures.
+//
+// Recording: launch with  --record <file> [--level <index>]
+// Playback:  launch with  --replay <file>
+//
+// A session seeds the gameplay RNG, loads the level and then records (or feeds back)
+// one frame of input per main loop iteration: keys, mouse buttons/delta, typed chars,
+// gamepad 0 and the raw frame dt. Gameplay code reads input and time through the
+// wrappers below instead of raylib directly, so a playback runs bit-exactly the same
+// simulation as the recording. When no session is active the wrappers pass straight through.
+//
+// Playback also logs the real frame times and writes <file>.frametimes.csv when it ends,
+// so the same fight can be compared across builds and settings.
+// The session ends when the recording runs out, the game returns to the menu,
+// or Escape is pressed during playback.
+
+namespace Replay
+{
+    bool StartRecording(const std::string& path, int levelIndex, Camera& camera);
+    bool StartPlayback(const std::string& path, Camera& camera);
+    void Stop();
+
+    bool IsRecording();
+    bool IsPlayingBack();
+    bool IsActive();
+
+    // Call once at the top of the main loop, before anything reads input.
+    void BeginFrame();
+
+    // Input, routed through the active session.
+    bool IsKeyDown(int key);
+    bool IsKeyPressed(int key);
+    bool IsMouseButtonDown(int button);
+    bool IsMouseButtonPressed(int button);
+    Vector2 GetMouseDelta();
+    int GetCharPressed();
+    bool IsGamepadAvailable(int gamepad);
+    bool IsGamepadButtonPressed(int gamepad, int button);
+    float GetGamepadAxisMovement(int gamepad, int axis);
+
+    // Time, routed through the active session.
+    float GetFrameTime();
+    double GetTime();
+}
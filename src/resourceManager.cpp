@@ -10,6 +10,8 @@
 #include "camera_system.h"
 #include "shaderSetup.h"
 #include "game_settings.h"
+#include "asset_loader.h"
+#include "sprite_atlas.h"
 
 
 
@@ -57,6 +59,22 @@ Texture2D& ResourceManager::LoadTexture(const std::string& name, const std::stri
     return _textures[name];
 }
 
+// Upload half of LoadTexture, for images decoded off the main thread (see AssetLoader)
+Texture2D& ResourceManager::AddTextureFromImage(const std::string& name, const Image& image, const std::string& path) {
+    auto it = _textures.find(name);
+    if (it != _textures.end()) return it->second;
+
+    Texture2D tex = (image.data != nullptr) ? ::LoadTextureFromImage(image) : Texture2D{};
+
+    if (tex.id == 0) {
+        TraceLog(LOG_ERROR, "❌ LoadTexture failed for '%s' at path '%s'", name.c_str(), path.c_str());
+        exit(1);
+    }
+
+    _textures.emplace(name, tex);
+    return _textures[name];
+}
+
 
 Texture2D& ResourceManager::GetTexture(const std::string& name) {
     auto it = _textures.find(name);
@@ -69,47 +87,60 @@ Texture2D& ResourceManager::GetTexture(const std::string& name) {
 
 // Model
 Model& ResourceManager::LoadModel(const std::string& name, const std::string& path) {
-    auto it = _models.find(name);
-    if (it != _models.end()) return it->second;
-    Model m = ::LoadModel(path.c_str());
-    _models.emplace(name, m);
-    return _models[name];
+    auto it = _modelIds.find(name);
+    if (it != _modelIds.end()) return _modelStore[it->second];
+    _modelIds.emplace(name, (int)_modelStore.size());
+    _modelStore.push_back(::LoadModel(path.c_str()));
+    return _modelStore.back();
 }
 
 Model& ResourceManager::AddModelFromMesh(const std::string& name, Mesh mesh)   // note: Mesh by value is fine
 {
-    auto it = _models.find(name);
-    if (it != _models.end()) return it->second;
+    auto it = _modelIds.find(name);
+    if (it != _modelIds.end()) return _modelStore[it->second];
+
+    _modelIds.emplace(name, (int)_modelStore.size());
+    _modelStore.push_back(::LoadModelFromMesh(mesh));
+    return _modelStore.back();
+}
 
-    // Construct directly in the map (no intermediate copy)
-    auto [insertIt, inserted] = _models.emplace(name, ::LoadModelFromMesh(mesh));
-    return insertIt->second;
+ModelId ResourceManager::FindModelId(const std::string& name) const {
+    auto it = _modelIds.find(name);
+    if (it == _modelIds.end()) return ModelId{};
+    return ModelId{ it->second };
 }
 
 Model& ResourceManager::GetModel(const std::string& name) {
-    auto it = _models.find(name);
-    if (it == _models.end()) throw std::runtime_error("Model not found: " + name);
-    return it->second;
+    auto it = _modelIds.find(name);
+    if (it == _modelIds.end()) throw std::runtime_error("Model not found: " + name);
+    return _modelStore[it->second];
 }
 
 const Model& ResourceManager::GetModel(const std::string& name) const {
-    auto it = _models.find(name);
-    if (it == _models.end()) throw std::runtime_error("Model not found: " + name);
-    return it->second;
+    auto it = _modelIds.find(name);
+    if (it == _modelIds.end()) throw std::runtime_error("Model not found: " + name);
+    return _modelStore[it->second];
 }
 
 // Shader
 Shader& ResourceManager::LoadShader(const std::string& name, const std::string& vsPath, const std::string& fsPath) {
-    auto it = _shaders.find(name);
-    if (it != _shaders.end()) return it->second;
-    Shader s = ::LoadShader(vsPath.c_str(), fsPath.c_str());
-    _shaders.emplace(name, s);
-    return _shaders[name];
+    auto it = _shaderIds.find(name);
+    if (it != _shaderIds.end()) return _shaderStore[it->second];
+    _shaderIds.emplace(name, (int)_shaderStore.size());
+    _shaderStore.push_back(::LoadShader(vsPath.c_str(), fsPath.c_str()));
+    return _shaderStore.back();
+}
+
+ShaderId ResourceManager::FindShaderId(const std::string& name) const {
+    auto it = _shaderIds.find(name);
+    if (it == _shaderIds.end()) return ShaderId{};
+    return ShaderId{ it->second };
 }
+
 Shader& ResourceManager::GetShader(const std::string& name) const {
-    auto it = _shaders.find(name);
-    if (it == _shaders.end()) throw std::runtime_error("Shader not found: " + name);
-    return const_cast<Shader&>(it->second);
+    auto it = _shaderIds.find(name);
+    if (it == _shaderIds.end()) throw std::runtime_error("Shader not found: " + name);
+    return const_cast<Shader&>(_shaderStore[it->second]);
 }
 
 
@@ -222,144 +253,145 @@ void ResourceManager::LoadAllResources() {
     R.LoadFont("terminal", "assets/fonts/VT323-Regular.ttf");
 
     //Resources are saved to unordered maps, with a string key. Get a resource by calling R.GetModel("blunderbuss") for example. 
-    R.LoadTexture("raptorTexture",      "assets/sprites/bigRaptorSheet.png");
-    R.LoadTexture("skeletonSheet",      "assets/sprites/skeletonSheet.png");
-    R.LoadTexture("muzzleFlash",        "assets/sprites/muzzleFlash.png");
-    R.LoadTexture("backDrop",           "assets/screenshots/dungeon1.png");
-    R.LoadTexture("smokeSheet",         "assets/sprites/smokeSheet.png");
-    R.LoadTexture("bloodSheet",         "assets/sprites/bloodDecalSheet.png");
-    R.LoadTexture("doorTexture",        "assets/sprites/Door.png");
-    R.LoadTexture("healthPotTexture",   "assets/sprites/Healthpot.png");
-    R.LoadTexture("keyTexture",         "assets/sprites/key.png");
-    R.LoadTexture("swordBloody",        "assets/textures/swordBloody2.png");
-    R.LoadTexture("swordClean",         "assets/textures/swordClean.png");
-    R.LoadTexture("fireSheet",          "assets/sprites/fireSheet.png");
-    R.LoadTexture("pirateSheet",        "assets/sprites/pirateSheet.png");
-    R.LoadTexture("coinTexture",        "assets/sprites/coin.png");
-    R.LoadTexture("spiderSheet",        "assets/sprites/spiderSheet.png");
-    R.LoadTexture("spiderWebTexture",   "assets/sprites/spiderWeb.png");
-    R.LoadTexture("brokeWebTexture",    "assets/sprites/brokeWeb.png");
-    R.LoadTexture("explosionSheet",     "assets/sprites/explosionSheet.png");
-    R.LoadTexture("manaPotion",         "assets/sprites/manaPotion.png");
-    R.LoadTexture("fireIcon",           "assets/sprites/fireIcon.png");
-    R.LoadTexture("iceIcon",            "assets/sprites/iceIcon.png");
-    R.LoadTexture("shadowTex",          "assets/textures/shadow_decal.png");
-    R.LoadTexture("ghostSheet",         "assets/sprites/ghostSheet.png");
-    R.LoadTexture("magicAttackSheet",   "assets/sprites/magicAttackSheet.png");
-    R.LoadTexture("treeShadow",         "assets/textures/treeShadow.png");
-    R.LoadTexture("grassTexture",       "assets/textures/grass2.png");
-    R.LoadTexture("sandTexture",        "assets/textures/sand.png");
-    R.LoadTexture("trexSheet",          "assets/sprites/trexSheet.png");
-    R.LoadTexture("blockSheet",         "assets/sprites/blockSheet2.png");
-    R.LoadTexture("playerSlashSheet",   "assets/sprites/playerSlashSheet.png");
-    R.LoadTexture("slashSheet",         "assets/sprites/slashSheet.png");
-    R.LoadTexture("slashSheetLeft",     "assets/sprites/slashSheetLeft.png");
-    R.LoadTexture("biteSheet",          "assets/sprites/biteSheet.png");
-    R.LoadTexture("bulletHoleSheet",    "assets/sprites/bulletHoleSheet.png");
-    R.LoadTexture("GiantSpiderSheet",   "assets/sprites/giantSpiderSheet.png");
-    R.LoadTexture("spiderEggSheet",     "assets/sprites/spiderEggSheet.png");
-    R.LoadTexture("blank",              "assets/textures/blank.png");
-    R.LoadTexture("silverKey",          "assets/sprites/silverKey.png");
-    R.LoadTexture("harpoon",            "assets/sprites/harpoon.png");
-    R.LoadTexture("grapplePoint",       "assets/sprites/grapplePoint.png");
-    R.LoadTexture("swordIcon",          "assets/sprites/cutlassIcon.png");
-    R.LoadTexture("crossbowIcon",       "assets/sprites/crossbowIcon2.png");
-    R.LoadTexture("blunderbussIcon",    "assets/sprites/blunderbussIcon2.png");
-    R.LoadTexture("staffIcon",          "assets/sprites/staffIcon2.png");
-    R.LoadTexture("shotgunReticle",     "assets/sprites/shotgunReticle.png");
-    R.LoadTexture("dactylSheet",        "assets/sprites/dactylSheet.png");
-    R.LoadTexture("ceilingTexture",     "assets/textures/ceilingTilesTexture.png");
-    R.LoadTexture("wizardSheet",        "assets/sprites/wizardSheet.png");
-    R.LoadTexture("IceWizardSheet",     "assets/sprites/IceWizardSheet.png");
-    R.LoadTexture("skeletonKey",        "assets/sprites/skeletonKey.png");
-    R.LoadTexture("batSheet",           "assets/sprites/batSheet.png");
-    R.LoadTexture("hermitSheet",        "assets/sprites/hermitSheet.png");
-    R.LoadTexture("whiteGradient",      "assets/textures/whiteGradient.png");
-    R.LoadTexture("zombieSheet",        "assets/sprites/zombieSheet.png");
-    R.LoadTexture("zombieSheetArmless", "assets/sprites/zombieSheetArmless.png");
-    R.LoadTexture("zombieSheetHeadless","assets/sprites/zombieSheetHeadless.png");
-    R.LoadTexture("headSpin",           "assets/sprites/headSpin.png");
-    R.LoadTexture("armSpin",            "assets/sprites/armSpin.png");
-    R.LoadTexture("zombieGib",          "assets/sprites/zombieGib.png");
-    R.LoadTexture("boneSpin",           "assets/sprites/boneSpin.png");
-    R.LoadTexture("quadDamage",         "assets/sprites/quadDamage.png");
-    R.LoadTexture("haste",              "assets/sprites/haste.png");
-    R.LoadTexture("overHealth",         "assets/sprites/overHealth.png");
-    R.LoadTexture("grassCard",          "assets/textures/grassCard1.png");
-    R.LoadTexture("grassCard2",          "assets/textures/grassCard2.png");
-    R.LoadTexture("grassCard3",          "assets/textures/grassCard3.png");
-    R.LoadTexture("grassCard4",          "assets/textures/grassCard4.png");
-    R.LoadTexture("cratePile",           "assets/textures/cratePile.png");
-    R.LoadTexture("wallBanner",          "assets/sprites/wallBanner.png");
-    R.LoadTexture("paper",               "assets/textures/paper.png");
-    R.LoadTexture("borderLeft",          "assets/textures/borderUILeft.png");
-    R.LoadTexture("borderRight",         "assets/textures/borderUIRight.png");
-
-    R.LoadTexture("raftMast", "assets/sprites/raftMast.png");
-    R.LoadTexture("raftBody", "assets/sprites/raftBody.png");
-    R.LoadTexture("raftSail", "assets/sprites/raftSail.png");
+    //Textures and models are only queued here, they are decoded on worker threads and uploaded by AssetLoader::Flush() (main.cpp).
+    AssetLoader::QueueTexture("raptorTexture",      "assets/sprites/bigRaptorSheet.png");
+    AssetLoader::QueueTexture("skeletonSheet",      "assets/sprites/skeletonSheet.png");
+    AssetLoader::QueueTexture("muzzleFlash",        "assets/sprites/muzzleFlash.png");
+    AssetLoader::QueueTexture("backDrop",           "assets/screenshots/dungeon1.png");
+    AssetLoader::QueueTexture("smokeSheet",         "assets/sprites/smokeSheet.png");
+    AssetLoader::QueueTexture("bloodSheet",         "assets/sprites/bloodDecalSheet.png");
+    AssetLoader::QueueTexture("doorTexture",        "assets/sprites/Door.png");
+    AssetLoader::QueueTexture("healthPotTexture",   "assets/sprites/Healthpot.png");
+    AssetLoader::QueueTexture("keyTexture",         "assets/sprites/key.png");
+    AssetLoader::QueueTexture("swordBloody",        "assets/textures/swordBloody2.png");
+    AssetLoader::QueueTexture("swordClean",         "assets/textures/swordClean.png");
+    AssetLoader::QueueTexture("fireSheet",          "assets/sprites/fireSheet.png");
+    AssetLoader::QueueTexture("pirateSheet",        "assets/sprites/pirateSheet.png");
+    AssetLoader::QueueTexture("coinTexture",        "assets/sprites/coin.png");
+    AssetLoader::QueueTexture("spiderSheet",        "assets/sprites/spiderSheet.png");
+    AssetLoader::QueueTexture("spiderWebTexture",   "assets/sprites/spiderWeb.png");
+    AssetLoader::QueueTexture("brokeWebTexture",    "assets/sprites/brokeWeb.png");
+    AssetLoader::QueueTexture("explosionSheet",     "assets/sprites/explosionSheet.png");
+    AssetLoader::QueueTexture("manaPotion",         "assets/sprites/manaPotion.png");
+    AssetLoader::QueueTexture("fireIcon",           "assets/sprites/fireIcon.png");
+    AssetLoader::QueueTexture("iceIcon",            "assets/sprites/iceIcon.png");
+    AssetLoader::QueueTexture("shadowTex",          "assets/textures/shadow_decal.png");
+    AssetLoader::QueueTexture("ghostSheet",         "assets/sprites/ghostSheet.png");
+    AssetLoader::QueueTexture("magicAttackSheet",   "assets/sprites/magicAttackSheet.png");
+    AssetLoader::QueueTexture("treeShadow",         "assets/textures/treeShadow.png");
+    AssetLoader::QueueTexture("grassTexture",       "assets/textures/grass2.png");
+    AssetLoader::QueueTexture("sandTexture",        "assets/textures/sand.png");
+    AssetLoader::QueueTexture("trexSheet",          "assets/sprites/trexSheet.png");
+    AssetLoader::QueueTexture("blockSheet",         "assets/sprites/blockSheet2.png");
+    AssetLoader::QueueTexture("playerSlashSheet",   "assets/sprites/playerSlashSheet.png");
+    AssetLoader::QueueTexture("slashSheet",         "assets/sprites/slashSheet.png");
+    AssetLoader::QueueTexture("slashSheetLeft",     "assets/sprites/slashSheetLeft.png");
+    AssetLoader::QueueTexture("biteSheet",          "assets/sprites/biteSheet.png");
+    AssetLoader::QueueTexture("bulletHoleSheet",    "assets/sprites/bulletHoleSheet.png");
+    AssetLoader::QueueTexture("GiantSpiderSheet",   "assets/sprites/giantSpiderSheet.png");
+    AssetLoader::QueueTexture("spiderEggSheet",     "assets/sprites/spiderEggSheet.png");
+    AssetLoader::QueueTexture("blank",              "assets/textures/blank.png");
+    AssetLoader::QueueTexture("silverKey",          "assets/sprites/silverKey.png");
+    AssetLoader::QueueTexture("harpoon",            "assets/sprites/harpoon.png");
+    AssetLoader::QueueTexture("grapplePoint",       "assets/sprites/grapplePoint.png");
+    AssetLoader::QueueTexture("swordIcon",          "assets/sprites/cutlassIcon.png");
+    AssetLoader::QueueTexture("crossbowIcon",       "assets/sprites/crossbowIcon2.png");
+    AssetLoader::QueueTexture("blunderbussIcon",    "assets/sprites/blunderbussIcon2.png");
+    AssetLoader::QueueTexture("staffIcon",          "assets/sprites/staffIcon2.png");
+    AssetLoader::QueueTexture("shotgunReticle",     "assets/sprites/shotgunReticle.png");
+    AssetLoader::QueueTexture("dactylSheet",        "assets/sprites/dactylSheet.png");
+    AssetLoader::QueueTexture("ceilingTexture",     "assets/textures/ceilingTilesTexture.png");
+    AssetLoader::QueueTexture("wizardSheet",        "assets/sprites/wizardSheet.png");
+    AssetLoader::QueueTexture("IceWizardSheet",     "assets/sprites/IceWizardSheet.png");
+    AssetLoader::QueueTexture("skeletonKey",        "assets/sprites/skeletonKey.png");
+    AssetLoader::QueueTexture("batSheet",           "assets/sprites/batSheet.png");
+    AssetLoader::QueueTexture("hermitSheet",        "assets/sprites/hermitSheet.png");
+    AssetLoader::QueueTexture("whiteGradient",      "assets/textures/whiteGradient.png");
+    AssetLoader::QueueTexture("zombieSheet",        "assets/sprites/zombieSheet.png");
+    AssetLoader::QueueTexture("zombieSheetArmless", "assets/sprites/zombieSheetArmless.png");
+    AssetLoader::QueueTexture("zombieSheetHeadless","assets/sprites/zombieSheetHeadless.png");
+    AssetLoader::QueueTexture("headSpin",           "assets/sprites/headSpin.png");
+    AssetLoader::QueueTexture("armSpin",            "assets/sprites/armSpin.png");
+    AssetLoader::QueueTexture("zombieGib",          "assets/sprites/zombieGib.png");
+    AssetLoader::QueueTexture("boneSpin",           "assets/sprites/boneSpin.png");
+    AssetLoader::QueueTexture("quadDamage",         "assets/sprites/quadDamage.png");
+    AssetLoader::QueueTexture("haste",              "assets/sprites/haste.png");
+    AssetLoader::QueueTexture("overHealth",         "assets/sprites/overHealth.png");
+    AssetLoader::QueueTexture("grassCard",          "assets/textures/grassCard1.png");
+    AssetLoader::QueueTexture("grassCard2",          "assets/textures/grassCard2.png");
+    AssetLoader::QueueTexture("grassCard3",          "assets/textures/grassCard3.png");
+    AssetLoader::QueueTexture("grassCard4",          "assets/textures/grassCard4.png");
+    AssetLoader::QueueTexture("cratePile",           "assets/textures/cratePile.png");
+    AssetLoader::QueueTexture("wallBanner",          "assets/sprites/wallBanner.png");
+    AssetLoader::QueueTexture("paper",               "assets/textures/paper.png");
+    AssetLoader::QueueTexture("borderLeft",          "assets/textures/borderUILeft.png");
+    AssetLoader::QueueTexture("borderRight",         "assets/textures/borderUIRight.png");
+
+    AssetLoader::QueueTexture("raftMast", "assets/sprites/raftMast.png");
+    AssetLoader::QueueTexture("raftBody", "assets/sprites/raftBody.png");
+    AssetLoader::QueueTexture("raftSail", "assets/sprites/raftSail.png");
 
     // Models (registering with string keys)
-    R.LoadModel("palmTree",               "assets/Models/bigPalmTree.glb");
-
-    R.LoadModel("palmTreeInstanced", "assets/Models/bigPalmTree.glb");
-     R.LoadModel("bushInstanced",    "assets/Models/grass(stripped).glb");
-
-    R.LoadModel("palm2",                  "assets/Models/smallPalmTree.glb");
-    R.LoadModel("bush",                   "assets/Models/grass(stripped).glb");
-    R.LoadModel("boatModel",              "assets/Models/boat.glb");
-    R.LoadModel("blunderbuss",            "assets/Models/blunderbus.glb");
-    R.LoadModel("floorTileGray",          "assets/Models/floorTileGray.glb");
-    R.LoadModel("doorWayGray",            "assets/Models/doorWayGray.glb");
-    R.LoadModel("wallSegment",            "assets/Models/wallSegment.glb");
-    R.LoadModel("barrelModel",            "assets/Models/barrel.glb");
-    R.LoadModel("swordModel",             "assets/Models/sword2.glb");
-    R.LoadModel("lampModel",              "assets/Models/lamp.glb");
-    R.LoadModel("brokeBarrel",            "assets/Models/brokeBarrel.glb");
-    R.LoadModel("chestModel",             "assets/Models/chest.glb");
-    R.LoadModel("staffModel",             "assets/Models/staff.glb");
-    R.LoadModel("fireballModel",          "assets/Models/fireball.glb");
-    R.LoadModel("iceballModel",           "assets/Models/iceBall.glb");
-    R.LoadModel("campFire",               "assets/Models/campFire.glb");
-    R.LoadModel("stonePillar",            "assets/Models/stonePillar.glb");
-    R.LoadModel("lavaTile",               "assets/Models/lavaTileSquare.glb");
-    R.LoadModel("crossbow",               "assets/Models/crossbow.glb");
-    R.LoadModel("crossbowRest",           "assets/Models/crossbowRest.glb");
-    R.LoadModel("bolt",                   "assets/Models/bolt.glb");
-    R.LoadModel("windowedWall",           "assets/Models/windowedWall.glb");
-    R.LoadModel("windowWay",              "assets/Models/windowHoleSquare.glb");
-    R.LoadModel("box",                    "assets/Models/box.glb");
-    R.LoadModel("healthPotion",           "assets/Models/healthPotion.glb");
-    R.LoadModel("raft",                   "assets/Models/raft.glb");
-    R.LoadModel("raftBody",               "assets/Models/raftBody.glb");
-    R.LoadModel("raftMast",               "assets/Models/raftMast.glb");
-    R.LoadModel("raftBoom",               "assets/Models/raftBoom.glb");
-    R.LoadModel("raftSail",               "assets/Models/raftSail.glb");
-
-    R.LoadModel("collectableMast",        "assets/Models/collectableMast.glb");
-    R.LoadModel("collectableBoom",        "assets/Models/collectableBoom.glb");
-    R.LoadModel("collectableSail",        "assets/Models/collectableSail.glb");
-
-    R.LoadModel("woodWall",               "assets/Models/woodWall.glb");
-    R.LoadModel("woodDoorWay",            "assets/Models/woodDoorWay.glb");
-    R.LoadModel("woodWallHalf",           "assets/Models/woodWallHalf.glb");
-    R.LoadModel("woodFloor",              "assets/Models/floorTileWood.glb");
-    R.LoadModel("shipMast",               "assets/Models/cartoonMast.glb");
-    R.LoadModel("squidHead",              "assets/Models/squidHead2.glb");
-    R.LoadModel("cannon",                 "assets/Models/cannon.glb");
-    R.LoadModel("cannonBall",             "assets/Models/cannonBall.glb");
-    R.LoadModel("cannonBalls",            "assets/Models/cannonBalls.glb");
-
-    R.LoadModel("grassCardInstanced",     "assets/Models/grassCard1.glb");
-    R.LoadModel("grassCardInstanced2",    "assets/Models/grassCard2.glb");
-    R.LoadModel("grassCardInstanced3",    "assets/Models/grassCard3.glb");
-    R.LoadModel("grassCardInstanced4",    "assets/Models/grassCard4.glb");
-
-    R.LoadModel("TableSet",               "assets/Models/TableSet.glb");
-    R.LoadModel("cratePile",              "assets/Models/cratePile.glb");
-    R.LoadModel("stool",                  "assets/Models/stool.glb");
-    R.LoadModel("bonePile",               "assets/Models/bonePile.glb");
-    R.LoadModel("candelabra",             "assets/Models/candelabra.glb");
+    AssetLoader::QueueModel("palmTree",               "assets/Models/bigPalmTree.glb");
+
+    AssetLoader::QueueModel("palmTreeInstanced", "assets/Models/bigPalmTree.glb");
+     AssetLoader::QueueModel("bushInstanced",    "assets/Models/grass(stripped).glb");
+
+    AssetLoader::QueueModel("palm2",                  "assets/Models/smallPalmTree.glb");
+    AssetLoader::QueueModel("bush",                   "assets/Models/grass(stripped).glb");
+    AssetLoader::QueueModel("boatModel",              "assets/Models/boat.glb");
+    AssetLoader::QueueModel("blunderbuss",            "assets/Models/blunderbus.glb");
+    AssetLoader::QueueModel("floorTileGray",          "assets/Models/floorTileGray.glb");
+    AssetLoader::QueueModel("doorWayGray",            "assets/Models/doorWayGray.glb");
+    AssetLoader::QueueModel("wallSegment",            "assets/Models/wallSegment.glb");
+    AssetLoader::QueueModel("barrelModel",            "assets/Models/barrel.glb");
+    AssetLoader::QueueModel("swordModel",             "assets/Models/sword2.glb");
+    AssetLoader::QueueModel("lampModel",              "assets/Models/lamp.glb");
+    AssetLoader::QueueModel("brokeBarrel",            "assets/Models/brokeBarrel.glb");
+    AssetLoader::QueueModel("chestModel",             "assets/Models/chest.glb");
+    AssetLoader::QueueModel("staffModel",             "assets/Models/staff.glb");
+    AssetLoader::QueueModel("fireballModel",          "assets/Models/fireball.glb");
+    AssetLoader::QueueModel("iceballModel",           "assets/Models/iceBall.glb");
+    AssetLoader::QueueModel("campFire",               "assets/Models/campFire.glb");
+    AssetLoader::QueueModel("stonePillar",            "assets/Models/stonePillar.glb");
+    AssetLoader::QueueModel("lavaTile",               "assets/Models/lavaTileSquare.glb");
+    AssetLoader::QueueModel("crossbow",               "assets/Models/crossbow.glb");
+    AssetLoader::QueueModel("crossbowRest",           "assets/Models/crossbowRest.glb");
+    AssetLoader::QueueModel("bolt",                   "assets/Models/bolt.glb");
+    AssetLoader::QueueModel("windowedWall",           "assets/Models/windowedWall.glb");
+    AssetLoader::QueueModel("windowWay",              "assets/Models/windowHoleSquare.glb");
+    AssetLoader::QueueModel("box",                    "assets/Models/box.glb");
+    AssetLoader::QueueModel("healthPotion",           "assets/Models/healthPotion.glb");
+    AssetLoader::QueueModel("raft",                   "assets/Models/raft.glb");
+    AssetLoader::QueueModel("raftBody",               "assets/Models/raftBody.glb");
+    AssetLoader::QueueModel("raftMast",               "assets/Models/raftMast.glb");
+    AssetLoader::QueueModel("raftBoom",               "assets/Models/raftBoom.glb");
+    AssetLoader::QueueModel("raftSail",               "assets/Models/raftSail.glb");
+
+    AssetLoader::QueueModel("collectableMast",        "assets/Models/collectableMast.glb");
+    AssetLoader::QueueModel("collectableBoom",        "assets/Models/collectableBoom.glb");
+    AssetLoader::QueueModel("collectableSail",        "assets/Models/collectableSail.glb");
+
+    AssetLoader::QueueModel("woodWall",               "assets/Models/woodWall.glb");
+    AssetLoader::QueueModel("woodDoorWay",            "assets/Models/woodDoorWay.glb");
+    AssetLoader::QueueModel("woodWallHalf",           "assets/Models/woodWallHalf.glb");
+    AssetLoader::QueueModel("woodFloor",              "assets/Models/floorTileWood.glb");
+    AssetLoader::QueueModel("shipMast",               "assets/Models/cartoonMast.glb");
+    AssetLoader::QueueModel("squidHead",              "assets/Models/squidHead2.glb");
+    AssetLoader::QueueModel("cannon",                 "assets/Models/cannon.glb");
+    AssetLoader::QueueModel("cannonBall",             "assets/Models/cannonBall.glb");
+    AssetLoader::QueueModel("cannonBalls",            "assets/Models/cannonBalls.glb");
+
+    AssetLoader::QueueModel("grassCardInstanced",     "assets/Models/grassCard1.glb");
+    AssetLoader::QueueModel("grassCardInstanced2",    "assets/Models/grassCard2.glb");
+    AssetLoader::QueueModel("grassCardInstanced3",    "assets/Models/grassCard3.glb");
+    AssetLoader::QueueModel("grassCardInstanced4",    "assets/Models/grassCard4.glb");
+
+    AssetLoader::QueueModel("TableSet",               "assets/Models/TableSet.glb");
+    AssetLoader::QueueModel("cratePile",              "assets/Models/cratePile.glb");
+    AssetLoader::QueueModel("stool",                  "assets/Models/stool.glb");
+    AssetLoader::QueueModel("bonePile",               "assets/Models/bonePile.glb");
+    AssetLoader::QueueModel("candelabra",             "assets/Models/candelabra.glb");
 
     //generated models
 
@@ -373,6 +405,7 @@ void ResourceManager::LoadAllResources() {
     //shaders
     R.LoadShader("terrainShader",  "assets/shaders/height_color.vs",       "assets/shaders/height_color.fs");
     R.LoadShader("shadowShader",   "assets/shaders/shadow_decal.vs",       "assets/shaders/shadow_decal.fs");
+    R.LoadShader("shadowInstancedShader", "assets/shaders/shadow_decal_instanced.vs", "assets/shaders/shadow_decal.fs");
     R.LoadShader("skyShader",      "assets/shaders/skybox.vs",             "assets/shaders/skybox.fs");
     R.LoadShader("waterShader",    "assets/shaders/water.vs",              "assets/shaders/water.fs");
     R.LoadShader("bloomShader",    /*vsPath=*/"",                          "assets/shaders/bloom.fs");
@@ -388,6 +421,7 @@ void ResourceManager::LoadAllResources() {
     R.LoadShader("weapon_outline", "assets/shaders/weapon_outline.vs",     "assets/shaders/weapon_outline.fs");
     R.LoadShader("grayscale",      "",                                     "assets/shaders/grayscale.fs");
     R.LoadShader("journalShader",  "",                                     "assets/shaders/journal_page.fs");
+    R.LoadShader("minimapShader",  "",                                     "assets/shaders/minimap.fs");
 
 }
 
@@ -397,9 +431,11 @@ void ResourceManager::SetShaderValues(){
 
     ShaderSetup::InitGhostShader(ShaderSetup::gGhost);
     ShaderSetup::InitAlphaCutout(ShaderSetup::gAlpha);
+    ShaderSetup::InitPropLightingShader(ShaderSetup::gPropLighting);
     ShaderSetup::InitShadowShader(ShaderSetup::gShadow);
     ShaderSetup::InitWeaponOutlineFx();
     ShaderSetup::InitJournalShader();
+    ShaderSetup::InitFrameUniforms(); //resolve frame-global uniform locations once
 
 }
 
@@ -623,57 +659,24 @@ void ResourceManager::SetLightingShaderValues()
 
 
 
-void ResourceManager::UpdateShaders(Camera& camera){
+void ResourceManager::UpdateShaders(){
     //SetWaterShaderValues(camera); //update water every frame
-    //runs every frame, updates all shaders
+    //runs every frame. camera, fog colors, useFog and night darkness go out with
+    //ShaderSetup::UpdateFrameUniforms(), this is only the terrain specific stuff.
 
-    Shader& terrainShader = R.GetShader("terrainShader");
-    Vector3 camPos = camera.position;
-
-    //terrain fog locs
-    int camPosLoc = GetShaderLocation(terrainShader, "cameraPos");
-    int tFogStartLoc = GetShaderLocation(terrainShader, "u_FogStart");
-    int fogColorLoc = GetShaderLocation(terrainShader, "u_SkyColorHorizon");
-    int fogColorTopLoc = GetShaderLocation(terrainShader, "u_SkyColorTop");
-    int useFogLoc = GetShaderLocation(terrainShader, "u_UseFog");
-    int locCam_Terrain = GetShaderLocation(terrainShader, "cameraPos");
+    ShaderSetup::TerrainShader& ts = ShaderSetup::gTerrain;
+    Shader& terrainShader = *ts.shader;
 
     float terrainFogStart = (currentGameState == GameState::Menu) ? GameSettings::terrainFogStartMenu : GameSettings::terrainFogStart;
-    int useFog = GameSettings::useFog;//1;//(currentGameState == GameState::Menu) ? 0 : 1; //dont render fog in menu.
-
-    SetShaderValue( terrainShader, useFogLoc, &useFog, SHADER_UNIFORM_INT);
-
-    //SetShaderValue(R.GetShader("treeShader"), fogStartLoc, &fogStart, SHADER_UNIFORM_FLOAT);
-    Vector3 fogColor = ShaderSetup::GetCurrentSkyFogColor();
-    Vector3 topFogColor = ShaderSetup::GetCurrentSkyTopFogColor();
-    SetShaderValue(terrainShader, fogColorLoc, &fogColor, SHADER_UNIFORM_VEC3); //use current sky color
-    SetShaderValue(terrainShader, fogColorTopLoc, &topFogColor, SHADER_UNIFORM_VEC3);
-    SetShaderValue(terrainShader, tFogStartLoc, &terrainFogStart, SHADER_UNIFORM_FLOAT);
-    //distance based desaturation on terrain needs camera pos
-    SetShaderValue(terrainShader, camPosLoc, &camPos, SHADER_UNIFORM_VEC3);
-
+    SetShaderValue(terrainShader, ts.loc_fogStart, &terrainFogStart, SHADER_UNIFORM_FLOAT);
 
     //tree shadows
-    // Once (cache locations)
-    int locShadow      = GetShaderLocation(terrainShader, "u_ShadowMask");
-    int locWorldMinXZ  = GetShaderLocation(terrainShader, "u_WorldMinXZ");
-    int locWorldSizeXZ = GetShaderLocation(terrainShader, "u_WorldSizeXZ");
-
-    
-    // Per-frame before drawing terrain:
     Vector2 worldMinXZ  = { gTreeShadowMask.worldXZBounds.x, gTreeShadowMask.worldXZBounds.y };
     Vector2 worldSizeXZ = { gTreeShadowMask.worldXZBounds.width, gTreeShadowMask.worldXZBounds.height };
 
-    SetShaderValue(terrainShader, locWorldMinXZ,  &worldMinXZ,  SHADER_UNIFORM_VEC2);
-    SetShaderValue(terrainShader, locWorldSizeXZ, &worldSizeXZ, SHADER_UNIFORM_VEC2);
-    SetShaderValueTexture(terrainShader, locShadow, gTreeShadowMask.rt.texture);
-
-    //distance fog
-
-    float nightDarkness = ShaderSetup::gSky.skyTransition;
-
-    SetShaderValue(terrainShader,GetShaderLocation(terrainShader, "u_TerrainNightDarkness"),&nightDarkness,SHADER_UNIFORM_FLOAT);
-    SetShaderValue(terrainShader, locCam_Terrain, &camPos, SHADER_UNIFORM_VEC3);
+    SetShaderValue(terrainShader, ts.loc_worldMinXZ,  &worldMinXZ,  SHADER_UNIFORM_VEC2);
+    SetShaderValue(terrainShader, ts.loc_worldSizeXZ, &worldSizeXZ, SHADER_UNIFORM_VEC2);
+    SetShaderValueTexture(terrainShader, ts.loc_shadowMask, gTreeShadowMask.rt.texture);
 
 }
 
@@ -691,8 +694,13 @@ void ResourceManager::UnloadRenderTextures()
 
 void ResourceManager::UnloadAll() {
     UnloadContainer(_textures,        ::UnloadTexture);
-    UnloadContainer(_models,          ::UnloadModel);
-    UnloadContainer(_shaders,         ::UnloadShader);
+    SpriteAtlas::Unload();
+    for (Model& m : _modelStore) ::UnloadModel(m);
+    _modelStore.clear();
+    _modelIds.clear();
+    for (Shader& sh : _shaderStore) ::UnloadShader(sh);
+    _shaderStore.clear();
+    _shaderIds.clear();
     R.UnloadRenderTextures();
     UnloadAllFonts();
     if (_fallbackTex.id) { UnloadTexture(_fallbackTex); _fallbackTex = {}; }
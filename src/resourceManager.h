@@ -4,16 +4,33 @@
 #include "raylib.h"
 #include <stdexcept>
 #include <memory>
+#include <deque>
 #include "dungeonGeneration.h"
 
 
 
+// Interned handles. Resolve a name once (FindModelId/FindShaderId), then Get by handle
+// is a plain index into storage, no string building or hashing. Handles stay valid until
+// UnloadAll(). The string overloads are still there for load time and one-off lookups.
+struct ModelId
+{
+    int index = -1;
+    bool IsValid() const { return index >= 0; }
+};
+
+struct ShaderId
+{
+    int index = -1;
+    bool IsValid() const { return index >= 0; }
+};
+
 class ResourceManager {
 public:
     static ResourceManager& Get();
     
     // Texture
     Texture2D& LoadTexture(const std::string& name, const std::string& path);
+    Texture2D& AddTextureFromImage(const std::string& name, const Image& image, const std::string& path); // path is for error messages
     //Texture2D& GetTexture(const std::string& name) const;
     Texture2D&  GetTexture(const std::string& name);     
     // Model
@@ -23,9 +40,20 @@ public:
 
     Model&      GetModel(const std::string& name);
     const Model& GetModel(const std::string& name) const ;
+    ModelId     FindModelId(const std::string& name) const;      // invalid handle if not loaded
+    Model&      GetModel(ModelId id) {
+        // invalid (not found) or stale (from before UnloadAll) handle, same as a missing name
+        if (!id.IsValid() || id.index >= (int)_modelStore.size()) throw std::runtime_error("Model not found: bad ModelId " + std::to_string(id.index));
+        return _modelStore[id.index];
+    }
     // Shader
     Shader&     LoadShader(const std::string& name, const std::string& vsPath, const std::string& fsPath);
     Shader&     GetShader(const std::string& name) const;
+    ShaderId    FindShaderId(const std::string& name) const;     // invalid handle if not loaded
+    Shader&     GetShader(ShaderId id) const {
+        if (!id.IsValid() || id.index >= (int)_shaderStore.size()) throw std::runtime_error("Shader not found: bad ShaderId " + std::to_string(id.index));
+        return const_cast<Shader&>(_shaderStore[id.index]);
+    }
 
 
     // RenderTexture
@@ -47,7 +75,7 @@ public:
     void UnloadAllFonts();
     void LoadAllResources();
     void SetShaderValues();
-    void UpdateShaders(Camera& camera);
+    void UpdateShaders();
     void SetLightingShaderValues();
     void SetTerrainShaderValues();
 
@@ -69,8 +97,12 @@ private:
 
     // Storage maps
     std::unordered_map<std::string, Texture2D>      _textures;
-    std::unordered_map<std::string, Model>          _models;
-    std::unordered_map<std::string, Shader>         _shaders;
+    // Models and shaders live in deques (stable references, indexable by handle),
+    // the maps only intern name -> index.
+    std::deque<Model>                               _modelStore;
+    std::unordered_map<std::string, int>            _modelIds;
+    std::deque<Shader>                              _shaderStore;
+    std::unordered_map<std::string, int>            _shaderIds;
     std::unordered_map<std::string, std::unique_ptr<RenderTexture2D>> _renderTextures; //render textures need to be resized on fullscreen. use safer method
     std::unordered_map<std::string, Font> _fonts;
 
@@ -1,5 +1,6 @@
 #include "shaderSetup.h"
 #include <cassert>
+#include <vector>
 #include "raymath.h"
 #include "world.h"
 #include "lighting.h"
@@ -17,9 +18,14 @@ namespace ShaderSetup
     CeilingShader     gCeiling;
     SkyCycle          gSkyCycle;
     AlphaCutoutShader gAlpha;
+    PropLightingShader gPropLighting;
     ShadowShader      gShadow;
     WeaponOutlineFx   gOutline;
     JournalShader     gJournal;
+    TerrainShader     gTerrain;
+    FrameUniforms     gFrame;
+
+    static std::vector<FrameUniformLocs> gFrameTargets; //shaders that take the frame-global uniforms
 
     //journal_page.fs shader
 
@@ -116,6 +122,17 @@ namespace ShaderSetup
         shadowQuad.materials[0].shader = sh;
         SetMaterialTexture(&shadowQuad.materials[0], MATERIAL_MAP_DIFFUSE, R.GetTexture("shadowTex"));
 
+        // instanced blob shadows (DrawBlobShadows)
+        ss.instanced = &R.GetShader("shadowInstancedShader");
+        Shader& ish = *ss.instanced;
+        ish.locs[SHADER_LOC_MATRIX_MVP]   = GetShaderLocation(ish, "mvp");
+        ish.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(ish, "instanceTransform");
+        if (ish.locs[SHADER_LOC_MATRIX_MODEL] < 0)
+            TraceLog(LOG_ERROR, "Missing instanceTransform attrib for shadowInstancedShader");
+
+        int loc = GetShaderLocation(ish, "shadowStrength");
+        SetShaderValue(ish, loc, &ss.shadowStrength, SHADER_UNIFORM_FLOAT);
+
 
     }
 
@@ -141,6 +158,22 @@ namespace ShaderSetup
 
     }
 
+    //Prop lighting
+
+    static void CachePropLightingLocations(PropLightingShader& ps)
+    {
+        assert(ps.shader && "Prop lighting shader must be set");
+        Shader& sh = *ps.shader;
+        ps.loc_propAmbientBoost = GetShaderLocation(sh, "propAmbientBoost");
+        ps.loc_maxBrightness    = GetShaderLocation(sh, "maxBrightness");
+    }
+
+    void InitPropLightingShader(PropLightingShader& ps)
+    {
+        ps.shader = &R.GetShader("lightingShader");
+        CachePropLightingLocations(ps);
+    }
+
     //Ceiling
 
     static void SetGridBounds(float outGrid[4])
@@ -271,11 +304,9 @@ namespace ShaderSetup
     }
 
     void UpdateGhostShaderPerFrame(GhostShader& gs){
-        Shader& sh = *gs.shader;
-        gs.nightDarkness = ShaderSetup::gSky.skyTransition;
-        gs.camPos = CameraSystem::Get().Active().position;
-        SetShaderValue(sh, gs.loc_darkness, &gs.nightDarkness, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(sh, gs.loc_viewPos, &gs.camPos, SHADER_UNIFORM_VEC3);
+        //viewPos and nightDarkness are pushed by UpdateFrameUniforms()
+        gs.nightDarkness = gFrame.nightDarkness;
+        gs.camPos = gFrame.cameraPos;
     }
 
 
@@ -296,6 +327,7 @@ namespace ShaderSetup
         ps.loc_rings         = GetShaderLocation(sh, "u_rings");
         ps.loc_glowBoost     = GetShaderLocation(sh, "u_glowBoost");
         ps.portalOpenLoc =    GetShaderLocation(sh, "u_openAmount");
+        ps.loc_tintStrength  = GetShaderLocation(sh, "u_tintStrength");
     
     }
 
@@ -374,11 +406,10 @@ namespace ShaderSetup
         // Note: per-frame uniforms are set in UpdateWaterShaderPerFrame()
     }
 
-    void UpdateWaterShaderPerFrame(WaterShader& ws, float elapsedTime, const Camera& camera)
+    void UpdateWaterShaderPerFrame(WaterShader& ws, const Camera& camera)
     {
         assert(ws.shader && "WaterShader.shader must be initialized");
         Shader& sh = *ws.shader;
-        Vector3 camPos = camera.position;
         // Compute world bounds
         Vector2 worldMin = ws.worldMinXZ;
         Vector2 worldMax = { ws.worldMinXZ.x + ws.worldSizeXZ.x,
@@ -395,28 +426,14 @@ namespace ShaderSetup
             Clamp(camera.position.z, minZ, maxZ)
         };
 
-        float nightT = ShaderSetup::gSky.skyTransition;
-
-        float waterReflectStrength = Lerp(0.15f, 0.65f, nightT);
-        float waterNightDarkness   = nightT;
-
-        Vector3 skyTop     = ShaderSetup::GetCurrentSkyTopFogColor();
-        Vector3 skyHorizon = ShaderSetup::GetCurrentSkyFogColor();
-
-        SetShaderValue(sh, ws.loc_skyColorTop, &skyTop, SHADER_UNIFORM_VEC3);
-        SetShaderValue(sh, ws.loc_skyColorHorz, &skyHorizon, SHADER_UNIFORM_VEC3);
+        //sky colors, night darkness, cameraPos and time come from UpdateFrameUniforms()
+        float waterReflectStrength = Lerp(0.15f, 0.65f, gFrame.nightDarkness);
         SetShaderValue(sh, ws.loc_skyReflectStrength, &waterReflectStrength, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(sh, ws.loc_waterNightDark, &waterNightDarkness, SHADER_UNIFORM_FLOAT);
 
         float patchSize = 14000.0f;
 
         SetShaderValue(sh, ws.loc_PatchHalfSize, &patchSize, SHADER_UNIFORM_FLOAT);
         SetShaderValue(sh, ws.loc_WaterCenterXZ, &centerXZ,       SHADER_UNIFORM_VEC2);
-        SetShaderValue(sh, ws.loc_cameraPos,     &camera.position, SHADER_UNIFORM_VEC3);
-
-        //water shader needs cameraPos for reasons. 
-        SetShaderValue(sh, ws.loc_cameraPos, &camPos, SHADER_UNIFORM_VEC3);
-        SetShaderValue(sh, GetShaderLocation(sh, "time"), &elapsedTime, SHADER_UNIFORM_FLOAT);
         int isSwamp = CurrentLevelIs("Swamp") ? 1 : 0;
         SetShaderValue(sh, ws.loc_isSwamp, &isSwamp, RL_SHADER_UNIFORM_INT);
 
@@ -498,6 +515,8 @@ namespace ShaderSetup
         bs.loc_dungeonDarkness = GetShaderLocation(sh, "dungeonDarkness");
         bs.loc_dungeonContrast = GetShaderLocation(sh, "dungeonContrast");
         bs.loc_isDungeon = GetShaderLocation(sh, "isDungeon");
+        bs.loc_uvScale = GetShaderLocation(sh, "uvScale");
+        bs.loc_sharpenAmount = GetShaderLocation(sh, "sharpenAmount");
 
         bs.loc_letterboxAmount = GetShaderLocation(sh, "letterboxAmount");
         bs.loc_letterboxTarget = GetShaderLocation(sh, "letterboxTarget");
@@ -524,6 +543,8 @@ namespace ShaderSetup
         SetShaderValue(sh, bs.loc_dungeonDarkness, &bs.dungeonDarkness, SHADER_UNIFORM_FLOAT);
         SetShaderValue(sh, bs.loc_dungeonContrast, &bs.dungeonContrast, SHADER_UNIFORM_FLOAT);
         SetShaderValue(sh, bs.loc_isDungeon, &bs.isDungeon, SHADER_UNIFORM_INT);
+        SetShaderValue(sh, bs.loc_uvScale, &bs.uvScale, SHADER_UNIFORM_VEC2);
+        SetShaderValue(sh, bs.loc_sharpenAmount, &bs.sharpenAmount, SHADER_UNIFORM_FLOAT);
 
 
         SetShaderValue(sh, bs.loc_letterboxAmount, &bs.letterboxAmount, SHADER_UNIFORM_FLOAT);
@@ -566,6 +587,16 @@ namespace ShaderSetup
         ApplyBloomParams(bs);
     }
 
+    //called by the render pipeline every frame, the scene size can change per frame with dynamic resolution
+    void SetBloomSceneRegion(BloomShader& bs, Vector2 uvScale, float sharpenAmount)
+    {
+        bs.uvScale = uvScale;
+        bs.sharpenAmount = sharpenAmount;
+        Shader& sh = *bs.shader;
+        SetShaderValue(sh, bs.loc_uvScale, &bs.uvScale, SHADER_UNIFORM_VEC2);
+        SetShaderValue(sh, bs.loc_sharpenAmount, &bs.sharpenAmount, SHADER_UNIFORM_FLOAT);
+    }
+
     void SetBloomTonemap(BloomShader& bs, bool isDungeon, float islandExposure, float dungeonExposure)
     {
         bs.toneOp   = isDungeon ? 1 : 0;
@@ -664,6 +695,9 @@ namespace ShaderSetup
         ss.loc_isSwamp =   GetShaderLocation(sh, "isSwamp");
         ss.loc_isDungeon = GetShaderLocation(sh, "isDungeon");
         ss.skyTransitionLoc = GetShaderLocation(sh, "skyTransition");
+        ss.loc_sunsetHorizon  = GetShaderLocation(sh, "u_SunsetHorizonColor");
+        ss.loc_sunsetZenith   = GetShaderLocation(sh, "u_SunsetZenithColor");
+        ss.loc_sunsetStrength = GetShaderLocation(sh, "u_SunsetStrength");
     }
 
     static void BindSkyShaderToModel(Model& skyModel, Shader& sh)
@@ -696,6 +730,83 @@ namespace ShaderSetup
     }
 
 
+    //Terrain
+    void InitTerrainShader(Shader& shader, TerrainShader& out)
+    {
+        out.shader = &shader;
+
+        out.loc_fogStart    = GetShaderLocation(shader, "u_FogStart");
+        out.loc_shadowMask  = GetShaderLocation(shader, "u_ShadowMask");
+        out.loc_worldMinXZ  = GetShaderLocation(shader, "u_WorldMinXZ");
+        out.loc_worldSizeXZ = GetShaderLocation(shader, "u_WorldSizeXZ");
+    }
+
+    //Frame-global uniforms
+    //first name the shader actually has wins, -1 if none
+    static int FindShaderLocation(const Shader& sh, std::initializer_list<const char*> names)
+    {
+        for (const char* name : names)
+        {
+            int loc = GetShaderLocation(sh, name);
+            if (loc >= 0) return loc;
+        }
+        return -1;
+    }
+
+    static void RegisterFrameUniforms(Shader& sh)
+    {
+        FrameUniformLocs fl;
+        fl.shader = &sh;
+
+        fl.loc_cameraPos     = FindShaderLocation(sh, { "cameraPos", "viewPos" });
+        fl.loc_skyTop        = FindShaderLocation(sh, { "u_SkyColorTop" });
+        fl.loc_skyHorz       = FindShaderLocation(sh, { "u_SkyColorHorizon" });
+        fl.loc_useFog        = FindShaderLocation(sh, { "u_UseFog" });
+        fl.loc_nightDarkness = FindShaderLocation(sh, { "u_ModelNightDarkness", "u_TerrainNightDarkness",
+                                                        "u_WaterNightDarkness", "nightDarkness", "skyTransition" });
+        fl.loc_time          = FindShaderLocation(sh, { "time", "u_time", "uTime" });
+
+        gFrameTargets.push_back(fl);
+    }
+
+    void InitFrameUniforms()
+    {
+        gFrameTargets.clear();
+
+        RegisterFrameUniforms(R.GetShader("terrainShader"));
+        RegisterFrameUniforms(R.GetShader("treeShader"));
+        RegisterFrameUniforms(R.GetShader("tree_instanced"));
+        RegisterFrameUniforms(R.GetShader("waterShader"));
+        RegisterFrameUniforms(R.GetShader("ghostShader"));
+        RegisterFrameUniforms(R.GetShader("skyShader"));
+        RegisterFrameUniforms(R.GetShader("lavaShader"));
+        RegisterFrameUniforms(R.GetShader("portalShader"));
+
+        InitTerrainShader(R.GetShader("terrainShader"), gTerrain);
+    }
+
+    //Call once per frame after the sky transition has been updated.
+    void UpdateFrameUniforms(const Camera& camera, float elapsedTime)
+    {
+        gFrame.cameraPos     = camera.position;
+        gFrame.skyTop        = GetCurrentSkyTopFogColor();
+        gFrame.skyHorz       = GetCurrentSkyFogColor();
+        gFrame.useFog        = GameSettings::useFog ? 1 : 0;
+        gFrame.nightDarkness = gSky.skyTransition;
+        gFrame.time          = elapsedTime;
+
+        for (FrameUniformLocs& fl : gFrameTargets)
+        {
+            Shader& sh = *fl.shader;
+            if (fl.loc_cameraPos >= 0)     SetShaderValue(sh, fl.loc_cameraPos,     &gFrame.cameraPos,     SHADER_UNIFORM_VEC3);
+            if (fl.loc_skyTop >= 0)        SetShaderValue(sh, fl.loc_skyTop,        &gFrame.skyTop,        SHADER_UNIFORM_VEC3);
+            if (fl.loc_skyHorz >= 0)       SetShaderValue(sh, fl.loc_skyHorz,       &gFrame.skyHorz,       SHADER_UNIFORM_VEC3);
+            if (fl.loc_useFog >= 0)        SetShaderValue(sh, fl.loc_useFog,        &gFrame.useFog,        SHADER_UNIFORM_INT);
+            if (fl.loc_nightDarkness >= 0) SetShaderValue(sh, fl.loc_nightDarkness, &gFrame.nightDarkness, SHADER_UNIFORM_FLOAT);
+            if (fl.loc_time >= 0)          SetShaderValue(sh, fl.loc_time,          &gFrame.time,          SHADER_UNIFORM_FLOAT);
+        }
+    }
+
     //UPDATE
 
     void UpdateBloomShaderPerFrame(BloomShader& bs, float dt){
@@ -720,42 +831,13 @@ namespace ShaderSetup
                     &bs.letterboxSoftness, SHADER_UNIFORM_FLOAT);
     }
 
-    void UpdateLavaShaderPerFrame(LavaShader& ls, float t, bool isLoadingLevel)
-    {
-        if (isLoadingLevel) return;
-        assert(ls.shader && "LavaShader must be initialized before updating");
-
-        Shader& sh = *ls.shader;
-        SetShaderValue(sh, ls.locTime, &t, SHADER_UNIFORM_FLOAT);
-    }
-
-    void UpdatePortalShader(float t){
-        Shader& portalShader = R.GetShader("portalShader");
-        int loc_time_p = GetShaderLocation(R.GetShader("portalShader"), "u_time");
-        //portal
-        SetShaderValue(portalShader, loc_time_p, &t, SHADER_UNIFORM_FLOAT);
-
-        //need spawners
-
-    }
-
-    void UpdateTreeShader(TreeShader& ts,  Camera& camera){
-        Shader& treeShader = R.GetShader("treeShader");
-        Vector3 camPos = camera.position;
-        
-        ts.useFog = GameSettings::useFog;
-        ts.nightDarkness = ShaderSetup::gSky.skyTransition;
-        ts.skyHorz = ShaderSetup::GetCurrentSkyFogColor();
-        ts.skyTop  = ShaderSetup::GetCurrentSkyTopFogColor();
-
-        SetShaderValue(treeShader,   ts.loc_cam,   &camPos, SHADER_UNIFORM_VEC3);
-        SetShaderValue(treeShader, ts.loc_useFog, &ts.useFog, SHADER_UNIFORM_INT);
-        SetShaderValue(treeShader, ts.loc_darkenss, &ts.nightDarkness, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(treeShader, ts.loc_skyHorz, &ts.skyHorz, SHADER_UNIFORM_VEC3);
-        SetShaderValue(treeShader, ts.loc_skyTop, &ts.skyTop, SHADER_UNIFORM_VEC3);
-
- 
-        
+    void UpdateTreeShader(TreeShader& ts){
+        //keep the stored params in sync so ApplyTreeFogParams() re-applies current values.
+        //the uniforms themselves are pushed by UpdateFrameUniforms()
+        ts.useFog = gFrame.useFog;
+        ts.nightDarkness = gFrame.nightDarkness;
+        ts.skyHorz = gFrame.skyHorz;
+        ts.skyTop  = gFrame.skyTop;
     }
 
     void UpdateSkyShaderPerFrame(SkyShader& ss, float timeSeconds)
@@ -764,23 +846,16 @@ namespace ShaderSetup
         Shader& sh = *ss.shader;
 
         //ss.skyTransition = 0.5f + 0.5f * sinf(GetTime() * 0.25f);
+        //time and skyTransition are pushed by UpdateFrameUniforms()
         ss.timeSec = timeSeconds;
-        SetShaderValue(sh, ss.loc_time, &ss.timeSec, SHADER_UNIFORM_FLOAT);
-
-        SetShaderValue(
-            sh,
-            ss.skyTransitionLoc,
-            &ss.skyTransition,
-            SHADER_UNIFORM_FLOAT
-        );
 
-        SetShaderValue(sh, GetShaderLocation(sh, "u_SunsetHorizonColor"),
+        SetShaderValue(sh, ss.loc_sunsetHorizon,
                     &ss.sunsetHorizon, SHADER_UNIFORM_VEC3);
 
-        SetShaderValue(sh, GetShaderLocation(sh, "u_SunsetZenithColor"),
+        SetShaderValue(sh, ss.loc_sunsetZenith,
                     &ss.sunsetZenith, SHADER_UNIFORM_VEC3);
 
-        SetShaderValue(sh, GetShaderLocation(sh, "u_SunsetStrength"),
+        SetShaderValue(sh, ss.loc_sunsetStrength,
                     &ss.sunsetStrength, SHADER_UNIFORM_FLOAT);
 
 
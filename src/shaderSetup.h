@@ -40,6 +40,7 @@ namespace ShaderSetup
     struct ShadowShader 
     {
         Shader* shader = nullptr;
+        Shader* instanced = nullptr; // same fragment shader, instanceTransform per blob
 
         int loc_strength = -1;
 
@@ -56,6 +57,14 @@ namespace ShaderSetup
         float alphaCutoff = 0.0f;;
     };
 
+    struct PropLightingShader
+    {
+        Shader* shader = nullptr; // lightingShader, per prop ambient / brightness
+
+        int loc_propAmbientBoost = -1;
+        int loc_maxBrightness    = -1;
+    };
+
     struct CeilingShader 
     {
         Shader* shader = nullptr;
@@ -121,6 +130,7 @@ namespace ShaderSetup
         int loc_glowBoost     = -1;
 
         int portalOpenLoc     = -1;
+        int loc_tintStrength  = -1;
 
         // Optional: keep defaults here so you can re-apply them easily (hot reload, reset, etc.)
         float speed         = 1.4f;
@@ -224,12 +234,16 @@ namespace ShaderSetup
         int loc_dungeonDarkness = -1;
         int loc_dungeonContrast = -1;
         int loc_isDungeon = -1;
+        int loc_uvScale = -1;
+        int loc_sharpenAmount = -1;
 
         // Stored params (so you can re-apply easily)]
         float   bloomStrength = 0.0f;
         float   exposure      = 1.0f;
         int     toneOp        = 0; // 0 = island, 1 = dungeon (based on your code)
         Vector2 resolution    = { 0, 0 };
+        Vector2 uvScale       = { 1, 1 }; // corner of sceneTexture the scene filled (dynamic resolution)
+        float   sharpenAmount = 0.0f;     // unsharp mask for upscaled frames
 
         int vignetteMode;
         float vignetteStrengthValue;
@@ -284,6 +298,9 @@ namespace ShaderSetup
         int loc_isSwamp   = -1;
         int loc_isDungeon = -1;
         int skyTransitionLoc = -1;
+        int loc_sunsetHorizon  = -1;
+        int loc_sunsetZenith   = -1;
+        int loc_sunsetStrength = -1;
 
         // Stored params
         int   isSwamp = 0;   // 0/1
@@ -307,6 +324,41 @@ namespace ShaderSetup
         float timeSec   = 0.0f;
     };
 
+    struct TerrainShader
+    {
+        Shader* shader = nullptr;
+
+        // Cached locations (the frame-global ones live in FrameUniformLocs)
+        int loc_fogStart    = -1;
+        int loc_shadowMask  = -1;
+        int loc_worldMinXZ  = -1;
+        int loc_worldSizeXZ = -1;
+    };
+
+    // Values every world shader wants once per frame. Computed once in UpdateFrameUniforms()
+    // and pushed to each registered shader with locations resolved at load time.
+    struct FrameUniforms
+    {
+        Vector3 cameraPos = {0, 0, 0};
+        Vector3 skyTop    = {0.55f, 0.75f, 1.00f};
+        Vector3 skyHorz   = {0.60f, 0.80f, 0.95f};
+        int   useFog        = 1;
+        float nightDarkness = 0.0f; // gSky.skyTransition
+        float time          = 0.0f;
+    };
+
+    struct FrameUniformLocs
+    {
+        Shader* shader = nullptr;
+
+        int loc_cameraPos     = -1;
+        int loc_skyTop        = -1;
+        int loc_skyHorz       = -1;
+        int loc_useFog        = -1;
+        int loc_nightDarkness = -1;
+        int loc_time          = -1;
+    };
+
     struct SkyCycle
     {
         bool active = false;
@@ -334,9 +386,19 @@ namespace ShaderSetup
     extern GhostShader gGhost;
     extern CeilingShader gCeiling;
     extern AlphaCutoutShader gAlpha;
+    extern PropLightingShader gPropLighting;
     extern ShadowShader gShadow;
     extern WeaponOutlineFx gOutline;
     extern JournalShader   gJournal;
+    extern TerrainShader   gTerrain;
+    extern FrameUniforms   gFrame;
+
+    //frame-global uniforms, registered once after shaders load
+    void InitFrameUniforms();
+    void UpdateFrameUniforms(const Camera& camera, float elapsedTime);
+
+    //terrain
+    void InitTerrainShader(Shader& shader, TerrainShader& out);
 
     //sky shader
     void InitSkyShader(Shader& shader, SkyShader& out, Model& skyModel, bool isDungeon);
@@ -352,6 +414,7 @@ namespace ShaderSetup
     void InitBloomShader(Shader& shader, BloomShader& out);
     void ApplyBloomParams(BloomShader& bs);
     void SetBloomResolution(BloomShader& bs, int screenW, int screenH);
+    void SetBloomSceneRegion(BloomShader& bs, Vector2 uvScale, float sharpenAmount);
     void SetBloomTonemap(BloomShader& bs, bool isDungeon, float islandExposure, float dungeonExposure);
     void SetBloomStrength(BloomShader& bs, float strength);
     void UpdateBloomShaderPerFrame(BloomShader& bs, float dt);
@@ -365,6 +428,9 @@ namespace ShaderSetup
     //dungeon billboard cutout shader. 
     void InitAlphaCutout(AlphaCutoutShader& as);
 
+    //dungeon props on the lighting shader
+    void InitPropLightingShader(PropLightingShader& ps);
+
     //Ceiling lighting
     void InitCeilingShader(CeilingShader& cs); //we need an update for dynamic lights. 
 
@@ -378,12 +444,10 @@ namespace ShaderSetup
 
     //Lava shader
     void InitLavaShader(Shader& shader, LavaShader& out, Model& lavaTileModel);
-    void UpdateLavaShaderPerFrame(LavaShader& ls, float t, bool isLoadingLevel);
-    void UpdatePortalShader(float t);
-    void UpdateTreeShader(TreeShader& ts, Camera& camera);
+    void UpdateTreeShader(TreeShader& ts);
     //WaterShader
     void InitWaterShader(Shader& shader, WaterShader& out, Vector3 terrainScale);
-    void UpdateWaterShaderPerFrame(WaterShader& ws, float elapsedTime, const Camera& camera);
+    void UpdateWaterShaderPerFrame(WaterShader& ws, const Camera& camera);
 
     void UpdateSkyCycle(float dt);
     void StartSkyCycle(float dayHold, float nightHold, float transitionDuration, float nightAmount);
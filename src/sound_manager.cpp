@@ -1,6 +1,8 @@
 #include "sound_manager.h"
 #include <iostream>
 #include "raymath.h"
+#include "utilities.h"
+#include "asset_loader.h"
 
 
 void SoundManager::InitMusic()
@@ -18,7 +20,7 @@ void SoundManager::InitMusic()
 int SoundManager::PickRandomIndexNoRepeat(int count, int lastIndex)
 {
     if (count <= 1) return 0;
-    int idx = GetRandomValue(0, count - 1);
+    int idx = RandomInt(0, count - 1);
     if (idx == lastIndex) {
         idx = (idx + 1) % count; // cheap no-repeat
     }
@@ -130,7 +132,7 @@ void SoundManager::UpdateSpeech(float dt)
         st.timeLeft -= 1.0f;
 
         // Small natural gap between syllables
-        st.pauseTimer = (float)GetRandomValue(6, 18) / 100.0f; // 0.06..0.18
+        st.pauseTimer = (float)RandomInt(6, 18) / 100.0f; // 0.06..0.18
 
         ++it;
     }
@@ -147,6 +149,16 @@ void SoundManager::LoadSound(const std::string& name, const std::string& filePat
     sounds[name] = sound;
 }
 
+// Upload half of LoadSound, for waves decoded off the main thread (see AssetLoader)
+void SoundManager::AddSoundFromWave(const std::string& name, const Wave& wave, const std::string& filePath) {
+    if (wave.data == nullptr) {
+        std::cerr << "Failed to load sound: " << name << " (" << filePath << ")" << std::endl;
+        sounds[name] = {};
+        return;
+    }
+    sounds[name] = LoadSoundFromWave(wave);
+}
+
 void SoundManager::LoadMusic(const std::string& name, const std::string& filePath) {
     Music music = LoadMusicStream(filePath.c_str());
     musicTracks[name] = music;
@@ -257,111 +269,111 @@ void SoundManager::UnloadAll() {
 }
 
 void SoundManager::LoadSounds() {
-    //Sounds
-    SoundManager::GetInstance().LoadSound("dinoHit", "assets/sounds/dinoHit.ogg");
-    SoundManager::GetInstance().LoadSound("dinoDeath", "assets/sounds/dinoDeath.ogg");
-    SoundManager::GetInstance().LoadSound("dinoTweet", "assets/sounds/dino1.ogg");
-    SoundManager::GetInstance().LoadSound("dinoTarget", "assets/sounds/dino2.ogg");
-    SoundManager::GetInstance().LoadSound("dinoTweet2", "assets/sounds/dino3.ogg");
-    SoundManager::GetInstance().LoadSound("dinoBite", "assets/sounds/bite.ogg");
-    SoundManager::GetInstance().LoadSound("reload", "assets/sounds/reload.ogg");
-    SoundManager::GetInstance().LoadSound("shotgun", "assets/sounds/shotgun.ogg");
-    SoundManager::GetInstance().LoadSound("doubleShot", "assets/sounds/doubleShot.ogg");
-
-    SoundManager::GetInstance().LoadSound("step1", "assets/sounds/step1.ogg");
-    SoundManager::GetInstance().LoadSound("step2", "assets/sounds/step2.ogg");
-    SoundManager::GetInstance().LoadSound("step3", "assets/sounds/step3.ogg");
-    SoundManager::GetInstance().LoadSound("step4", "assets/sounds/step4.ogg");
-
-    SoundManager::GetInstance().LoadSound("phit1", "assets/sounds/PlayerHit1.ogg");
-    SoundManager::GetInstance().LoadSound("phit2", "assets/sounds/PlayerHit2.ogg");
-
-    SoundManager::GetInstance().LoadSound("doorOpen", "assets/sounds/doorOpen.ogg");
-    SoundManager::GetInstance().LoadSound("doorClose", "assets/sounds/doorCLose.ogg");
-    SoundManager::GetInstance().LoadSound("swipe1", "assets/sounds/swipe1.ogg");
-    SoundManager::GetInstance().LoadSound("swipe2", "assets/sounds/swipe2.ogg");
-    SoundManager::GetInstance().LoadSound("swipe3", "assets/sounds/swipe3.ogg");
-    SoundManager::GetInstance().LoadSound("swordHit", "assets/sounds/swordHit.ogg");
-    SoundManager::GetInstance().LoadSound("swordBlock", "assets/sounds/swordBlock.ogg");
-    SoundManager::GetInstance().LoadSound("swordBlock2", "assets/sounds/swordBlock2.ogg");
-    SoundManager::GetInstance().LoadSound("slice", "assets/sounds/slice.ogg");
-    SoundManager::GetInstance().LoadSound("bones", "assets/sounds/bones.ogg");
-    SoundManager::GetInstance().LoadSound("bones2", "assets/sounds/bones2.ogg");
-    SoundManager::GetInstance().LoadSound("gulp", "assets/sounds/gulp.ogg");
-    SoundManager::GetInstance().LoadSound("clink", "assets/sounds/clink.ogg");
-    SoundManager::GetInstance().LoadSound("lockedDoor", "assets/sounds/lockedDoor.ogg");
-    SoundManager::GetInstance().LoadSound("unlock", "assets/sounds/unlock.ogg");
-    SoundManager::GetInstance().LoadSound("key", "assets/sounds/KeyGet.ogg");
-    SoundManager::GetInstance().LoadSound("barrelBreak", "assets/sounds/barrelBreak.ogg");
-    SoundManager::GetInstance().LoadSound("musket", "assets/sounds/musket.ogg");
-    SoundManager::GetInstance().LoadSound("chestOpen", "assets/sounds/chestOpen.ogg");
-    SoundManager::GetInstance().LoadSound("spiderBite1", "assets/sounds/spiderBite1.ogg");
-    SoundManager::GetInstance().LoadSound("spiderBite2", "assets/sounds/spiderBite2.ogg");
-    SoundManager::GetInstance().LoadSound("spiderDeath", "assets/sounds/spiderDeath.ogg");
-    SoundManager::GetInstance().LoadSound("spiderDeath2", "assets/sounds/spiderDeath2.ogg");
-    SoundManager::GetInstance().LoadSound("spiderChase", "assets/sounds/spiderChase.ogg");
-    SoundManager::GetInstance().LoadSound("spiderChase2", "assets/sounds/spiderChase2.ogg");
-    SoundManager::GetInstance().LoadSound("flame1", "assets/sounds/flame1.ogg");
-    SoundManager::GetInstance().LoadSound("flame2", "assets/sounds/flame2.ogg");
-    SoundManager::GetInstance().LoadSound("explosion", "assets/sounds/explosion.ogg");
-    SoundManager::GetInstance().LoadSound("staffHit", "assets/sounds/staffHit.ogg");
-    SoundManager::GetInstance().LoadSound("iceMagic", "assets/sounds/iceMagic.ogg");
-    SoundManager::GetInstance().LoadSound("jump", "assets/sounds/jump.ogg");
-    SoundManager::GetInstance().LoadSound("harpoon", "assets/sounds/harpoon.ogg");
-    SoundManager::GetInstance().LoadSound("ratchet", "assets/sounds/ratchet.ogg");
-    SoundManager::GetInstance().LoadSound("giantSpiderBite", "assets/sounds/monsterBite.ogg");
-    SoundManager::GetInstance().LoadSound("pirateDeath", "assets/sounds/pirateDeath.ogg");
-    SoundManager::GetInstance().LoadSound("deathScream", "assets/sounds/deathScream.ogg");
-    SoundManager::GetInstance().LoadSound("batDamage", "assets/sounds/batDamage.ogg");
-    SoundManager::GetInstance().LoadSound("portal", "assets/sounds/portal.ogg");
-    SoundManager::GetInstance().LoadSound("portal2", "assets/sounds/portal2.ogg");
-    SoundManager::GetInstance().LoadSound("floorSwitch", "assets/sounds/floorSwitch.ogg");
-    SoundManager::GetInstance().LoadSound("floorSwitchUnpress", "assets/sounds/floorSwitchUnpress.ogg");
-    SoundManager::GetInstance().LoadSound("woodThud", "assets/sounds/woodThud.ogg");
-
-    SoundManager::GetInstance().LoadSound("skeletonGrunt", "assets/sounds/skeletonGrunt.ogg");
-    SoundManager::GetInstance().LoadSound("skeletonGrunt2", "assets/sounds/skeletonGrunt2.ogg");
-    SoundManager::GetInstance().LoadSound("pirateYell1", "assets/sounds/pirate1.ogg");
-    SoundManager::GetInstance().LoadSound("pirateYell2", "assets/sounds/pirate2.ogg");
-
-    SoundManager::GetInstance().LoadSound("zombieMoan1", "assets/sounds/ZombieMoan1.ogg");
-    SoundManager::GetInstance().LoadSound("zombieMoan2", "assets/sounds/ZombieMoan2.ogg");
-    SoundManager::GetInstance().LoadSound("zombieHit1", "assets/sounds/ZombieHit1.ogg");
-    SoundManager::GetInstance().LoadSound("zombieHit2", "assets/sounds/ZombieHit2.ogg");
-    SoundManager::GetInstance().LoadSound("zombieDeath", "assets/sounds/zombieDeath.ogg");
-    SoundManager::GetInstance().LoadSound("zombieStab", "assets/sounds/stab.ogg");
-
-
-    SoundManager::GetInstance().LoadSound("swim1", "assets/sounds/swim1.ogg");
-    SoundManager::GetInstance().LoadSound("swim2", "assets/sounds/swim2.ogg");
-    SoundManager::GetInstance().LoadSound("swim3", "assets/sounds/swim3.ogg");
-    SoundManager::GetInstance().LoadSound("swim4", "assets/sounds/swim4.ogg");
-
-    SoundManager::GetInstance().LoadSound("TrexRoar",       "assets/sounds/TrexRoar.ogg");
-    SoundManager::GetInstance().LoadSound("TrexRoar2",      "assets/sounds/TrexRoar2.ogg");
-    SoundManager::GetInstance().LoadSound("TrexBite",       "assets/sounds/TrexBite.ogg");
-    SoundManager::GetInstance().LoadSound("TrexBite2",      "assets/sounds/TrexBite2.ogg");
-    SoundManager::GetInstance().LoadSound("TrexHurt",       "assets/sounds/TrexHurt.ogg");
-    SoundManager::GetInstance().LoadSound("TrexHurt2",      "assets/sounds/TrexHurt2.ogg");
-    SoundManager::GetInstance().LoadSound("TrexStep",       "assets/sounds/TrexStep.ogg");
-    SoundManager::GetInstance().LoadSound("eggHatch",       "assets/sounds/eggHatch.ogg");
-    SoundManager::GetInstance().LoadSound("squish",         "assets/sounds/squish.ogg");
-    SoundManager::GetInstance().LoadSound("crossbowFire",   "assets/sounds/crossbowFire.ogg");
-    SoundManager::GetInstance().LoadSound("crossbowReload", "assets/sounds/crossbowReload.ogg");
-    SoundManager::GetInstance().LoadSound("overHealth",     "assets/sounds/healthUp.ogg");
-    SoundManager::GetInstance().LoadSound("CannonShot",     "assets/sounds/CannonShot.ogg");
-    SoundManager::GetInstance().LoadSound("tentacleSlam",   "assets/sounds/tentacleSlam.ogg");
+    //Sounds are queued, AssetLoader::Flush() decodes them on worker threads
+    AssetLoader::QueueSound("dinoHit", "assets/sounds/dinoHit.ogg");
+    AssetLoader::QueueSound("dinoDeath", "assets/sounds/dinoDeath.ogg");
+    AssetLoader::QueueSound("dinoTweet", "assets/sounds/dino1.ogg");
+    AssetLoader::QueueSound("dinoTarget", "assets/sounds/dino2.ogg");
+    AssetLoader::QueueSound("dinoTweet2", "assets/sounds/dino3.ogg");
+    AssetLoader::QueueSound("dinoBite", "assets/sounds/bite.ogg");
+    AssetLoader::QueueSound("reload", "assets/sounds/reload.ogg");
+    AssetLoader::QueueSound("shotgun", "assets/sounds/shotgun.ogg");
+    AssetLoader::QueueSound("doubleShot", "assets/sounds/doubleShot.ogg");
+
+    AssetLoader::QueueSound("step1", "assets/sounds/step1.ogg");
+    AssetLoader::QueueSound("step2", "assets/sounds/step2.ogg");
+    AssetLoader::QueueSound("step3", "assets/sounds/step3.ogg");
+    AssetLoader::QueueSound("step4", "assets/sounds/step4.ogg");
+
+    AssetLoader::QueueSound("phit1", "assets/sounds/PlayerHit1.ogg");
+    AssetLoader::QueueSound("phit2", "assets/sounds/PlayerHit2.ogg");
+
+    AssetLoader::QueueSound("doorOpen", "assets/sounds/doorOpen.ogg");
+    AssetLoader::QueueSound("doorClose", "assets/sounds/doorCLose.ogg");
+    AssetLoader::QueueSound("swipe1", "assets/sounds/swipe1.ogg");
+    AssetLoader::QueueSound("swipe2", "assets/sounds/swipe2.ogg");
+    AssetLoader::QueueSound("swipe3", "assets/sounds/swipe3.ogg");
+    AssetLoader::QueueSound("swordHit", "assets/sounds/swordHit.ogg");
+    AssetLoader::QueueSound("swordBlock", "assets/sounds/swordBlock.ogg");
+    AssetLoader::QueueSound("swordBlock2", "assets/sounds/swordBlock2.ogg");
+    AssetLoader::QueueSound("slice", "assets/sounds/slice.ogg");
+    AssetLoader::QueueSound("bones", "assets/sounds/bones.ogg");
+    AssetLoader::QueueSound("bones2", "assets/sounds/bones2.ogg");
+    AssetLoader::QueueSound("gulp", "assets/sounds/gulp.ogg");
+    AssetLoader::QueueSound("clink", "assets/sounds/clink.ogg");
+    AssetLoader::QueueSound("lockedDoor", "assets/sounds/lockedDoor.ogg");
+    AssetLoader::QueueSound("unlock", "assets/sounds/unlock.ogg");
+    AssetLoader::QueueSound("key", "assets/sounds/KeyGet.ogg");
+    AssetLoader::QueueSound("barrelBreak", "assets/sounds/barrelBreak.ogg");
+    AssetLoader::QueueSound("musket", "assets/sounds/musket.ogg");
+    AssetLoader::QueueSound("chestOpen", "assets/sounds/chestOpen.ogg");
+    AssetLoader::QueueSound("spiderBite1", "assets/sounds/spiderBite1.ogg");
+    AssetLoader::QueueSound("spiderBite2", "assets/sounds/spiderBite2.ogg");
+    AssetLoader::QueueSound("spiderDeath", "assets/sounds/spiderDeath.ogg");
+    AssetLoader::QueueSound("spiderDeath2", "assets/sounds/spiderDeath2.ogg");
+    AssetLoader::QueueSound("spiderChase", "assets/sounds/spiderChase.ogg");
+    AssetLoader::QueueSound("spiderChase2", "assets/sounds/spiderChase2.ogg");
+    AssetLoader::QueueSound("flame1", "assets/sounds/flame1.ogg");
+    AssetLoader::QueueSound("flame2", "assets/sounds/flame2.ogg");
+    AssetLoader::QueueSound("explosion", "assets/sounds/explosion.ogg");
+    AssetLoader::QueueSound("staffHit", "assets/sounds/staffHit.ogg");
+    AssetLoader::QueueSound("iceMagic", "assets/sounds/iceMagic.ogg");
+    AssetLoader::QueueSound("jump", "assets/sounds/jump.ogg");
+    AssetLoader::QueueSound("harpoon", "assets/sounds/harpoon.ogg");
+    AssetLoader::QueueSound("ratchet", "assets/sounds/ratchet.ogg");
+    AssetLoader::QueueSound("giantSpiderBite", "assets/sounds/monsterBite.ogg");
+    AssetLoader::QueueSound("pirateDeath", "assets/sounds/pirateDeath.ogg");
+    AssetLoader::QueueSound("deathScream", "assets/sounds/deathScream.ogg");
+    AssetLoader::QueueSound("batDamage", "assets/sounds/batDamage.ogg");
+    AssetLoader::QueueSound("portal", "assets/sounds/portal.ogg");
+    AssetLoader::QueueSound("portal2", "assets/sounds/portal2.ogg");
+    AssetLoader::QueueSound("floorSwitch", "assets/sounds/floorSwitch.ogg");
+    AssetLoader::QueueSound("floorSwitchUnpress", "assets/sounds/floorSwitchUnpress.ogg");
+    AssetLoader::QueueSound("woodThud", "assets/sounds/woodThud.ogg");
+
+    AssetLoader::QueueSound("skeletonGrunt", "assets/sounds/skeletonGrunt.ogg");
+    AssetLoader::QueueSound("skeletonGrunt2", "assets/sounds/skeletonGrunt2.ogg");
+    AssetLoader::QueueSound("pirateYell1", "assets/sounds/pirate1.ogg");
+    AssetLoader::QueueSound("pirateYell2", "assets/sounds/pirate2.ogg");
+
+    AssetLoader::QueueSound("zombieMoan1", "assets/sounds/ZombieMoan1.ogg");
+    AssetLoader::QueueSound("zombieMoan2", "assets/sounds/ZombieMoan2.ogg");
+    AssetLoader::QueueSound("zombieHit1", "assets/sounds/ZombieHit1.ogg");
+    AssetLoader::QueueSound("zombieHit2", "assets/sounds/ZombieHit2.ogg");
+    AssetLoader::QueueSound("zombieDeath", "assets/sounds/zombieDeath.ogg");
+    AssetLoader::QueueSound("zombieStab", "assets/sounds/stab.ogg");
+
+
+    AssetLoader::QueueSound("swim1", "assets/sounds/swim1.ogg");
+    AssetLoader::QueueSound("swim2", "assets/sounds/swim2.ogg");
+    AssetLoader::QueueSound("swim3", "assets/sounds/swim3.ogg");
+    AssetLoader::QueueSound("swim4", "assets/sounds/swim4.ogg");
+
+    AssetLoader::QueueSound("TrexRoar",       "assets/sounds/TrexRoar.ogg");
+    AssetLoader::QueueSound("TrexRoar2",      "assets/sounds/TrexRoar2.ogg");
+    AssetLoader::QueueSound("TrexBite",       "assets/sounds/TrexBite.ogg");
+    AssetLoader::QueueSound("TrexBite2",      "assets/sounds/TrexBite2.ogg");
+    AssetLoader::QueueSound("TrexHurt",       "assets/sounds/TrexHurt.ogg");
+    AssetLoader::QueueSound("TrexHurt2",      "assets/sounds/TrexHurt2.ogg");
+    AssetLoader::QueueSound("TrexStep",       "assets/sounds/TrexStep.ogg");
+    AssetLoader::QueueSound("eggHatch",       "assets/sounds/eggHatch.ogg");
+    AssetLoader::QueueSound("squish",         "assets/sounds/squish.ogg");
+    AssetLoader::QueueSound("crossbowFire",   "assets/sounds/crossbowFire.ogg");
+    AssetLoader::QueueSound("crossbowReload", "assets/sounds/crossbowReload.ogg");
+    AssetLoader::QueueSound("overHealth",     "assets/sounds/healthUp.ogg");
+    AssetLoader::QueueSound("CannonShot",     "assets/sounds/CannonShot.ogg");
+    AssetLoader::QueueSound("tentacleSlam",   "assets/sounds/tentacleSlam.ogg");
 
     //speech
-    SoundManager::GetInstance().LoadSound("hermitTalk1", "assets/sounds/AlienVoice1.ogg");
-    SoundManager::GetInstance().LoadSound("hermitTalk2", "assets/sounds/AlienVoice2.ogg");
-    SoundManager::GetInstance().LoadSound("hermitTalk3", "assets/sounds/AlienVoice3.ogg");
-    SoundManager::GetInstance().LoadSound("hermitTalk4", "assets/sounds/AlienVoice4.ogg");
-    SoundManager::GetInstance().LoadSound("hermitTalk5", "assets/sounds/AlienVoice5.ogg");
-    SoundManager::GetInstance().LoadSound("hermitTalk6", "assets/sounds/AlienVoice6.ogg");
-
-    SoundManager::GetInstance().LoadSound("QuadDamage",  "assets/sounds/QuadDamage.ogg");
-    SoundManager::GetInstance().LoadSound("Haste",       "assets/sounds/haste.ogg");
+    AssetLoader::QueueSound("hermitTalk1", "assets/sounds/AlienVoice1.ogg");
+    AssetLoader::QueueSound("hermitTalk2", "assets/sounds/AlienVoice2.ogg");
+    AssetLoader::QueueSound("hermitTalk3", "assets/sounds/AlienVoice3.ogg");
+    AssetLoader::QueueSound("hermitTalk4", "assets/sounds/AlienVoice4.ogg");
+    AssetLoader::QueueSound("hermitTalk5", "assets/sounds/AlienVoice5.ogg");
+    AssetLoader::QueueSound("hermitTalk6", "assets/sounds/AlienVoice6.ogg");
+
+    AssetLoader::QueueSound("QuadDamage",  "assets/sounds/QuadDamage.ogg");
+    AssetLoader::QueueSound("Haste",       "assets/sounds/haste.ogg");
 
     SoundManager::GetInstance().RegisterSpeechBank("hermitSpeech", {
         "hermitTalk1","hermitTalk2","hermitTalk3",
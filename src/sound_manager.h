@@ -14,6 +14,7 @@ public:
     void Update(float dt); // Call this every frame
     Music& GetMusic(const std::string& name);
     void LoadSound(const std::string& name, const std::string& filePath);
+    void AddSoundFromWave(const std::string& name, const Wave& wave, const std::string& filePath);
     Sound GetSound(const std::string& name);
     void Play(const std::string& name);
     void Stop(const std::string& name);
@@ -47,7 +47,7 @@ namespace SpawnManager
             startCutscene = true;
             Cutscenes::StartKrakenScene();
             gKraken.Rise();
-            for (Tentacle t : tentacles){
+            for (Tentacle& t : tentacles){
                 t.Rise();
             }
 
@@ -108,8 +108,7 @@ namespace SpawnManager
                         skeleton.spawnSource = SpawnSource::Spawner;
                         skeleton.maxHealth = 200;
                         skeleton.currentHealth = 200; //at least 2 shots. 4 sword swings 
-                        skeleton.id = gEnemyCounter++;
-                        enemies.push_back(skeleton);
+                        enemies.Add(skeleton);
                         spawner.portalTimer = 2.0f; // show portal 2 seconds after spawning. 
                         break;
                     }
@@ -129,8 +128,7 @@ namespace SpawnManager
                         pirate.spawnSource = SpawnSource::Spawner;
                         pirate.maxHealth = 400; // twice as tough as skeletons, at least 3 shots. 8 slices.
                         pirate.currentHealth = 400;
-                        pirate.id = gEnemyCounter++;
-                        enemies.push_back(pirate);
+                        enemies.Add(pirate);
                         spawner.portalTimer = 2.0f; // show portal 2 seconds after spawning. 
                     }
 
@@ -0,0 +1,184 @@
+#include "sprite_atlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include "load_timer.h"
+
+namespace SpriteAtlas
+{
+    static constexpr int PAGE_SIZE = 4096;
+    static constexpr int MAX_PAGES = 4;
+    static constexpr int GUTTER = 2;                     // px of transparent border around each sheet
+    static constexpr int MAX_SHEET_HEIGHT = PAGE_SIZE / 2; // taller sheets are a draw of their own anyway
+
+    struct Pending
+    {
+        unsigned int textureId = 0;
+        std::string path;
+        Image image = {};
+    };
+
+    struct Entry
+    {
+        int page = 0;
+        int x = 0;
+        int y = 0;
+    };
+
+    struct Shelf
+    {
+        int y = 0;
+        int height = 0;
+        int x = 0;
+    };
+
+    struct Page
+    {
+        Image image = {};
+        Texture2D texture = {};
+        std::vector<Shelf> shelves;
+        int nextY = 0;
+    };
+
+    static std::vector<Pending> gPending;
+    static std::vector<Page> gPages;
+    static std::unordered_map<unsigned int, Entry> gEntries; // original texture id -> place in the atlas
+
+    bool Collect(const Texture2D& texture, const std::string& path, Image& image)
+    {
+        if (texture.id == 0 || image.data == nullptr) return false;
+        if (path.rfind("assets/sprites/", 0) != 0) return false;
+        if (image.width + GUTTER * 2 > PAGE_SIZE || image.height > MAX_SHEET_HEIGHT) return false;
+
+        gPending.push_back({ texture.id, path, image });
+        image = {};
+        return true;
+    }
+
+    // Best fitting shelf with room, else a new shelf, else false.
+    static bool PlaceOnPage(Page& page, int w, int h, int& outX, int& outY)
+    {
+        Shelf* best = nullptr;
+        for (Shelf& s : page.shelves)
+        {
+            if (s.height < h || s.x + w > PAGE_SIZE) continue;
+            if (!best || s.height < best->height) best = &s;
+        }
+
+        if (!best)
+        {
+            if (page.nextY + h > PAGE_SIZE) return false;
+            page.shelves.push_back({ page.nextY, h, 0 });
+            page.nextY += h;
+            best = &page.shelves.back();
+        }
+
+        outX = best->x;
+        outY = best->y;
+        best->x += w;
+        return true;
+    }
+
+    static void CopyInto(Image& page, const Image& sheet, int x, int y)
+    {
+        const int stride = PAGE_SIZE * 4;
+        const unsigned char* src = (const unsigned char*)sheet.data;
+        unsigned char* dst = (unsigned char*)page.data;
+        for (int row = 0; row < sheet.height; row++)
+        {
+            std::memcpy(dst + (size_t)(y + row) * stride + (size_t)x * 4, src + (size_t)row * sheet.width * 4, (size_t)sheet.width * 4);
+        }
+    }
+
+    void Build()
+    {
+        if (gPending.empty()) return;
+        LoadTimer timer("SpriteAtlas::Build");
+
+        // tallest first keeps the shelves tight, path breaks ties so the layout is the same every run
+        std::sort(gPending.begin(), gPending.end(), [](const Pending& a, const Pending& b) {
+            if (a.image.height != b.image.height) return a.image.height > b.image.height;
+            return a.path < b.path;
+        });
+
+        int packed = 0;
+        for (Pending& p : gPending)
+        {
+            int w = p.image.width + GUTTER * 2;
+            int h = p.image.height + GUTTER * 2;
+
+            int page = -1, x = 0, y = 0;
+            for (int i = 0; i < (int)gPages.size() && page < 0; i++)
+            {
+                if (!gPages[i].image.data) continue; // uploaded by an earlier Build
+                if (PlaceOnPage(gPages[i], w, h, x, y)) page = i;
+            }
+            if (page < 0 && (int)gPages.size() < MAX_PAGES)
+            {
+                Page fresh;
+                fresh.image = GenImageColor(PAGE_SIZE, PAGE_SIZE, BLANK);
+                gPages.push_back(fresh);
+                if (PlaceOnPage(gPages.back(), w, h, x, y)) page = (int)gPages.size() - 1;
+            }
+
+            if (page >= 0)
+            {
+                ImageFormat(&p.image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+                CopyInto(gPages[page].image, p.image, x + GUTTER, y + GUTTER);
+                gEntries[p.textureId] = { page, x + GUTTER, y + GUTTER };
+                packed++;
+            }
+            else
+            {
+                TraceLog(LOG_WARNING, "ATLAS: no room for %s, it keeps its own texture", p.path.c_str());
+            }
+
+            UnloadImage(p.image);
+        }
+        gPending.clear();
+
+        for (Page& page : gPages)
+        {
+            if (!page.image.data) continue;
+            page.texture = LoadTextureFromImage(page.image);
+            UnloadImage(page.image);
+            page.image = {};
+            page.shelves.clear();
+        }
+
+        TraceLog(LOG_INFO, "ATLAS: %d sprite sheets packed into %d pages", packed, (int)gPages.size());
+    }
+
+    void Unload()
+    {
+        for (Pending& p : gPending) UnloadImage(p.image);
+        gPending.clear();
+
+        for (Page& page : gPages)
+        {
+            if (page.image.data) UnloadImage(page.image);
+            if (page.texture.id != 0) UnloadTexture(page.texture);
+        }
+        gPages.clear();
+        gEntries.clear();
+    }
+
+    bool Remap(Texture2D& texture, Rectangle& source)
+    {
+        auto it = gEntries.find(texture.id);
+        if (it == gEntries.end()) return false;
+
+        const Entry& e = it->second;
+        source.x += e.x;
+        source.y += e.y;
+        texture = gPages[e.page].texture;
+        return true;
+    }
+
+    int PageCount()
+    {
+        return (int)gPages.size();
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include "raylib.h"
+
+// Load-time texture atlas for billboard sprite sheets.
+//
+// While AssetLoader uploads textures, every sheet from assets/sprites/ that fits is also handed
+// to Collect() (the decoded image, before it is freed). Build() then shelf-packs them into a few
+// 4096x4096 pages, tallest first, with a transparent gutter around each sheet.
+//
+// The original textures stay loaded for UI and anything else that draws them directly.
+// Billboard gatherers call Remap() to swap a sheet + sourceRect for the atlas page and the
+// same frame inside it, so most of the transparent pass shares one or two textures.
+
+namespace SpriteAtlas
+{
+    // True when the image was taken: the atlas owns it from here on and frees it in Build().
+    bool Collect(const Texture2D& texture, const std::string& path, Image& image);
+
+    void Build();   // after AssetLoader::Flush
+    void Unload();
+
+    // texture/source in sheet space -> atlas page and atlas pixels. False (and untouched) for
+    // sheets that are not in the atlas.
+    bool Remap(Texture2D& texture, Rectangle& source);
+
+    int PageCount();
+}
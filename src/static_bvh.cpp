@@ -0,0 +1,107 @@
+#include "static_bvh.h"
+
+#include <algorithm>
+
+static Vector3 BoxCenter(const BoundingBox& b)
+{
+    return { (b.min.x + b.max.x) * 0.5f, (b.min.y + b.max.y) * 0.5f, (b.min.z + b.max.z) * 0.5f };
+}
+
+static float Axis(const Vector3& v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+void StaticBVH::Clear()
+{
+    nodes.clear();
+    items.clear();
+    itemBounds.clear();
+}
+
+void StaticBVH::Build(const std::vector<BoundingBox>& boxes)
+{
+    Clear();
+    if (boxes.empty()) return;
+
+    items.resize(boxes.size());
+    for (int i = 0; i < (int)boxes.size(); i++) items[i] = i;
+    itemBounds = boxes;
+
+    nodes.reserve(boxes.size() * 2 / LEAF_SIZE + 1);
+    nodes.push_back(Node{});
+    BuildNode(0, 0, (int)items.size());
+
+    // itemBounds was indexed by original item while building, put it in tree order
+    std::vector<BoundingBox> ordered(items.size());
+    for (int i = 0; i < (int)items.size(); i++) ordered[i] = boxes[items[i]];
+    itemBounds.swap(ordered);
+}
+
+void StaticBVH::BuildNode(int index, int first, int count)
+{
+    BoundingBox bounds = itemBounds[items[first]];
+    BoundingBox centers = { BoxCenter(bounds), BoxCenter(bounds) };
+    for (int i = first; i < first + count; i++) {
+        const BoundingBox& b = itemBounds[items[i]];
+        bounds.min = Vector3Min(bounds.min, b.min);
+        bounds.max = Vector3Max(bounds.max, b.max);
+        Vector3 c = BoxCenter(b);
+        centers.min = Vector3Min(centers.min, c);
+        centers.max = Vector3Max(centers.max, c);
+    }
+
+    nodes[index].bounds = bounds;
+    nodes[index].first = first;
+    nodes[index].count = count;
+    if (count <= LEAF_SIZE) return;
+
+    // median split on the longest axis of the centers
+    Vector3 extent = Vector3Subtract(centers.max, centers.min);
+    int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+    if (Axis(extent, axis) <= 0.0f) return; // all stacked on one point, keep as a leaf
+
+    int half = count / 2;
+    std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+        [&](int a, int b) { return Axis(BoxCenter(itemBounds[a]), axis) < Axis(BoxCenter(itemBounds[b]), axis); });
+
+    // children are allocated as a pair so right == left + 1
+    int left = (int)nodes.size();
+    nodes.push_back(Node{});
+    nodes.push_back(Node{});
+    nodes[index].left = left;
+
+    BuildNode(left, first, half);
+    BuildNode(left + 1, first + half, count - half);
+}
+
+void StaticBVH::Query(const Frustum& frustum, std::vector<int>& out) const
+{
+    if (nodes.empty()) return;
+
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Node& n = nodes[stack[--top]];
+
+        FrustumResult r = FrustumTestAABB(frustum, n.bounds);
+        if (r == FrustumResult::Outside) continue;
+
+        if (r == FrustumResult::Inside) {
+            out.insert(out.end(), items.begin() + n.first, items.begin() + n.first + n.count);
+            continue;
+        }
+
+        if (n.left < 0) {
+            for (int i = n.first; i < n.first + n.count; i++) {
+                if (FrustumContainsAABB(frustum, itemBounds[i])) out.push_back(items[i]);
+            }
+            continue;
+        }
+
+        stack[top++] = n.left + 1;
+        stack[top++] = n.left;
+    }
+}
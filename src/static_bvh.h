@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include "raylib.h"
+#include "frustum.h"
+
+// Bounding volume hierarchy over boxes that don't move (terrain chunks, dungeon tiles,
+// doorways, props, vegetation). Build once when the level loads, Query every frame.
+//
+// Query walks down from the root: a node outside the frustum drops its whole subtree,
+// a node fully inside adds its whole subtree without testing the items, and only leaves
+// that straddle a plane test their items one by one.
+
+class StaticBVH {
+public:
+    // Item i is boxes[i]; Query returns those indices.
+    void Build(const std::vector<BoundingBox>& boxes);
+    void Clear();
+
+    // Appends the index of every item whose box touches the frustum (order is tree order).
+    void Query(const Frustum& frustum, std::vector<int>& out) const;
+
+    int ItemCount() const { return (int)items.size(); }
+    bool Empty() const { return items.empty(); }
+
+private:
+    struct Node {
+        BoundingBox bounds;
+        int first = 0;      // range in items/itemBounds covered by this subtree
+        int count = 0;
+        int left = -1;      // right child is left + 1, -1 = leaf
+    };
+
+    static constexpr int LEAF_SIZE = 8;
+
+    void BuildNode(int index, int first, int count);
+
+    std::vector<Node> nodes;
+    std::vector<int> items;               // item indices, reordered so every subtree is contiguous
+    std::vector<BoundingBox> itemBounds;  // same order as items
+};
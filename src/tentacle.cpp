@@ -159,7 +159,7 @@ void Tentacle::ChangeState(TentacleState newState)
 }
 
 
-void Tentacle::Update(float dt, const Vector3& target, Player& player, std::vector<Character*> pirates)
+void Tentacle::Update(float dt, const Vector3& target, Player& player, const std::vector<Character*>& pirates)
 {
     if (canDie && isDead){
         canDie = false;
@@ -518,15 +518,70 @@ void Tentacle::UpdateWithdraw(float dt)
 }
 
 
-void Tentacle::Draw() const
+static constexpr int TUBE_SIDES = 8;
+static constexpr int VERTS_PER_CONE = TUBE_SIDES * 12; // side quad + both caps, per side
+
+// Same triangles as DrawCylinderEx (caps included, same winding), written into the mesh arrays.
+static int AppendCone(float* vertices, unsigned char* colors, Vector3 startPos, Vector3 endPos,
+                      float startRadius, float endRadius, Color color)
+{
+    Vector3 direction = Vector3Subtract(endPos, startPos);
+    if (direction.x == 0.0f && direction.y == 0.0f && direction.z == 0.0f) return 0;
+
+    Vector3 b1 = Vector3Normalize(Vector3Perpendicular(direction));
+    Vector3 b2 = Vector3Normalize(Vector3CrossProduct(b1, direction));
+    float baseAngle = (2.0f * PI) / TUBE_SIDES;
+
+    int n = 0;
+    auto emit = [&](Vector3 v) {
+        vertices[n * 3 + 0] = v.x;
+        vertices[n * 3 + 1] = v.y;
+        vertices[n * 3 + 2] = v.z;
+        colors[n * 4 + 0] = color.r;
+        colors[n * 4 + 1] = color.g;
+        colors[n * 4 + 2] = color.b;
+        colors[n * 4 + 3] = color.a;
+        n++;
+    };
+    auto ring = [&](Vector3 center, float radius, int i) {
+        float s = sinf(baseAngle * i) * radius;
+        float c = cosf(baseAngle * i) * radius;
+        return Vector3{ center.x + s * b1.x + c * b2.x,
+                        center.y + s * b1.y + c * b2.y,
+                        center.z + s * b1.z + c * b2.z };
+    };
+
+    for (int i = 0; i < TUBE_SIDES; i++)
+    {
+        Vector3 w1 = ring(startPos, startRadius, i);
+        Vector3 w2 = ring(startPos, startRadius, i + 1);
+        Vector3 w3 = ring(endPos, endRadius, i);
+        Vector3 w4 = ring(endPos, endRadius, i + 1);
+
+        emit(startPos); emit(w2); emit(w1);
+        emit(w1); emit(w2); emit(w3);
+        emit(w2); emit(w4); emit(w3);
+        emit(endPos); emit(w3); emit(w4);
+    }
+    return n;
+}
+
+int Tentacle::MaxVertices() const
+{
+    // body + underside per body segment, plus the tip
+    int bodySegments = (joints.size() >= 2) ? (int)joints.size() - 2 : 0;
+    return (bodySegments * 2 + 1) * VERTS_PER_CONE;
+}
+
+int Tentacle::BuildTube(float* vertices, unsigned char* colors) const
 {
     const size_t jointCount = joints.size();
 
     if (jointCount < 2)
-        return;
+        return 0;
 
     if (visibleSegments <= 0)
-        return;
+        return 0;
 
     float baseRadius = 40.0f;
     float tipRadius  = 8.0f;
@@ -546,6 +601,11 @@ void Tentacle::Draw() const
     if ((size_t)visibleBodySegments < bodySegmentCount)
         firstVisibleBodyIndex = bodySegmentCount - (size_t)visibleBodySegments;
 
+    int count = 0;
+    auto cone = [&](Vector3 a, Vector3 b, float r0, float r1, Color color) {
+        count += AppendCone(vertices + count * 3, colors + count * 4, a, b, r0, r1, color);
+    };
+
     for (size_t i = firstVisibleBodyIndex; i < tipStartIndex; ++i)
     {
         Vector3 start = joints[i];
@@ -569,14 +629,13 @@ void Tentacle::Draw() const
 
         Vector3 pinkOffset = undersideOffset;
 
-        DrawCylinderEx(newStart, newEnd, radiusStart, radiusEnd, 8, krakenPurple);
+        cone(newStart, newEnd, radiusStart, radiusEnd, krakenPurple);
 
-        DrawCylinderEx(
+        cone(
             Vector3Add(newStart, pinkOffset),
             Vector3Add(newEnd, pinkOffset),
             radiusStart * 0.85f,
             radiusEnd * 0.85f,
-            8,
             suckerPink
         );
     }
@@ -594,9 +653,70 @@ void Tentacle::Draw() const
         Vector3 newStart = Vector3Add(start, Vector3Scale(dir, gap));
         Vector3 newEnd   = Vector3Subtract(end, Vector3Scale(dir, gap));
 
-        DrawCylinderEx(newStart, newEnd, 14.0f, 2.0f, 8, krakenPurple);
+        cone(newStart, newEnd, 14.0f, 2.0f, krakenPurple);
+    }
+
+    return count;
+}
+
+static Mesh gTentacleMesh = {};
+static Material gTentacleMaterial = {};
+static int gTentacleCapacity = 0; // vertices
+
+static void EnsureTentacleMesh(int vertexCount)
+{
+    if (vertexCount <= gTentacleCapacity) return;
+
+    UnloadTentacleMesh();
+
+    gTentacleCapacity = vertexCount;
+    gTentacleMesh = {};
+    gTentacleMesh.vertexCount   = vertexCount;
+    gTentacleMesh.triangleCount = vertexCount / 3;
+    gTentacleMesh.vertices  = (float*)MemAlloc(vertexCount * 3 * sizeof(float));
+    gTentacleMesh.texcoords = (float*)MemAlloc(vertexCount * 2 * sizeof(float)); // unused, white texture
+    gTentacleMesh.colors    = (unsigned char*)MemAlloc(vertexCount * 4);
+    UploadMesh(&gTentacleMesh, true); // dynamic, rewritten every frame
+
+    gTentacleMaterial = LoadMaterialDefault();
+}
+
+void DrawTentacles(const std::vector<Tentacle>& tentacles)
+{
+    int needed = 0;
+    for (const Tentacle& t : tentacles) needed += t.MaxVertices();
+    if (needed == 0) return;
+
+    EnsureTentacleMesh(needed);
+
+    int count = 0;
+    for (const Tentacle& t : tentacles)
+    {
+        count += t.BuildTube(gTentacleMesh.vertices + count * 3, gTentacleMesh.colors + count * 4);
     }
+    if (count == 0) return;
+
+    UpdateMeshBuffer(gTentacleMesh, 0, gTentacleMesh.vertices, count * 3 * sizeof(float), 0);
+    UpdateMeshBuffer(gTentacleMesh, 3, gTentacleMesh.colors, count * 4, 0);
+
+    // draw only what was written this frame
+    Mesh used = gTentacleMesh;
+    used.vertexCount = count;
+    used.triangleCount = count / 3;
+    DrawMesh(used, gTentacleMaterial, MatrixIdentity());
 }
+
+void UnloadTentacleMesh()
+{
+    if (gTentacleCapacity == 0) return;
+
+    UnloadMesh(gTentacleMesh);
+    UnloadMaterial(gTentacleMaterial);
+    gTentacleMesh = {};
+    gTentacleMaterial = {};
+    gTentacleCapacity = 0;
+}
+
 // void Tentacle::Draw() const
 // {
 //     if (joints.size() < 2)
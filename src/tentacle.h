@@ -27,8 +27,12 @@ public:
     bool canDie = false;
     void Rise();   
     void Init(const Vector3& rootPosition, int segmentCount, float segmentLength);
-    void Update(float dt, const Vector3& target, Player& player, std::vector<Character*> pirates);
-    void Draw() const;
+    void Update(float dt, const Vector3& target, Player& player, const std::vector<Character*>& pirates);
+
+    // Appends this tentacle's segments (body, sucker underside, tip) to the shared tube mesh.
+    // Returns the number of vertices written, at most MaxVertices().
+    int BuildTube(float* vertices, unsigned char* colors) const;
+    int MaxVertices() const;
 
 private:
     void SolveChain();
@@ -77,4 +81,9 @@ private:
     bool tipHitActive = false;
     bool canHit = false;
     bool slamSoundPlayed = false;
-};
\ No newline at end of file
+};
+
+// All tentacles share one dynamic mesh: BuildTube writes each chain into it every frame,
+// one UpdateMeshBuffer per attribute and a single DrawMesh for the lot.
+void DrawTentacles(const std::vector<Tentacle>& tentacles);
+void UnloadTentacleMesh();
\ No newline at end of file
@@ -5,28 +5,17 @@
 #include <cstring>
 #include "raymath.h"
 #include "world.h"
-#include "viewCone.h"
+#include "frustum.h"
 
 TerrainGrid terrain;
 
 TerrainChunkStats terrainStats;
 
-static inline unsigned char SampleGray(const Image& img, int x, int z) {
-    x = std::clamp(x, 0, img.width  - 1);
-    z = std::clamp(z, 0, img.height - 1);
-    const unsigned char* px = reinterpret_cast<unsigned char*>(img.data);
-    return px[z * img.width + x]; // PIXELFORMAT_UNCOMPRESSED_GRAYSCALE
-}
-
-static inline float HeightMeters(const Image& img, int x, int z, float heightScale) {
-    return (SampleGray(img, x, z) / 255.0f) * heightScale;
-}
-
-static inline Vector3 ComputeNormalCd(const Image& hm, int x, int z, float heightScale, float cellX, float cellZ) {
-    float hL = HeightMeters(hm, x - 1, z    , heightScale);
-    float hR = HeightMeters(hm, x + 1, z    , heightScale);
-    float hD = HeightMeters(hm, x    , z - 1, heightScale);
-    float hU = HeightMeters(hm, x    , z + 1, heightScale);
+static inline Vector3 ComputeNormalCd(const HeightField& hf, int x, int z, float cellX, float cellZ) {
+    float hL = hf.TexelHeight(x - 1, z    );
+    float hR = hf.TexelHeight(x + 1, z    );
+    float hD = hf.TexelHeight(x    , z - 1);
+    float hU = hf.TexelHeight(x    , z + 1);
 
     // central differences: slope scaled by world cell size
     Vector3 n = {
@@ -39,20 +28,19 @@ static inline Vector3 ComputeNormalCd(const Image& hm, int x, int z, float heigh
 
 //static inline float Lerp(float a, float b, float t) { return a + (b - a) * t; }
 
-TerrainGrid BuildTerrainGridFromHeightmap(const Image& heightmapGray, Vector3 terrainScale, int tileRes, bool addSkirt) {
+TerrainGrid BuildTerrainGridFromHeightmap(const HeightField& field, Vector3 terrainScale, int tileRes, bool addSkirt) {
     TerrainGrid T{};
     T.terrainScale = terrainScale;
     T.tileRes      = std::max(5, tileRes);
-    T.heightmapW   = heightmapGray.width;
-    T.heightmapH   = heightmapGray.height;
+    T.heightmapW   = field.Width();
+    T.heightmapH   = field.Height();
 
-    const int W = heightmapGray.width;
-    const int H = heightmapGray.height;
+    const int W = field.Width();
+    const int H = field.Height();
 
     // World spans from -X/2..+X/2 and -Z/2..+Z/2, like your current DrawModel offset.
     const float worldX = terrainScale.x;
     const float worldZ = terrainScale.z;
-    const float heightY = terrainScale.y;
 
     // world-space size per height texel
     const float cellX = worldX / float(W - 1);
@@ -109,7 +97,7 @@ TerrainGrid BuildTerrainGridFromHeightmap(const Image& heightmapGray, Vector3 te
 
                     float x = Lerp(-worldX * 0.5f, +worldX * 0.5f, tX);
                     float z = Lerp(-worldZ * 0.5f, +worldZ * 0.5f, tZ);
-                    float y = HeightMeters(heightmapGray, hx, hz, heightY);
+                    float y = field.TexelHeight(hx, hz);
 
                     // If this vertex lies on the skirt border, push it slightly down
                     if (addSkirt) {
@@ -126,7 +114,7 @@ TerrainGrid BuildTerrainGridFromHeightmap(const Image& heightmapGray, Vector3 te
                     vtx[v*3 + 1] = y;
                     vtx[v*3 + 2] = z;
 
-                    const Vector3 n = ComputeNormalCd(heightmapGray, hx, hz, heightY, cellX, cellZ);
+                    const Vector3 n = ComputeNormalCd(field, hx, hz, cellX, cellZ);
                     nrm[v*3 + 0] = n.x;
                     nrm[v*3 + 1] = n.y;
                     nrm[v*3 + 2] = n.z;
@@ -197,6 +185,11 @@ TerrainGrid BuildTerrainGridFromHeightmap(const Image& heightmapGray, Vector3 te
         }
     }
 
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(T.chunks.size());
+    for (const TerrainChunk& c : T.chunks) boxes.push_back(c.aabb);
+    T.bvh.Build(boxes);
+
     return T;
 }
 
@@ -218,30 +211,27 @@ void BuildTerrainChunkDrawList(
         stats->candidatesBeforeCap = 0;
     }
 
-    ViewConeParams vp = MakeViewConeParams(
-        cam,
-        60.0f,
-        maxDrawDist,
-        1600.0f
-    );
+    // 1) Collect candidates: frustum vs chunk aabb through the BVH, far plane at the draw distance
+    static std::vector<int> candidates;
+    candidates.clear();
+
+    if (disableCulling)
+    {
+        for (int i = 0; i < (int)T.chunks.size(); i++) candidates.push_back(i);
+    }
+    else
+    {
+        T.bvh.Query(MakeCameraFrustum(cam, maxDrawDist), candidates);
+    }
 
-    // 1) Collect candidates
-    for (const TerrainChunk& c : T.chunks)
+    for (int i : candidates)
     {
+        const TerrainChunk& c = T.chunks[i];
         Vector3 toChunk = Vector3Subtract(c.center, cam.position);
         float distSq = Vector3LengthSqr(toChunk);
 
-        if (!disableCulling)
-        {
-            if (distSq > maxDrawDist * maxDrawDist)
-                continue;
-
-            if (!IsInViewCone(vp, c.center))
-                continue;
-
-            if (c.aabb.max.y < waterHeightY) // cull underwater chunks
-                continue;
-        }
+        if (!disableCulling && c.aabb.max.y < waterHeightY) // cull underwater chunks
+            continue;
 
         outList.push_back({ &c, distSq });
     }
@@ -329,5 +319,6 @@ void UnloadTerrainGrid(TerrainGrid& T) {
     }
 
     T.chunks.clear();
+    T.bvh.Clear();
     T.tilesX = T.tilesZ = 0;
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include "raylib.h"
 #include <vector>
+#include "static_bvh.h"
+#include "heightfield.h"
 
 struct TerrainChunkStats
 {
@@ -23,6 +25,7 @@ struct ChunkDrawInfo {
 
 struct TerrainGrid {
     std::vector<TerrainChunk> chunks;
+    StaticBVH bvh;                  // over chunk aabbs, built with the grid
     int   tilesX = 0, tilesZ = 0;   // chunk grid size
     int   tileRes = 129;            // samples per side inside a chunk (e.g., 129)
     Vector3 terrainScale;           // { worldX, height, worldZ } total world span
@@ -34,10 +37,10 @@ struct TerrainGrid {
 extern TerrainGrid terrain;
 extern TerrainChunkStats terrainStats;
 
-// Build from an already-loaded grayscale heightmap image (one byte per pixel).
+// Build from the level's loaded HeightField (one vertex per height sample).
 // - terrainScale: your {16000, 200, 16000}
 // - tileRes: usually 129 (keeps vertex index values < 65535)
-TerrainGrid BuildTerrainGridFromHeightmap(const Image& heightmapGray, Vector3 terrainScale, int tileRes = 129, bool addSkirt = true);
+TerrainGrid BuildTerrainGridFromHeightmap(const HeightField& field, Vector3 terrainScale, int tileRes = 129, bool addSkirt = true);
 
 // Draw with a simple distance ring (fast + good enough to start).
 // maxDrawDist is horizontal (XZ) distance in world units.
@@ -0,0 +1,191 @@
+#include "tile_fov.h"
+
+#include <algorithm>
+#include <cstdint>
+#include "dungeonGeneration.h"
+#include "pathfinding.h"
+#include "world.h"
+
+namespace TileFOV
+{
+    // slopes are kept as exact fractions, floats make tiles flicker along the edges
+    struct Slope
+    {
+        int num;
+        int den; // > 0
+    };
+
+    // (depth, col) in quadrant space -> tile
+    struct Quadrant
+    {
+        int ox, oy;
+        int dir; // 0 north, 1 east, 2 south, 3 west
+
+        void Transform(int depth, int col, int& x, int& y) const
+        {
+            switch (dir)
+            {
+                case 0:  x = ox + col;   y = oy - depth; break;
+                case 1:  x = ox + depth; y = oy + col;   break;
+                case 2:  x = ox + col;   y = oy + depth; break;
+                default: x = ox - depth; y = oy + col;   break;
+            }
+        }
+    };
+
+    struct Sweep
+    {
+        int radius;
+        int width;
+        int height;
+        uint32_t stamp;
+        std::vector<int>* out;
+    };
+
+    static std::vector<uint32_t> gStamp;   // per tile, == current stamp when already in the output
+    static uint32_t gCurrentStamp = 0;
+
+    static std::vector<int> gPlayerTiles;
+    static std::vector<uint8_t> gPlayerVisible;
+    static int gPlayerX = -1;
+    static int gPlayerY = -1;
+    static int gPlayerRadius = -1;
+    static bool gDirty = true;
+    static unsigned int gPlayerVersion = 0;
+
+    static int FloorDiv(int a, int b) { return (a >= 0) ? a / b : -((-a + b - 1) / b); }
+    static int CeilDiv(int a, int b)  { return -FloorDiv(-a, b); }
+
+    // depth * slope rounded to the nearest column, ties up / ties down
+    static int RoundTiesUp(int depth, Slope s)   { return FloorDiv(2 * depth * s.num + s.den, 2 * s.den); }
+    static int RoundTiesDown(int depth, Slope s) { return CeilDiv(2 * depth * s.num - s.den, 2 * s.den); }
+
+    static Slope SlopeOf(int depth, int col) { return { 2 * col - 1, 2 * depth }; }
+
+    static bool IsSymmetric(int depth, int col, Slope start, Slope end)
+    {
+        return col * start.den >= depth * start.num && col * end.den <= depth * end.num;
+    }
+
+    static void Reveal(Sweep& sw, int x, int y)
+    {
+        if (x < 0 || y < 0 || x >= sw.width || y >= sw.height) return;
+        int idx = y * sw.width + x;
+        if (gStamp[idx] == sw.stamp) return; // quadrant diagonals are shared
+        gStamp[idx] = sw.stamp;
+        sw.out->push_back(idx);
+    }
+
+    static void Scan(Sweep& sw, const Quadrant& q, int depth, Slope start, Slope end)
+    {
+        if (depth > sw.radius) return;
+
+        const int minCol = RoundTiesUp(depth, start);
+        const int maxCol = RoundTiesDown(depth, end);
+        const int radiusSq = sw.radius * sw.radius;
+
+        int prev = -1; // -1 none yet, 0 see-through, 1 blocking
+        for (int col = minCol; col <= maxCol; col++)
+        {
+            int x, y;
+            q.Transform(depth, col, x, y);
+
+            bool blocking = !IsSeeThroughForLOS(x, y); // out of bounds blocks too
+            if (depth * depth + col * col <= radiusSq && (blocking || IsSymmetric(depth, col, start, end)))
+                Reveal(sw, x, y);
+
+            if (prev == 1 && !blocking) start = SlopeOf(depth, col);
+            if (prev == 0 && blocking) Scan(sw, q, depth + 1, start, SlopeOf(depth, col));
+            prev = blocking ? 1 : 0;
+        }
+
+        if (prev == 0) Scan(sw, q, depth + 1, start, end);
+    }
+
+    void Compute(int originX, int originY, int radius, std::vector<int>& outTiles)
+    {
+        outTiles.clear();
+        if (!dungeonPixels || dungeonWidth <= 0 || dungeonHeight <= 0) return;
+        if (originX < 0 || originY < 0 || originX >= dungeonWidth || originY >= dungeonHeight) return;
+
+        if ((int)gStamp.size() != dungeonWidth * dungeonHeight)
+        {
+            gStamp.assign(dungeonWidth * dungeonHeight, 0);
+            gCurrentStamp = 0;
+        }
+        if (++gCurrentStamp == 0) // wrapped, start over
+        {
+            std::fill(gStamp.begin(), gStamp.end(), 0);
+            gCurrentStamp = 1;
+        }
+
+        Sweep sw = { radius, dungeonWidth, dungeonHeight, gCurrentStamp, &outTiles };
+        Reveal(sw, originX, originY);
+
+        for (int dir = 0; dir < 4; dir++)
+        {
+            Quadrant q = { originX, originY, dir };
+            Scan(sw, q, 1, { -1, 1 }, { 1, 1 });
+        }
+    }
+
+    void Invalidate()
+    {
+        gDirty = true;
+    }
+
+    void Clear()
+    {
+        gStamp.clear();
+        gCurrentStamp = 0;
+        gPlayerTiles.clear();
+        gPlayerVisible.clear();
+        gPlayerX = gPlayerY = gPlayerRadius = -1;
+        gDirty = true;
+    }
+
+    void UpdatePlayer(int tileX, int tileY, int radius)
+    {
+        if ((int)gPlayerVisible.size() != dungeonWidth * dungeonHeight)
+        {
+            gPlayerVisible.assign(dungeonWidth * dungeonHeight, 0);
+            gPlayerTiles.clear();
+            gDirty = true;
+        }
+
+        if (!gDirty && tileX == gPlayerX && tileY == gPlayerY && radius == gPlayerRadius) return;
+
+        for (int idx : gPlayerTiles) gPlayerVisible[idx] = 0;
+        Compute(tileX, tileY, radius, gPlayerTiles);
+        for (int idx : gPlayerTiles) gPlayerVisible[idx] = 1;
+
+        gPlayerX = tileX;
+        gPlayerY = tileY;
+        gPlayerRadius = radius;
+        gDirty = false;
+        gPlayerVersion++;
+    }
+
+    const std::vector<int>& PlayerTiles()
+    {
+        return gPlayerTiles;
+    }
+
+    unsigned int PlayerVersion()
+    {
+        return gPlayerVersion;
+    }
+
+    bool PlayerCanSee(int tileX, int tileY)
+    {
+        if (tileX < 0 || tileY < 0 || tileX >= dungeonWidth || tileY >= dungeonHeight) return false;
+        int idx = tileY * dungeonWidth + tileX;
+        return idx < (int)gPlayerVisible.size() && gPlayerVisible[idx] != 0;
+    }
+
+    bool PlayerCanSee(Vector3 worldPos)
+    {
+        return PlayerCanSee(GetDungeonImageX(worldPos.x, tileSize, dungeonWidth),
+                            GetDungeonImageY(worldPos.z, tileSize, dungeonHeight));
+    }
+}
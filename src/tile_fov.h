@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+#include "raylib.h"
+
+// Tile field of view for dungeons: symmetric shadowcasting, one sweep per quadrant.
+//
+// Compute() works from any tile. Opacity comes from IsSeeThroughForLOS. Blocking tiles
+// that are reached (walls, closed doors) are part of the result. Floor tiles are only in
+// the result when the sight line is symmetric, so if A sees B then B sees A.
+//
+// The player's FOV is cached. UpdatePlayer() only sweeps again when the player changes
+// tile or the walkable grid changed (Invalidate, called from SetTileWalkable/Unwalkable).
+// The minimap reveal reads the cached set, and AI can ask PlayerCanSee(tile).
+
+namespace TileFOV
+{
+    void Compute(int originX, int originY, int radius, std::vector<int>& outTiles); // tile index y * dungeonWidth + x
+
+    void Invalidate();
+    void Clear();
+
+    void UpdatePlayer(int tileX, int tileY, int radius);
+    const std::vector<int>& PlayerTiles();
+    unsigned int PlayerVersion();   // bumps every time the cached set is recomputed
+
+    bool PlayerCanSee(int tileX, int tileY);
+    bool PlayerCanSee(Vector3 worldPos);
+}
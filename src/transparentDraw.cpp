@@ -16,6 +16,11 @@
 #include "shaderSetup.h"
 #include "grass.h"
 #include "dungeon_props.h"
+#include "dungeon_visibility.h"
+#include "sprite_atlas.h"
+#include "game_settings.h"
+#include <cstring>
+#include <cstdint>
 
 
 std::vector<BillboardDrawRequest> billboardRequests;
@@ -133,10 +138,13 @@ void GatherEnemies(Camera& camera) {
         if (enemy->hitTimer > 0.0f) finalTint = {255,50,50,255};
         if (enemy->state == CharacterState::Freeze) finalTint = SKYBLUE;
 
+        Texture2D texture = enemy->texture;
+        SpriteAtlas::Remap(texture, sourceRect);
+
         billboardRequests.push_back({
             Billboard_FacingCamera,
             offsetPos,
-            enemy->texture,
+            texture,
             sourceRect,
             Vector2 {billboardSize, billboardSize},
             finalTint,
@@ -378,6 +386,7 @@ void GatherSpiderEggDrawRequests(Camera& camera)
 
 
 void GatherDungeonFires(Camera& camera, float deltaTime) {
+    Texture2D& fireSheet = R.GetTexture("fireSheet");
     for (size_t i = 0; i < pillars.size(); ++i) {
         PillarInstance& pillar = pillars[i];
         Fire& fire = fires[i];
@@ -408,10 +417,12 @@ void GatherDungeonFires(Camera& camera, float deltaTime) {
 
         // Add to billboard requests
         float dist = Vector3DistanceSqr(camera.position, firePos);
+        Texture2D texture = fireSheet;
+        SpriteAtlas::Remap(texture, sourceRect);
         billboardRequests.push_back({
             Billboard_FacingCamera,
             firePos,
-            R.GetTexture("fireSheet"),
+            texture,
             sourceRect,
             Vector2{100.0f, 100.0f},
             fireColor,
@@ -421,6 +432,7 @@ void GatherDungeonFires(Camera& camera, float deltaTime) {
             false,
             false
         });
+        billboardRequests.back().blended = true;
     }
 }
 
@@ -486,7 +498,7 @@ void GatherDoors(Camera& camera) {
 
 
 
-void GatherDecals(Camera& camera, const std::vector<Decal>& decals) {
+void GatherDecals(Camera& camera, const DecalPool& decals) {
     for (const Decal& decal : decals) {
         if (!decal.alive) continue;
 
@@ -527,10 +539,13 @@ void GatherDecals(Camera& camera, const std::vector<Decal>& decals) {
             };
         }
 
+        Texture2D texture = decal.texture;
+        SpriteAtlas::Remap(texture, sourceRect);
+
         billboardRequests.push_back({
             Billboard_Decal,
             decal.position,
-            decal.texture,
+            texture,
             sourceRect,
             Vector2{decal.size,decal.size},
             WHITE,
@@ -560,12 +575,16 @@ void GatherMuzzleFlashes(Camera& camera, const std::vector<MuzzleFlash>& flashes
             false,
             false
         });
+        billboardRequests.back().blended = true;
     }
 }
 
 void GatherTransparentDrawRequests(Camera& camera, float deltaTime) {
     billboardRequests.clear();
 
+    // rooms seen through the open doors this frame, used here and by the dungeon geometry draw
+    DungeonVisibility::Update(camera, GameSettings::maxDrawDist);
+
     GatherEnemies(camera);
     GatherNPCs(camera);
     GatherDungeonFires(camera, deltaTime);
@@ -582,6 +601,11 @@ void GatherTransparentDrawRequests(Camera& camera, float deltaTime) {
 
     GatherDungeonPropDrawRequests(camera.position, billboardRequests);
 
+    // drop anything sitting in a room we can't see into
+    billboardRequests.erase(std::remove_if(billboardRequests.begin(), billboardRequests.end(),
+        [](const BillboardDrawRequest& r) { return !DungeonVisibility::IsWorldPosVisible(r.position); }),
+        billboardRequests.end());
+
     if (!isDungeon && !CurrentLevelIs("Ship"))
     {
         //Grass::Gather(camera);
@@ -592,93 +616,234 @@ void GatherTransparentDrawRequests(Camera& camera, float deltaTime) {
 }
 
 void SetPortalShaderColor(Vector3 colorA, Vector3 colorB){
-    Shader& portalShader = R.GetShader("portalShader");
-    // int locTint = GetShaderLocation(portalShader, "u_tint");
-    int locTintStrength = GetShaderLocation(portalShader, "u_tintStrength");
-
-    int locColorA = GetShaderLocation(portalShader, "u_colorA");
-    int locColorB = GetShaderLocation(portalShader, "u_colorB");
+    //locations cached in InitPortalShader, this runs per portal billboard.
+    ShaderSetup::PortalShader& ps = ShaderSetup::gPortal;
+    Shader& portalShader = *ps.shader;
     float strength = 0.6f; // or 0.6f for subtle
-    //SetShaderValue(R.GetShader("portalShader"), locTint, &tint, SHADER_UNIFORM_VEC3);
-    SetShaderValue(portalShader, locColorA, &colorA, SHADER_UNIFORM_VEC3);
-    SetShaderValue(portalShader, locColorB, &colorB, SHADER_UNIFORM_VEC3);
-    SetShaderValue(portalShader, locTintStrength, &strength, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(portalShader, ps.loc_colorA, &colorA, SHADER_UNIFORM_VEC3);
+    SetShaderValue(portalShader, ps.loc_colorB, &colorB, SHADER_UNIFORM_VEC3);
+    SetShaderValue(portalShader, ps.loc_tintStrength, &strength, SHADER_UNIFORM_FLOAT);
 
 }
 
-void DrawTransparentDrawRequests(Camera& camera) {
-    //sort and draw the drawRequest structs. 
-    std::sort(billboardRequests.begin(), billboardRequests.end(),
-        [](const BillboardDrawRequest& a, const BillboardDrawRequest& b) {
-            return a.distanceToCamera > b.distanceToCamera;
-        });
+// ------------------------------------------------------------
+// Billboard batching
+//
+// Requests are split into two lists of 64 bit keys instead of moving the fat structs around:
+//   cutout  - hard edged sprites, webs and closed doors. Alpha tested at BILLBOARD_DEPTH_CUTOFF
+//             and written to depth, so the depth test sorts them; they only need grouping
+//             by state.
+//   blended - decals, fire, muzzle flashes, portals, open doors and anything fading out.
+//             No depth writes, drawn back to front after the cutout list.
+// Key layout:
+//   [47..32] distance, far first, quantized to the top 16 bits of the float (blended only)
+//   [31..20] state: portal, texture id
+//   [19..0]  request index
+// Both lists go through one LSD radix sort over bits 20..47. A digit every key shares is
+// skipped after its counting pass, so the cutout list (no distance, mostly one atlas
+// texture) costs a couple of linear passes and no reordering at all.
+// Then each sorted list is walked once. Quads go straight into rlgl's vertex batch and
+// state is only touched where it changes, so a run of requests with the same shader
+// and texture ends up as one draw call.
+// ------------------------------------------------------------
+
+static constexpr int BILLBOARD_INDEX_BITS = 20;
+static constexpr uint64_t BILLBOARD_INDEX_MASK = (1ull << BILLBOARD_INDEX_BITS) - 1;
+static constexpr int BILLBOARD_KEY_BITS = 48;
+
+// cutout pass alpha test: high enough that every kept pixel is solid, so writing its depth
+// can't leave a see-through fringe that hides sprites drawn after it
+static const float BILLBOARD_DEPTH_CUTOFF = 0.5f;
+
+static std::vector<uint64_t> cutoutKeys;
+static std::vector<uint64_t> blendedKeys;
+static std::vector<uint64_t> radixScratch;
+
+static bool BillboardIsCutout(const BillboardDrawRequest& req)
+{
+    if (req.isPortal || req.blended || req.type == Billboard_Decal) return false;
+    if (req.type == Billboard_Door) return !req.isOpen; // open doors were occluding enemy billboards
+    return req.tint.a == 255;                           // fading sprites have to blend
+}
 
-    for (const BillboardDrawRequest& req : billboardRequests) {
-        //use alpha cut out shader on everything. treeShader does the fog at a distance thing + alpha cutout
-        if (!isDungeon) BeginShaderMode(R.GetShader("treeShader"));
-        if (isDungeon) BeginShaderMode(R.GetShader("cutoutShader"));
-        float aspect = (float)req.texture.height / (float)req.texture.width; // 2.0 for 512x1024
+static uint64_t MakeBillboardKey(const BillboardDrawRequest& req, uint32_t index, bool farFirst)
+{
+    uint64_t depth = 0;
+    if (farFirst) {
+        float d = std::max(req.distanceToCamera, 0.0f);
+        uint32_t depthBits;
+        std::memcpy(&depthBits, &d, sizeof(depthBits)); // positive floats sort like their bits
+        depth = (~depthBits) >> 16;                      // exponent + 7 mantissa bits, inverted
+    }
 
-        float sizeY = req.isPortal ? req.size.y * aspect : req.size.y; //HACK, make portals twice as tall.
-        Vector2 worldSize = { req.size.x, sizeY };
+    uint32_t state = ((req.isPortal ? 1u : 0u) << 11) | (req.texture.id & 0x3FFu);
 
-        Rectangle src = req.sourceRect;
-        if (req.flipX) {
-            src.width = -src.width; // negative width flips UVs
+    return (depth << 32) | ((uint64_t)state << BILLBOARD_INDEX_BITS) | (index & BILLBOARD_INDEX_MASK);
+}
+
+// LSD radix sort, 8 bit digits above the index bits. Stable, and the keys are pushed in index
+// order, so equal keys keep request order without the index bits ever being sorted.
+static void RadixSortBillboardKeys(std::vector<uint64_t>& keys)
+{
+    const size_t n = keys.size();
+    if (n < 2) return;
+
+    radixScratch.resize(n);
+    uint64_t* src = keys.data();
+    uint64_t* dst = radixScratch.data();
+
+    for (int shift = BILLBOARD_INDEX_BITS; shift < BILLBOARD_KEY_BITS; shift += 8) {
+        size_t count[256] = {};
+        for (size_t i = 0; i < n; i++) count[(src[i] >> shift) & 0xFF]++;
+        if (count[(src[0] >> shift) & 0xFF] == n) continue; // all keys share this digit
+
+        size_t offset = 0;
+        for (int d = 0; d < 256; d++) {
+            size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) dst[count[(src[i] >> shift) & 0xFF]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    if (src != keys.data()) std::copy(src, src + n, keys.data());
+}
+
+// DrawBillboardRec without the per call texture/batch handling, quad goes into the current batch.
+static void EmitBillboardQuad(const Vector3& camRight, const Texture2D& texture, Rectangle src,
+                              Vector3 position, Vector2 size, Color tint)
+{
+    Vector3 right = Vector3Scale(camRight, size.x);
+    Vector3 up = { 0.0f, size.y, 0.0f };
+    Vector3 origin = Vector3Add(Vector3Scale(camRight, size.x * 0.5f), Vector3{ 0.0f, size.y * 0.5f, 0.0f });
+    Vector3 base = Vector3Subtract(position, origin);
+
+    Vector3 p0 = base;
+    Vector3 p1 = Vector3Add(base, right);
+    Vector3 p2 = Vector3Add(p1, up);
+    Vector3 p3 = Vector3Add(base, up);
+
+    // negative width = mirrored, same frame read right to left
+    float left = (src.width < 0.0f) ? src.x - src.width : src.x;
+    float u0 = left / texture.width;
+    float u1 = (left + src.width) / texture.width;
+    float v0 = src.y / texture.height;
+    float v1 = (src.y + src.height) / texture.height;
+
+    rlSetTexture(texture.id);
+    rlBegin(RL_QUADS);
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlTexCoord2f(u0, v1); rlVertex3f(p0.x, p0.y, p0.z);
+        rlTexCoord2f(u1, v1); rlVertex3f(p1.x, p1.y, p1.z);
+        rlTexCoord2f(u1, v0); rlVertex3f(p2.x, p2.y, p2.z);
+        rlTexCoord2f(u0, v0); rlVertex3f(p3.x, p3.y, p3.z);
+    rlEnd();
+}
+
+// Walk one sorted key list. Shader changes flush by themselves, portals flush before their uniforms change.
+static void DrawBillboardKeys(const std::vector<uint64_t>& keys, Shader& baseShader, Shader& portalShader,
+                              Vector3 camRight, unsigned int& currentShader)
+{
+    for (uint64_t key : keys) {
+        const BillboardDrawRequest& req = billboardRequests[key & BILLBOARD_INDEX_MASK];
+
+        Shader& shader = req.isPortal ? portalShader : baseShader;
+
+        // Portal uniforms are only read at flush time, so flush before touching them.
+        if (req.isPortal) rlDrawRenderBatchActive();
+
+        if (shader.id != currentShader) {
+            BeginShaderMode(shader);
+            currentShader = shader.id;
+        }
+
+        if (req.isPortal) {
+            SetShaderValue(portalShader, ShaderSetup::gPortal.portalOpenLoc, &req.openAmount, SHADER_UNIFORM_FLOAT);
+            SetPortalShaderColor(req.pallet.colorA, req.pallet.colorB);
         }
-        SetShaderValue(R.GetShader("portalShader"), ShaderSetup::gPortal.portalOpenLoc, &req.openAmount, SHADER_UNIFORM_FLOAT);
 
-                
         switch (req.type) {
             case Billboard_FacingCamera: //use draw billboard for both decals, and enemies. 
-            case Billboard_Decal:
-                SetPortalShaderColor(req.pallet.colorA, req.pallet.colorB);
-
-                if (req.isPortal) BeginShaderMode(R.GetShader("portalShader"));
-                rlDisableDepthMask(); //DepthMask off...We are going back to manual sorting but with alpha cut out as well. 
-                //This fixes explosion texture occlusion problem, and doesn't break anything else. I think.
-                DrawBillboardRec(
-                    camera,
-                    (req.texture),
-                    src,
-                    req.position,
-                    worldSize,
-                    req.tint
-                );
-
-                rlEnableDepthMask();
+            case Billboard_Decal: {
+                float aspect = (float)req.texture.height / (float)req.texture.width; // 2.0 for 512x1024
+                float sizeY = req.isPortal ? req.size.y * aspect : req.size.y; //HACK, make portals twice as tall.
+
+                Rectangle src = req.sourceRect;
+                if (req.flipX) {
+                    src.width = -src.width; // negative width flips UVs
+                }
+                EmitBillboardQuad(camRight, req.texture, src, req.position, Vector2{ req.size.x, sizeY }, req.tint);
                 break;
+            }
             case Billboard_FixedFlat: //webs and cross quads
-
-                rlDisableDepthMask();   
                 DrawFlatWeb(
                     (req.texture),
+                    req.sourceRect,
                     req.position,
                     req.size.x,
                     req.size.y,
                     req.rotationY,
                     req.tint
                 );
-                rlEnableDepthMask();
                 break;
-                
-
-            case Billboard_Door:
 
+            case Billboard_Door: {
                 float doorWidth  = req.size.x;    // what we pushed from GatherDoors
                 float doorHeight = 365.0f;
-                if (req.isOpen){
-                    rlDisableDepthMask();  // depth writes OFF, Open doors were occluding enemy billboards, so don't write to depth.
-                    DrawFlatDoor( (req.texture),  req.position,  doorWidth,  doorHeight,  req.rotationY,  req.isOpen, req.tint);
-                    rlEnableDepthMask();
-                }else{
-                    rlEnableDepthMask();
-                    DrawFlatDoor( (req.texture),  req.position,  doorWidth,  doorHeight,  req.rotationY,  req.isOpen, req.tint);
-                }      
-                
+                DrawFlatDoor( (req.texture),  req.position,  doorWidth,  doorHeight,  req.rotationY,  req.isOpen, req.tint);
                 break;
+            }
         }
-        EndShaderMode();
-        rlEnableDepthMask();
     }
 }
+
+void DrawTransparentDrawRequests(Camera& camera) {
+    //split and sort compact keys, not the requests
+    cutoutKeys.clear();
+    blendedKeys.clear();
+    uint32_t count = (uint32_t)std::min<size_t>(billboardRequests.size(), BILLBOARD_INDEX_MASK + 1);
+    for (uint32_t i = 0; i < count; i++) {
+        const BillboardDrawRequest& req = billboardRequests[i];
+        if (BillboardIsCutout(req)) cutoutKeys.push_back(MakeBillboardKey(req, i, false));
+        else blendedKeys.push_back(MakeBillboardKey(req, i, true));
+    }
+    RadixSortBillboardKeys(cutoutKeys);
+    RadixSortBillboardKeys(blendedKeys);
+
+    //resolved once, then every lookup in the loop is an index
+    static const ShaderId treeShaderId   = R.FindShaderId("treeShader");
+    static const ShaderId cutoutShaderId = R.FindShaderId("cutoutShader");
+    static const ShaderId portalShaderId = R.FindShaderId("portalShader");
+    Shader& treeShader   = R.GetShader(treeShaderId);
+    Shader& cutoutShader = R.GetShader(cutoutShaderId);
+    Shader& portalShader = R.GetShader(portalShaderId);
+
+    //use alpha cut out shader on everything. treeShader does the fog at a distance thing + alpha cutout
+    Shader& baseShader = isDungeon ? cutoutShader : treeShader;
+    int cutoffLoc    = isDungeon ? ShaderSetup::gAlpha.loc_alphaCutoff : ShaderSetup::gTree.loc_alphaCut;
+    float softCutoff = isDungeon ? ShaderSetup::gAlpha.alphaCutoff     : ShaderSetup::gTree.alphaCutoff;
+
+    Matrix matView = MatrixLookAt(camera.position, camera.target, camera.up);
+    Vector3 camRight = { matView.m0, matView.m4, matView.m8 };
+
+    unsigned int currentShader = 0;
+
+    //Cutout first: solid pixels only, writing depth, so order inside the list doesn't matter.
+    rlDrawRenderBatchActive();
+    rlEnableDepthMask();
+    SetShaderValue(baseShader, cutoffLoc, &BILLBOARD_DEPTH_CUTOFF, SHADER_UNIFORM_FLOAT);
+    DrawBillboardKeys(cutoutKeys, baseShader, portalShader, camRight, currentShader);
+
+    //Then the soft stuff back to front with depth writes off, tested against everything above.
+    //This keeps explosions from punching holes in the billboards behind them.
+    rlDrawRenderBatchActive();
+    SetShaderValue(baseShader, cutoffLoc, &softCutoff, SHADER_UNIFORM_FLOAT);
+    rlDisableDepthMask();
+    DrawBillboardKeys(blendedKeys, baseShader, portalShader, camRight, currentShader);
+
+    rlSetTexture(0);
+    if (currentShader != 0) EndShaderMode(); // flushes the last run
+    else rlDrawRenderBatchActive();
+    rlEnableDepthMask();
+}
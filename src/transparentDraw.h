@@ -40,6 +40,8 @@ struct BillboardDrawRequest {
     PortalPalette pallet = { {0.0f, 0.25f, 1.0f}, {0.5f, 0.2f, 1.0f} };
     
     float openAmount = 0.0f;
+
+    bool blended = false; // soft alpha (fire, flashes): never goes in the depth writing cutout pass
 };
 
 // void GatherGrapplePoint(Camera& camera) {
@@ -72,7 +74,7 @@ void GatherMuzzleFlashes(Camera& camera, const std::vector<MuzzleFlash>& activeM
 void GatherEnemies(Camera& camera);
 void GatherDungeonFires(Camera& camera, float deltaTime);
 void GatherWebs(Camera& camera);
-void GatherDecals(Camera& camera, const std::vector<Decal>& decals);
+void GatherDecals(Camera& camera, const DecalPool& decals);
 void GatherSpawnPortals(Camera& camera);
 void GatherPortals(Camera& camera, const std::vector<Portal>& portals);
 float GetAdjustedBillboardSize(float baseSize, float distance);
@@ -15,6 +15,7 @@
 #include "algorithm"
 #include "shaderSetup.h"
 #include "saveGame.h"
+#include "replay.h"
 
 WeaponBar gWeaponBar;
 std::vector<SlashEffect> gSlashEffects;
@@ -185,7 +186,7 @@ void UpdateInteractionNPC()
         }
 
         // Advance line on E
-        if (IsKeyPressed(KEY_E))
+        if (Replay::IsKeyPressed(KEY_E))
         {
             dialogManager.Advance();
 
@@ -228,7 +229,7 @@ void UpdateInteractionNPC()
     }
 
     // ---- 2) Dialog not active: allow starting a dialog ----
-    if (!IsKeyPressed(KEY_E)) return;
+    if (!Replay::IsKeyPressed(KEY_E)) return;
 
 
     int hermitId = GetHermitIndex();
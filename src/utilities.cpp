@@ -1,5 +1,6 @@
 #include "utilities.h"
 #include <iostream> 
+#include <algorithm>
 
 float SmoothStep01(float t)
 {
@@ -13,8 +14,41 @@ bool InBounds(int x, int y, int w, int h) {
 
 float Clamp01(float x) { return x < 0 ? 0 : (x > 1 ? 1 : x); }
 
+//splitmix64, small and fast. state is a single 64 bit word so it can be saved/restored.
+static unsigned long long gRandomState = 0x9E3779B97F4A7C15ull;
+
+void SeedRandom(unsigned long long seed) {
+    gRandomState = seed;
+}
+
+unsigned long long GetRandomState() {
+    return gRandomState;
+}
+
+void SetRandomState(unsigned long long state) {
+    gRandomState = state;
+}
+
+static unsigned long long NextRandom() {
+    unsigned long long z = (gRandomState += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+int RandomInt(int min, int max) {
+    if (min > max) {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+
+    unsigned long long range = (unsigned long long)((long long)max - (long long)min) + 1ull;
+    return (int)((long long)min + (long long)(NextRandom() % range));
+}
+
 float RandomFloat(float min, float max) {
-    return min + ((float)GetRandomValue(0, 10000) / 10000.0f) * (max - min);
+    return min + ((float)RandomInt(0, 10000) / 10000.0f) * (max - min);
 }
 
 float DistSq(const Vector3& a, const Vector3& b)
@@ -373,4 +407,29 @@ Vector3 DungeonTileCenter(
     p.y = worldY;
     p.z = flippedY * tileSize + tileSize * 0.5f;
     return p;
-}
\ No newline at end of file
+}
+
+static float PercentileSorted(const std::vector<float>& sorted, float p)
+{
+    size_t idx = (size_t)(p * (float)(sorted.size() - 1) + 0.5f);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+FrameTimeStats ComputeFrameTimeStats(std::vector<float> frameTimesMs)
+{
+    FrameTimeStats stats;
+    if (frameTimesMs.empty()) return stats;
+
+    std::sort(frameTimesMs.begin(), frameTimesMs.end());
+
+    double sum = 0.0;
+    for (float ms : frameTimesMs) sum += ms;
+
+    stats.frames = (int)frameTimesMs.size();
+    stats.avgMs = (float)(sum / frameTimesMs.size());
+    stats.p50Ms = PercentileSorted(frameTimesMs, 0.50f);
+    stats.p95Ms = PercentileSorted(frameTimesMs, 0.95f);
+    stats.p99Ms = PercentileSorted(frameTimesMs, 0.99f);
+    stats.maxMs = frameTimesMs.back();
+    return stats;
+}
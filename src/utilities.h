@@ -4,9 +4,17 @@
 #include "raylib.h"
 #include "raymath.h"
 #include <string>
+#include <vector>
 
 
 bool InBounds(int x, int y, int w, int h);
+
+// Seedable gameplay RNG. Use these instead of raylib's GetRandomValue so a
+// replay seeded with the same value rolls the exact same numbers.
+void SeedRandom(unsigned long long seed);
+unsigned long long GetRandomState();
+void SetRandomState(unsigned long long state);
+int RandomInt(int min, int max); // inclusive, same contract as GetRandomValue
 float RandomFloat(float min, float max);
 float Clamp01(float x);
 float LerpExp(float current, float target, float lambda, float dt); 
@@ -32,7 +40,7 @@ Vector3 RandomPointOnRingXZ(const Vector3& center, float minR, float maxR);
 Vector3 RandomPointOnHeightmapRingXZ( const Vector3& center, float minR, float maxR, int terrainWidthPx, float terrainScale, float edgeMargin = 0.0f);
 float DistXZ(const Vector3& a, const Vector3& b);
 
-inline float Rand01() { return (float)GetRandomValue(0, 1000) / 1000.0f; }
+inline float Rand01() { return (float)RandomInt(0, 1000) / 1000.0f; }
 Vector3 DirFromYawDeg(float yawDeg);
 float DirectionToYawDeg(Vector3 dir);
 float DistSq(const Vector3& a, const Vector3& b);
@@ -55,3 +63,15 @@ Color TintFromDarkness(float darkness, Color base = {255,255,255,255});
 Vector3 MakeTerrainWaterColor(Vector3 skyTopColor);
 
 Vector3 DungeonTileCenter(int x, int y, int dungeonW, int dungeonH, float tileSize, float worldY);
+
+// Frame time summary in milliseconds (replay playback and --benchmark).
+struct FrameTimeStats {
+    int frames = 0;
+    float avgMs = 0.0f;
+    float p50Ms = 0.0f;
+    float p95Ms = 0.0f;
+    float p99Ms = 0.0f;
+    float maxMs = 0.0f;
+};
+
+FrameTimeStats ComputeFrameTimeStats(std::vector<float> frameTimesMs);
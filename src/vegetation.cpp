@@ -12,39 +12,39 @@
 #include "shadows.h"
 #include "utilities.h"
 #include "game_settings.h"
+#include "heightfield.h"
 
 
 
 std::vector<TreeInstance> trees;
 std::vector<BushInstance> bushes;
-std::vector<const TreeInstance*> sortedTrees;
 
 float GetRandomTreeScale()
 {
     // 0 - 99
-    int roll = GetRandomValue(0, 99);
+    int roll = RandomInt(0, 99);
 
     // Base scale ranges.
     // Tweak these numbers until they look right with your palm model.
     if (roll < 45)
     {
         // Small: 45% chance
-        return GetRandomValue(70, 90) / 100.0f;      // 0.70 - 0.90
+        return RandomInt(70, 90) / 100.0f;      // 0.70 - 0.90
     }
     else if (roll < 80)
     {
         // Medium: 35% chance
-        return GetRandomValue(90, 115) / 100.0f;     // 0.90 - 1.15
+        return RandomInt(90, 115) / 100.0f;     // 0.90 - 1.15
     }
     else if (roll < 97)
     {
         // Large: 17% chance
-        return GetRandomValue(115, 145) / 100.0f;    // 1.15 - 1.45
+        return RandomInt(115, 145) / 100.0f;    // 1.15 - 1.45
     }
     else
     {
         // Extra large: 3% chance
-        return GetRandomValue(145, 180) / 100.0f;    // 1.45 - 1.80
+        return RandomInt(145, 180) / 100.0f;    // 1.45 - 1.80
     }
 }
 
@@ -70,20 +70,11 @@ BoundingBox GetTreeAABB(const TreeInstance& t)
 
 
 
-void sortTrees(Camera& camera){
-    // Sort farthest to nearest (back-to-front)
-    std::sort(sortedTrees.begin(), sortedTrees.end(), [&](const TreeInstance* a, const TreeInstance* b) {
-        float da = Vector3Distance(camera.position, a->position);
-        float db = Vector3Distance(camera.position, b->position);
-        return da > db; // draw farther trees first
-    });
-}
-
 TreeType RandomTreeType()
 {
     //TODO: Get random palm tree, get random swamp tree. 
     int count = static_cast<int>(TreeType::COUNT);
-    int r = GetRandomValue(0, count - 1); // raylib RNG
+    int r = RandomInt(0, count - 1); // gameplay RNG
     return static_cast<TreeType>(r);
 }
 
@@ -96,32 +87,28 @@ void generateVegetation(){
 
     float treeHeightThreshold = terrainScale.y * 0.8f;
     //float bushHeightThreshold = terrainScale.y * 0.9f;
-    heightmapPixels = (unsigned char*)heightmap.data; //for iterating heightmap data for tree placement
     // Generate the trees
-    trees = GenerateTrees(heightmap, heightmapPixels, terrainScale, treeSpacing, minTreeSpacing, treeHeightThreshold);
-    //bushes = GenerateBushes(heightmap, heightmapPixels, terrainScale, treeSpacing, bushHeightThreshold);
+    trees = GenerateTrees(gHeightField, terrainScale, treeSpacing, minTreeSpacing, treeHeightThreshold);
+    //bushes = GenerateBushes(gHeightField, terrainScale, treeSpacing, bushHeightThreshold);
     //we now do flat quad bushes. 
     auto treesOnLand = FilterInstancesOnLand<TreeInstance>(
         trees,
         [](const TreeInstance& t) { return t.position; },
-        heightmap, heightmapPixels, terrainScale,
+        terrainScale,
         waterHeightY, 80.0f, 120.0f
     );
 
     auto bushesOnLand = FilterInstancesOnLand<BushInstance>(
         bushes,
         [](const BushInstance& b) { return b.position; }, // or b.pos, whatever you named it
-        heightmap, heightmapPixels, terrainScale,
+        terrainScale,
         waterHeightY, 40.0f, 60.0f
     );
 
     trees = treesOnLand;
     bushes = bushesOnLand;
 
-
-    // for (const auto& tree : trees) { 
-    //     sortedTrees.push_back(&tree); //trees no longer need to be sorted, alpha cutoff shader solves the issue. 
-    // }
+    //trees are never sorted, the alpha cutoff shader + depth writes solve draw order.
 
     // Define world XZ bounds from your terrainScale (centered at origin)
     Rectangle worldXZ = {
@@ -141,8 +128,7 @@ void generateVegetation(){
 }
 
 std::vector<TreeInstance> GenerateTrees(
-    Image& heightmap,
-    unsigned char* pixels,
+    const HeightField& field,
     Vector3 terrainScale,
     float treeSpacing,
     float minTreeSpacing,
@@ -151,11 +137,14 @@ std::vector<TreeInstance> GenerateTrees(
 {
     std::vector<TreeInstance> trees;
 
-    if (!pixels || heightmap.width <= 0 || heightmap.height <= 0)
+    if (!field.IsValid())
     {
         return trees;
     }
 
+    const int width = field.Width();
+    const int height = field.Height();
+
     int step = (int)treeSpacing;
     if (step < 1) step = 1;
 
@@ -167,21 +156,19 @@ std::vector<TreeInstance> GenerateTrees(
     const float entranceClearRadius = treeSpacing * 2.0f;
     const float entranceClearRadiusSq = entranceClearRadius * entranceClearRadius;
 
-    for (int z = 0; z < heightmap.height; z += step)
+    for (int z = 0; z < height; z += step)
     {
-        for (int x = 0; x < heightmap.width; x += step)
+        for (int x = 0; x < width; x += step)
         {
-            int i = z * heightmap.width + x;
-
-            float height = ((float)pixels[i] / 255.0f) * terrainScale.y;
+            float groundY = field.TexelHeight(x, z);
 
-            if (height <= treeHeightThreshold)
+            if (groundY <= treeHeightThreshold)
                 continue;
 
             Vector3 pos = {
-                (float)x / (float)heightmap.width  * terrainScale.x - terrainScale.x * 0.5f,
-                height - 5.0f, // sink the tree into the ground a little
-                (float)z / (float)heightmap.height * terrainScale.z - terrainScale.z * 0.5f
+                (float)x / (float)width  * terrainScale.x - terrainScale.x * 0.5f,
+                groundY - 5.0f, // sink the tree into the ground a little
+                (float)z / (float)height * terrainScale.z - terrainScale.z * 0.5f
             };
 
             bool tooClose = false;
@@ -227,13 +214,13 @@ std::vector<TreeInstance> GenerateTrees(
             // NOTE:
             // If your tree drawing expects degrees, keep this as degrees.
             // If it expects radians, change this to RandomFloat(0, PI * 2).
-            tree.rotationY = (float)GetRandomValue(0, 359);
+            tree.rotationY = (float)RandomInt(0, 359);
 
-            tree.scale = 20.0f + ((float)GetRandomValue(0, 1000) / 100.0f); // 20.0 - 30.0
-            tree.yOffset = ((float)GetRandomValue(-600, 200)) / 100.0f;     // -6.0 to 2.0
-            tree.xOffset = (float)GetRandomValue(-(int)treeSpacing, (int)treeSpacing);
-            tree.zOffset = (float)GetRandomValue(-(int)treeSpacing, (int)treeSpacing);
-            tree.useAltModel = GetRandomValue(0, 1);
+            tree.scale = 20.0f + ((float)RandomInt(0, 1000) / 100.0f); // 20.0 - 30.0
+            tree.yOffset = ((float)RandomInt(-600, 200)) / 100.0f;     // -6.0 to 2.0
+            tree.xOffset = (float)RandomInt(-(int)treeSpacing, (int)treeSpacing);
+            tree.zOffset = (float)RandomInt(-(int)treeSpacing, (int)treeSpacing);
+            tree.useAltModel = RandomInt(0, 1);
             tree.randomScale = GetRandomTreeScale();
             tree.cullFactor = 1.15f;
 
@@ -247,38 +234,6 @@ std::vector<TreeInstance> GenerateTrees(
     return trees;
 }
 
-static inline float SampleHeightBilinear_U8(
-    const unsigned char* px, int w, int h,
-    float u, float v) // u,v in [0..1]
-{
-    u = Clamp01(u);
-    v = Clamp01(v);
-
-    float x = u * (w - 1);
-    float y = v * (h - 1);
-
-    int x0 = (int)x;
-    int y0 = (int)y;
-    int x1 = (x0 + 1 < w) ? x0 + 1 : x0;
-    int y1 = (y0 + 1 < h) ? y0 + 1 : y0;
-
-    float tx = x - x0;
-    float ty = y - y0;
-
-    auto H = [&](int ix, int iy) -> float {
-        return (float)px[iy * w + ix] / 255.0f;
-    };
-
-    float h00 = H(x0, y0);
-    float h10 = H(x1, y0);
-    float h01 = H(x0, y1);
-    float h11 = H(x1, y1);
-
-    float hx0 = h00 + (h10 - h00) * tx;
-    float hx1 = h01 + (h11 - h01) * tx;
-    return hx0 + (hx1 - hx0) * ty;
-}
-
 static inline void WorldXZ_ToHeightUV(
     float worldX, float worldZ,
     const Vector3& terrainScale, // terrain spans [-sx/2..+sx/2], [-sz/2..+sz/2]
@@ -292,8 +247,6 @@ template<typename T, typename GetPosFn>
 std::vector<T> FilterInstancesOnLand(
     const std::vector<T>& input,
     GetPosFn&& getPos, 
-    const Image& heightmap,
-    const unsigned char* pixels,
     const Vector3& terrainScale,
     float seaLevelWorldY,
     float shoreMarginWorldY,
@@ -303,11 +256,7 @@ std::vector<T> FilterInstancesOnLand(
     std::vector<T> out;
     out.reserve(input.size());
 
-    const int w = heightmap.width;
-    const int h = heightmap.height;
-
-    const float du = (terrainScale.x > 0.0f) ? (trunkRadiusWorld / terrainScale.x) : 0.0f;
-    const float dv = (terrainScale.z > 0.0f) ? (trunkRadiusWorld / terrainScale.z) : 0.0f;
+    const float r = trunkRadiusWorld;
 
     const float landMinY = seaLevelWorldY + shoreMarginWorldY;
 
@@ -319,19 +268,18 @@ std::vector<T> FilterInstancesOnLand(
         WorldXZ_ToHeightUV(p.x, p.z, terrainScale, u, v);
         if (u < 0.0f || u > 1.0f || v < 0.0f || v > 1.0f) continue;
 
-        float hC01 = SampleHeightBilinear_U8(pixels, w, h, u, v);
-        float hE01 = SampleHeightBilinear_U8(pixels, w, h, u + du, v);
-        float hW01 = SampleHeightBilinear_U8(pixels, w, h, u - du, v);
-        float hN01 = SampleHeightBilinear_U8(pixels, w, h, u, v - dv);
-        float hS01 = SampleHeightBilinear_U8(pixels, w, h, u, v + dv);
-
-        float yC = hC01 * terrainScale.y;
-        float yE = hE01 * terrainScale.y;
-        float yW = hW01 * terrainScale.y;
-        float yN = hN01 * terrainScale.y;
-        float yS = hS01 * terrainScale.y;
-
-        float yMin = std::min(std::min(std::min(yC, yE), std::min(yW, yN)), yS);
+        // center + four points a trunk radius out, in one batch
+        const Vector3 probes[5] = {
+            { p.x,     0.0f, p.z     },
+            { p.x + r, 0.0f, p.z     },
+            { p.x - r, 0.0f, p.z     },
+            { p.x,     0.0f, p.z - r },
+            { p.x,     0.0f, p.z + r },
+        };
+        float y[5];
+        gHeightField.SampleHeights(probes, y, 5);
+
+        float yMin = std::min(std::min(std::min(y[0], y[1]), std::min(y[2], y[3])), y[4]);
         if (yMin < landMinY) continue;
 
         out.push_back(inst);
@@ -341,22 +289,20 @@ std::vector<T> FilterInstancesOnLand(
 }
 
 
-std::vector<TreeInstance> FilterTreesAboveHeightThreshold(const std::vector<TreeInstance>& inputTrees, Image& heightmap,
-                                                          unsigned char* pixels, Vector3 terrainScale,
-                                                          float treeHeightThreshold) {
+std::vector<TreeInstance> FilterTreesAboveHeightThreshold(const std::vector<TreeInstance>& inputTrees, const HeightField& field,
+                                                          Vector3 terrainScale, float treeHeightThreshold) {
     std::vector<TreeInstance> filtered;
 
     for (const auto& tree : inputTrees) {
         float xPercent = (tree.position.x + terrainScale.x / 2) / terrainScale.x;
         float zPercent = (tree.position.z + terrainScale.z / 2) / terrainScale.z;
 
-        int xPixel = (int)(xPercent * heightmap.width);
-        int zPixel = (int)(zPercent * heightmap.height);
+        int xPixel = (int)(xPercent * field.Width());
+        int zPixel = (int)(zPercent * field.Height());
 
-        if (xPixel < 0 || xPixel >= heightmap.width || zPixel < 0 || zPixel >= heightmap.height) continue;
+        if (xPixel < 0 || xPixel >= field.Width() || zPixel < 0 || zPixel >= field.Height()) continue;
 
-        int i = zPixel * heightmap.width + xPixel;
-        float height = ((float)pixels[i] / 255.0f) * terrainScale.y;
+        float height = field.TexelHeight(xPixel, zPixel);
 
         if (height > treeHeightThreshold * tree.cullFactor) {
             filtered.push_back(tree);
@@ -367,8 +313,7 @@ std::vector<TreeInstance> FilterTreesAboveHeightThreshold(const std::vector<Tree
 }
 
 std::vector<BushInstance> GenerateBushes(
-    Image& heightmap,
-    unsigned char* pixels,
+    const HeightField& field,
     Vector3 terrainScale,
     float bushSpacing,
     float heightThreshold
@@ -376,11 +321,14 @@ std::vector<BushInstance> GenerateBushes(
 {
     std::vector<BushInstance> bushes;
 
-    if (!pixels || heightmap.width <= 0 || heightmap.height <= 0)
+    if (!field.IsValid())
     {
         return bushes;
     }
 
+    const int width = field.Width();
+    const int height = field.Height();
+
     int step = (int)bushSpacing;
     if (step < 1) step = 1;
 
@@ -391,39 +339,37 @@ std::vector<BushInstance> GenerateBushes(
 
     Model bushModel = R.GetModel("bush");
 
-    for (int z = 0; z < heightmap.height; z += step)
+    for (int z = 0; z < height; z += step)
     {
-        for (int x = 0; x < heightmap.width; x += step)
+        for (int x = 0; x < width; x += step)
         {
-            int i = z * heightmap.width + x;
-
-            float height = ((float)pixels[i] / 255.0f) * terrainScale.y;
+            float groundY = field.TexelHeight(x, z);
 
-            if (height <= heightThreshold)
+            if (groundY <= heightThreshold)
                 continue;
 
             Vector3 pos = {
-                (float)x / (float)heightmap.width  * terrainScale.x - terrainScale.x * 0.5f,
-                height - 5.0f,
-                (float)z / (float)heightmap.height * terrainScale.z - terrainScale.z * 0.5f
+                (float)x / (float)width  * terrainScale.x - terrainScale.x * 0.5f,
+                groundY - 5.0f,
+                (float)z / (float)height * terrainScale.z - terrainScale.z * 0.5f
             };
 
             if (Vector3DistanceSqr(pos, startPosition) < startClearRadiusSq)
                 continue;
 
             // Keep your random 75% spawn chance.
-            if (GetRandomValue(1, 4) <= 1)
+            if (RandomInt(1, 4) <= 1)
                 continue;
 
             BushInstance bush;
             bush.position = pos;
-            bush.scale = 100.0f + ((float)GetRandomValue(0, 1000) / 100.0f);
+            bush.scale = 100.0f + ((float)RandomInt(0, 1000) / 100.0f);
             bush.model = bushModel;
 
-            bush.yOffset = ((float)GetRandomValue(-200, 200)) / 100.0f; // -2.0 to 2.0
+            bush.yOffset = ((float)RandomInt(-200, 200)) / 100.0f; // -2.0 to 2.0
 
-            bush.xOffset = (float)GetRandomValue(-jitterRange, jitterRange);
-            bush.zOffset = (float)GetRandomValue(-jitterRange, jitterRange);
+            bush.xOffset = (float)RandomInt(-jitterRange, jitterRange);
+            bush.zOffset = (float)RandomInt(-jitterRange, jitterRange);
 
             // Aggressively cull bushes. As high as it can be before no bushes.
             bush.cullFactor = 1.09f;
@@ -435,22 +381,20 @@ std::vector<BushInstance> GenerateBushes(
     return bushes;
 }
 
-std::vector<BushInstance> FilterBushsAboveHeightThreshold(const std::vector<BushInstance>& inputBushes, Image& heightmap,
-                                                          unsigned char* pixels, Vector3 terrainScale,
-                                                          float treeHeightThreshold) {
+std::vector<BushInstance> FilterBushsAboveHeightThreshold(const std::vector<BushInstance>& inputBushes, const HeightField& field,
+                                                          Vector3 terrainScale, float treeHeightThreshold) {
     std::vector<BushInstance> filtered;
 
     for (const auto& bush : inputBushes) {
         float xPercent = (bush.position.x + terrainScale.x / 2) / terrainScale.x;
         float zPercent = (bush.position.z + terrainScale.z / 2) / terrainScale.z;
 
-        int xPixel = (int)(xPercent * heightmap.width);
-        int zPixel = (int)(zPercent * heightmap.height);
+        int xPixel = (int)(xPercent * field.Width());
+        int zPixel = (int)(zPercent * field.Height());
 
-        if (xPixel < 0 || xPixel >= heightmap.width || zPixel < 0 || zPixel >= heightmap.height) continue;
+        if (xPixel < 0 || xPixel >= field.Width() || zPixel < 0 || zPixel >= field.Height()) continue;
 
-        int i = zPixel * heightmap.width + xPixel;
-        float height = ((float)pixels[i] / 255.0f) * terrainScale.y;
+        float height = field.TexelHeight(xPixel, zPixel);
 
         if (height > treeHeightThreshold * bush.cullFactor) {
             filtered.push_back(bush);
@@ -463,6 +407,5 @@ std::vector<BushInstance> FilterBushsAboveHeightThreshold(const std::vector<Bush
 void RemoveAllVegetation() {
     trees.clear();
     bushes.clear();
-    sortedTrees.clear();
 
 }
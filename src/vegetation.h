@@ -5,6 +5,7 @@
 #include "raylib.h"
 #include <vector>
 #include <stdint.h>
+#include "heightfield.h"
 
 enum class TreeType : uint8_t
 {
@@ -48,33 +49,27 @@ struct BushInstance {
 
 extern std::vector<TreeInstance> trees;
 extern std::vector<BushInstance> bushes;
-extern std::vector<const TreeInstance*> sortedTrees;
 
 
 void generateVegetation();
 void RemoveAllVegetation();
-void sortTrees(Camera& camera);
 BoundingBox GetTreeAABB(const TreeInstance& t);
 float GetRandomTreeScale();
 
-std::vector<TreeInstance> GenerateTrees(Image& heightmap, unsigned char* pixels, Vector3 terrainScale,
+std::vector<TreeInstance> GenerateTrees(const HeightField& field, Vector3 terrainScale,
                                         float treeSpacing, float minTreeSpacing, float treeHeightThreshold);
 
-std::vector<TreeInstance> FilterTreesAboveHeightThreshold(const std::vector<TreeInstance>& inputTrees, Image& heightmap,
-                                                          unsigned char* pixels, Vector3 terrainScale,
-                                                          float treeHeightThreshold);
+std::vector<TreeInstance> FilterTreesAboveHeightThreshold(const std::vector<TreeInstance>& inputTrees, const HeightField& field,
+                                                          Vector3 terrainScale, float treeHeightThreshold);
 
-std::vector<BushInstance> GenerateBushes(Image& heightmap, unsigned char* pixels, Vector3 terrainScale,
+std::vector<BushInstance> GenerateBushes(const HeightField& field, Vector3 terrainScale,
                                          float bushSpacing, float heightThreshold);
-std::vector<BushInstance> FilterBushsAboveHeightThreshold(const std::vector<BushInstance>& inputTrees, Image& heightmap,
-                                                          unsigned char* pixels, Vector3 terrainScale,
-                                                          float treeHeightThreshold);
+std::vector<BushInstance> FilterBushsAboveHeightThreshold(const std::vector<BushInstance>& inputTrees, const HeightField& field,
+                                                          Vector3 terrainScale, float treeHeightThreshold);
 template<typename T, typename GetPosFn>
 std::vector<T> FilterInstancesOnLand(
     const std::vector<T>& input,
     GetPosFn&& getPos, 
-    const Image& heightmap,
-    const unsigned char* pixels,
     const Vector3& terrainScale,
     float seaLevelWorldY,
     float shoreMarginWorldY,
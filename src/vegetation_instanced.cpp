@@ -1,19 +1,21 @@
 #include "vegetation_instanced.h"
 
 #include "raymath.h"
+#include "rlgl.h"
 #include "resourceManager.h"
 #include "world.h"
 #include "game_settings.h"
 #include "shadows.h"
 #include "utilities.h"
 #include "shaderSetup.h"
-#include "viewCone.h"
+#include "frustum.h"
 #include "grass.h"
+#include "terrainChunking.h"
 
 #include <algorithm>
+#include <random>
 
-// These are the CPU-side instance batches.
-// Each batch = one model drawn with DrawMeshInstanced().
+// Instance batches, one per model. Transforms stay on the GPU, see BuildBatchCells.
 static VegetationInstanceBatch gPalmTreeBatch;
 static VegetationInstanceBatch gBushBatch;
 
@@ -53,40 +55,162 @@ static void PushInstance(
     batch.transforms.push_back(MakeInstanceTransform(position, rotationYDeg, scale));
 }
 
-static void DrawBatch(VegetationInstanceBatch& batch, Camera& camera)
+static Model& BatchModel(VegetationInstanceBatch& batch)
 {
-    if (batch.transforms.empty()) return;
+    return batch.modelId.IsValid() ? R.GetModel(batch.modelId) : R.GetModel(batch.modelName);
+}
+
+void VegetationInstanceBatch::Clear()
+{
+    if (instanceVbo != 0) rlUnloadVertexBuffer(instanceVbo);
+    instanceVbo = 0;
+    transforms.clear();
+    positions.clear();
+    cells.clear();
+    bvh.Clear();
+    visibleCells.clear();
+    ranges.clear();
+    drawnInstances = 0;
+}
+
+// Cells line up with terrain chunks, so a cell goes off screen together with its ground.
+struct VegetationCellGrid
+{
+    float originX = 0.0f;
+    float originZ = 0.0f;
+    float sizeX = 4000.0f;
+    float sizeZ = 4000.0f;
+};
 
-    batch.visibleTransforms.clear();
+static VegetationCellGrid MakeCellGrid()
+{
+    VegetationCellGrid grid;
+    if (terrain.tilesX > 0 && terrain.tilesZ > 0 && terrain.heightmapW > 1 && terrain.heightmapH > 1)
+    {
+        grid.originX = -terrain.terrainScale.x * 0.5f;
+        grid.originZ = -terrain.terrainScale.z * 0.5f;
+        grid.sizeX = terrain.terrainScale.x * (terrain.tileRes - 1) / (float)(terrain.heightmapW - 1);
+        grid.sizeZ = terrain.terrainScale.z * (terrain.tileRes - 1) / (float)(terrain.heightmapH - 1);
+    }
+    return grid;
+}
 
-    const float cullDist = GameSettings::maxDrawDist;
-    const float cullDistSq = cullDist * cullDist;
+// Z-order of the cell coordinates, neighbouring cells end up next to each other in the buffer.
+static uint32_t CellKey(const VegetationCellGrid& grid, Vector3 pos)
+{
+    int cx = (int)floorf((pos.x - grid.originX) / grid.sizeX) + 32768;
+    int cz = (int)floorf((pos.z - grid.originZ) / grid.sizeZ) + 32768;
+    cx = std::clamp(cx, 0, 65535);
+    cz = std::clamp(cz, 0, 65535);
+    return ZOrderKey((uint32_t)cx, (uint32_t)cz);
+}
 
-    ViewConeParams vp = MakeViewConeParams(
-        camera,
-        55.0f,      // cone half-angle or whatever your function expects
-        cullDist,
-        400.0f      // non-cull radius around player/camera
-    );
+// Sorts the batch into cells, builds the cell tree and uploads the transforms.
+static void BuildBatchCells(VegetationInstanceBatch& batch, const VegetationCellGrid& grid)
+{
+    if (batch.transforms.empty()) return;
 
-    for (int i = 0; i < (int)batch.transforms.size(); ++i)
+    const int n = (int)batch.transforms.size();
+    std::vector<uint32_t> keys(n);
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++)
     {
-        const Vector3& pos = batch.positions[i];
+        keys[i] = CellKey(grid, batch.positions[i]);
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return keys[a] < keys[b]; });
 
-        float distSq = Vector3DistanceSqr(camera.position, pos);
+    std::vector<Matrix> sortedTransforms(n);
+    std::vector<Vector3> sortedPositions(n);
+    BoundingBox local = GetModelBoundingBox(BatchModel(batch));
+    std::vector<BoundingBox> cellBoxes;
 
-        if (distSq > cullDistSq)
-            continue;
+    int i = 0;
+    while (i < n)
+    {
+        uint32_t key = keys[order[i]];
+        int end = i;
+        while (end < n && keys[order[end]] == key) end++;
+
+        // same seed every run, so thinning picks the same instances each time
+        std::mt19937 rng(key);
+        std::shuffle(order.begin() + i, order.begin() + end, rng);
+
+        VegetationCell cell;
+        cell.first = i;
+        cell.count = end - i;
+        for (int k = i; k < end; k++)
+        {
+            sortedTransforms[k] = batch.transforms[order[k]];
+            sortedPositions[k] = batch.positions[order[k]];
 
-        if (!IsInViewCone(vp, pos))
-            continue;
+            BoundingBox box = TransformAABB(local, sortedTransforms[k]);
+            if (k == i) cell.bounds = box;
+            cell.bounds.min = Vector3Min(cell.bounds.min, box.min);
+            cell.bounds.max = Vector3Max(cell.bounds.max, box.max);
+        }
 
-        batch.visibleTransforms.push_back(batch.transforms[i]);
+        batch.cells.push_back(cell);
+        cellBoxes.push_back(cell.bounds);
+        i = end;
     }
 
-    if (batch.visibleTransforms.empty()) return;
+    batch.transforms.swap(sortedTransforms);
+    batch.positions.swap(sortedPositions);
+    batch.bvh.Build(cellBoxes);
+
+    batch.instanceVbo = UploadInstanceTransforms(batch.transforms);
+    if (batch.instanceVbo == 0) TraceLog(LOG_WARNING, "VEG INST: failed to upload %s transforms", batch.modelName.c_str());
+}
+
+// How many of a cell's instances to draw at this distance.
+static int CellDrawCount(const VegetationInstanceBatch& batch, const VegetationCell& cell, Vector3 camPos)
+{
+    if (!batch.densityFalloff) return cell.count;
+
+    // XZ distance to the nearest point of the cell
+    float dx = std::max({ cell.bounds.min.x - camPos.x, 0.0f, camPos.x - cell.bounds.max.x });
+    float dz = std::max({ cell.bounds.min.z - camPos.z, 0.0f, camPos.z - cell.bounds.max.z });
+    float dist = sqrtf(dx * dx + dz * dz);
+
+    float span = GameSettings::grassMinDensityDist - GameSettings::grassFullDensityDist;
+    float t = (span > 0.0f) ? Clamp((dist - GameSettings::grassFullDensityDist) / span, 0.0f, 1.0f) : 0.0f;
+    float density = Lerp(1.0f, GameSettings::grassMinDensity, t);
 
-    Model& model = R.GetModel(batch.modelName.c_str());
+    return std::clamp((int)ceilf(cell.count * density), 1, cell.count);
+}
+
+static void DrawBatch(VegetationInstanceBatch& batch, Camera& camera, const Frustum& frustum)
+{
+    batch.visibleCells.clear();
+    batch.ranges.clear();
+    batch.drawnInstances = 0;
+    if (batch.cells.empty()) return;
+
+    batch.bvh.Query(frustum, batch.visibleCells);
+
+    // buffer order, so neighbouring full cells merge into one range
+    std::sort(batch.visibleCells.begin(), batch.visibleCells.end());
+    for (int c : batch.visibleCells)
+    {
+        const VegetationCell& cell = batch.cells[c];
+        int count = CellDrawCount(batch, cell, camera.position);
+        AppendInstanceRange(batch.ranges, cell.first, count, 0);
+        batch.drawnInstances += count;
+    }
+
+    if (batch.ranges.empty()) return;
+
+    Model& model = BatchModel(batch);
+
+    // no resident buffer (upload failed), send the visible ranges the old way
+    static std::vector<Matrix> scratch;
+    if (batch.instanceVbo == 0)
+    {
+        scratch.clear();
+        for (const InstanceRange& r : batch.ranges)
+            scratch.insert(scratch.end(), batch.transforms.begin() + r.first, batch.transforms.begin() + r.first + r.count);
+    }
 
     for (int meshIndex = 0; meshIndex < model.meshCount; ++meshIndex)
     {
@@ -97,12 +221,14 @@ static void DrawBatch(VegetationInstanceBatch& batch, Camera& camera)
             matIndex = 0;
         }
 
-        DrawMeshInstanced(
-            model.meshes[meshIndex],
-            model.materials[matIndex],
-            batch.visibleTransforms.data(),
-            (int)batch.visibleTransforms.size()
-        );
+        if (batch.instanceVbo != 0)
+        {
+            DrawMeshInstancedRanges(model.meshes[meshIndex], model.materials[matIndex], batch.instanceVbo, batch.ranges);
+        }
+        else
+        {
+            DrawMeshInstanced(model.meshes[meshIndex], model.materials[matIndex], scratch.data(), (int)scratch.size());
+        }
     }
 }
 
@@ -142,6 +268,13 @@ namespace VegetationInstanced
             gGrassBatches[i].modelName = grassModelNames[i];
         }
 
+        gPalmTreeBatch.modelId = R.FindModelId(gPalmTreeBatch.modelName);
+        gBushBatch.modelId = R.FindModelId(gBushBatch.modelName);
+        for (int i = 0; i < 4; i++)
+        {
+            gGrassBatches[i].modelId = R.FindModelId(gGrassBatches[i].modelName);
+        }
+
         
 
         generateVegetation(); //old generation code builds vector of tree stuct with position, rotation, scale
@@ -185,18 +318,30 @@ namespace VegetationInstanced
 
         //     PushInstance(gBushBatch, pos, bush.rotationY, bush.scale);
         // }
+
+        VegetationCellGrid grid = MakeCellGrid();
+        BuildBatchCells(gPalmTreeBatch, grid);
+        BuildBatchCells(gBushBatch, grid);
+        for (int i = 0; i < 4; i++)
+        {
+            gGrassBatches[i].densityFalloff = true;
+            BuildBatchCells(gGrassBatches[i], grid);
+        }
     }
 
     void Draw(Camera& camera)
     {
         if (showVeg){
-            SetShaderValues(camera);
-            DrawBatch(gPalmTreeBatch, camera);
-            //DrawBatch(gBushBatch, camera);
+            SetShaderValues();
+
+            // far plane at the draw distance, whole cells tested by their bounds
+            Frustum frustum = MakeCameraFrustum(camera, GameSettings::maxDrawDist);
+            DrawBatch(gPalmTreeBatch, camera, frustum);
+            //DrawBatch(gBushBatch, camera, frustum);
 
             for (int i = 0; i < 4; i++)
             {
-                DrawBatch(gGrassBatches[i], camera);
+                DrawBatch(gGrassBatches[i], camera, frustum);
             }
         }
 
@@ -220,13 +365,11 @@ namespace VegetationInstanced
 
     int GetVisibleInstanceCount()
     {
-        int total =
-            (int)gPalmTreeBatch.visibleTransforms.size() +
-            (int)gBushBatch.visibleTransforms.size();
+        int total = gPalmTreeBatch.drawnInstances + gBushBatch.drawnInstances;
 
         for (int i = 0; i < 4; i++)
         {
-            total += (int)gGrassBatches[i].visibleTransforms.size();
+            total += gGrassBatches[i].drawnInstances;
         }
 
         return total;
@@ -253,15 +396,10 @@ namespace VegetationInstanced
     static Shader gShader = {};
 
     static int locAlphaCutoff = -1;
-    static int locCameraPos = -1;
-    static int locSkyTop = -1;
-    static int locSkyHorizon = -1;
     static int locFogStart = -1;
     static int locFogEnd = -1;
     static int locSeaLevel = -1;
     static int locFogHeightFalloff = -1;
-    static int locUseFog = -1;
-    static int locModelNightDarkness = -1;
 
     bool showVeg = true;
 
@@ -291,15 +429,10 @@ namespace VegetationInstanced
             GetShaderLocation(gShader, "colDiffuse");
 
         locAlphaCutoff        = GetShaderLocation(gShader, "alphaCutoff");
-        locCameraPos          = GetShaderLocation(gShader, "cameraPos");
-        locSkyTop             = GetShaderLocation(gShader, "u_SkyColorTop");
-        locSkyHorizon         = GetShaderLocation(gShader, "u_SkyColorHorizon");
         locFogStart           = GetShaderLocation(gShader, "u_FogStart");
         locFogEnd             = GetShaderLocation(gShader, "u_FogEnd");
         locSeaLevel           = GetShaderLocation(gShader, "u_SeaLevel");
         locFogHeightFalloff   = GetShaderLocation(gShader, "u_FogHeightFalloff");
-        locUseFog             = GetShaderLocation(gShader, "u_UseFog");
-        locModelNightDarkness = GetShaderLocation(gShader, "u_ModelNightDarkness");
 
         ApplyInstancedShaderToModel(R.GetModel("palmTreeInstanced"), gShader);
         //ApplyInstancedShaderToModel(R.GetModel("bushInstanced"), gShader);
@@ -313,11 +446,10 @@ namespace VegetationInstanced
     }
 }
 
-void VegetationInstanced::SetShaderValues(Camera& camera)
+void VegetationInstanced::SetShaderValues()
 {
-    Vector3 camPos = camera.position;
-    Vector3 topFogColor = ShaderSetup::GetCurrentSkyTopFogColor();
-    Vector3 fogHor = ShaderSetup::GetCurrentSkyFogColor();
+    // cameraPos, sky colors, useFog and night darkness are pushed once per frame
+    // by ShaderSetup::UpdateFrameUniforms().
     float fogStart = (currentGameState == GameState::Menu) ? GameSettings::instancedFogStartMenu :  GameSettings::instancedFogStart;
     float fogEnd    = GameSettings::instancedFogEnd;
     float seaLevel  = 400.0f; // Visual fog height base, not literal ocean height
@@ -325,21 +457,10 @@ void VegetationInstanced::SetShaderValues(Camera& camera)
 
     float alphaCutoff = 0.50f;
 
-    SetShaderValue(gShader, locCameraPos, &camPos, SHADER_UNIFORM_VEC3);
-
     SetShaderValue(gShader, locAlphaCutoff, &alphaCutoff, SHADER_UNIFORM_FLOAT);
 
-    SetShaderValue(gShader, locSkyTop, &topFogColor, SHADER_UNIFORM_VEC3);
-    SetShaderValue(gShader, locSkyHorizon, &fogHor, SHADER_UNIFORM_VEC3);
-
     SetShaderValue(gShader, locFogStart, &fogStart, SHADER_UNIFORM_FLOAT);
     SetShaderValue(gShader, locFogEnd, &fogEnd, SHADER_UNIFORM_FLOAT);
     SetShaderValue(gShader, locSeaLevel, &seaLevel, SHADER_UNIFORM_FLOAT);
     SetShaderValue(gShader, locFogHeightFalloff, &falloff, SHADER_UNIFORM_FLOAT);
-
-    int useFog = GameSettings::useFog;
-    SetShaderValue(gShader, locUseFog, &useFog, SHADER_UNIFORM_INT);
-
-    float nightDarkness = ShaderSetup::gSky.skyTransition;
-    SetShaderValue(gShader, locModelNightDarkness, &nightDarkness, SHADER_UNIFORM_FLOAT);
 }
\ No newline at end of file
@@ -2,30 +2,47 @@
 
 #include "raylib.h"
 #include "vegetation.h"
+#include "resourceManager.h"
 #include <vector>
 #include <string>
+#include "static_bvh.h"
+#include "instanced_draw.h"
+
+// Instances of one batch that sit over the same terrain chunk. Culled, and thinned out
+// with distance, as a whole.
+struct VegetationCell
+{
+    BoundingBox bounds;   // union of the instances' model bounds
+    int first = 0;        // range in the batch's transforms / instance buffer
+    int count = 0;
+};
 
 struct VegetationInstanceBatch
 {
     std::string modelName;
+    ModelId modelId; // resolved from modelName in Generate()
 
-    // All transforms generated for this model
+    // All transforms generated for this model, grouped by cell (shuffled inside each cell
+    // so any prefix is an even sample). Uploaded once into instanceVbo at the end of Generate().
     std::vector<Matrix> transforms;
+    unsigned int instanceVbo = 0;
 
-    // Optional visible list rebuilt every frame for draw-distance/frustum later
-    std::vector<Matrix> visibleTransforms;
-
-    // Same positions as transforms, used for CPU culling
+    // Same positions as transforms
     std::vector<Vector3> positions;
 
+    // Culling tree over the cells
+    std::vector<VegetationCell> cells;
+    StaticBVH bvh;
+
+    // Far cells only draw part of their instances (grass). Trees always draw in full.
+    bool densityFalloff = false;
 
+    // Rebuilt every frame
+    std::vector<int> visibleCells;
+    std::vector<InstanceRange> ranges;
+    int drawnInstances = 0;
 
-    void Clear()
-    {
-        transforms.clear();
-        visibleTransforms.clear();
-        positions.clear();
-    }
+    void Clear(); // also frees instanceVbo
 };
 
 namespace VegetationInstanced
@@ -40,12 +57,12 @@ namespace VegetationInstanced
     // Does not unload models/textures.
     void Clear();
 
-    // Draw all vegetation batches with DrawMeshInstanced().
+    // Draw the visible cells of every batch straight from the resident instance buffers.
     void Draw(Camera& camera);
 
     // Optional for debugging
     int GetTotalInstanceCount();
     int GetVisibleInstanceCount();
 
-    void SetShaderValues(Camera& camera);
+    void SetShaderValues();
 }
\ No newline at end of file
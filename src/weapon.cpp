@@ -9,6 +9,7 @@
 #include "world.h"
 #include "ui.h"
 #include "shaderSetup.h"
+#include "replay.h"
 
 void MeleeWeapon::Init()
 {
@@ -159,7 +160,7 @@ void Crossbow::FireHarpoon(Camera& camera) {
     (void)camera;
     if (!hasHarpoon) return;
     if (!harpoonReady) return;
-    float now = GetTime();
+    float now = Replay::GetTime();
     if (now - lastFired < fireCooldown) return;
     
     // Don't fire if we're reloading or not in loaded state
@@ -190,7 +191,7 @@ void Crossbow::FireHarpoon(Camera& camera) {
 void Crossbow::Fire(Camera& camera)
 {
     (void)camera;
-    float now = GetTime();
+    float now = Replay::GetTime();
     if (now - lastFired < fireCooldown) return;
     if (isReloading || state != CrossbowState::Loaded) return;
 
@@ -228,7 +229,7 @@ void Crossbow::Reload()
 
 void Weapon::Fire(Camera& camera) 
 {
-    float now = (float)GetTime();
+    float now = (float)Replay::GetTime();
 
     if (now - lastFired >= fireCooldown) 
     {
@@ -614,7 +615,7 @@ void Weapon::Update(float deltaTime) {
 
     // Right-click primes the blunderbuss for a double shot.
     if (hasDoubleShot && player.activeWeapon == WeaponType::Blunderbuss &&
-        IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
+        Replay::IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
     {
         StartBlunderbussDoubleLoad(*this);
     }
@@ -1180,7 +1181,7 @@ void MeleeWeapon::PlaySwipe(){
 
     int index;
     do {
-        index = GetRandomValue(0, swipes.size() - 1);
+        index = RandomInt(0, swipes.size() - 1);
     } while (index == lastIndex && swipes.size() > 1);  // avoid repeat if more than 1
 
     lastIndex = index;
@@ -1192,7 +1193,7 @@ void MeleeWeapon::PlaySwipe(){
 
 void MagicStaff::Fire(const Camera& camera) {
     (void)camera;
-    if (GetTime() - lastFired < fireCooldown) return;
+    if (Replay::GetTime() - lastFired < fireCooldown) return;
 
     if (player.currentMana >= 10){
         player.currentMana -= 10;
@@ -1200,7 +1201,7 @@ void MagicStaff::Fire(const Camera& camera) {
         return;
     }
 
-    lastFired = GetTime();
+    lastFired = Replay::GetTime();
     recoil += recoilAmount;
     //flashTimer = flashDuration;
 
@@ -1232,7 +1233,7 @@ void MagicStaff::PlaySwipe(){
 
     int index;
     do {
-        index = GetRandomValue(0, swipes.size() - 1);
+        index = RandomInt(0, swipes.size() - 1);
     } while (index == lastIndex && swipes.size() > 1);  // avoid repeat if more than 1
 
     lastIndex = index;
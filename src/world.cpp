@@ -16,6 +16,8 @@
 #include "lighting.h"
 #include "ui.h"
 #include "terrainChunking.h"
+#include "heightfield.h"
+#include "dynamic_resolution.h"
 #include "spiderEgg.h"
 #include "miniMap.h"
 #include "heightmapPathfinding.h"
@@ -32,13 +34,17 @@
 #include "dungeon_props.h"
 #include "dungeonInstancing.h"
 #include "saveGame.h"
+#include "replay.h"
+#include "benchmark.h"
+#include "ai_scheduler.h"
+#include "job_system.h"
+#include "dungeon_visibility.h"
 
 
 GameState currentGameState = GameState::Menu;
 MainMenu::State gMenu;
 //global variables, clean these up somehow. 
 
-Image heightmap;
 Vector3 terrainScale = {16000.0f, 200.0f, 16000.0f}; //very large x and z, 
 HeightmapNavGrid gIslandNav;
 Kraken gKraken;
@@ -48,7 +54,6 @@ int previousLevelIndex = 0;
 bool first = true; //for first player start position
 bool controlPlayer = false;
 bool isDungeon = false;
-unsigned char* heightmapPixels = nullptr;
 Player player = {};
 Vector3 startPosition = {5475.0f, 300.0f, -5665.0f}; //middle island start pos
 Vector3 boatPosition = {-3727.55f,-20.0f, 5860.31f}; //set in level not here
@@ -99,16 +104,17 @@ int gCurrentLevelIndex = 0;
 
 FadePhase gFadePhase = FadePhase::Idle;
 Model oceanModel;
-//std::vector<Bullet> activeBullets;
-std::list<Bullet> activeBullets; // instead of std::vector
+BulletPool activeBullets; // slot map, see bullet.h
 std::vector<Portal> portals;
-std::vector<Decal> decals;
+DecalPool decals;
+Emitter decalBlood; //shared by all flying gibs
 std::vector<MuzzleFlash> activeMuzzleFlashes;
 std::vector<Collectable> collectables;
 std::vector<PowerUpPickup> g_powerUps;
 std::vector<CollectableWeapon> worldWeapons; //weapon pickups
-std::vector<Character> enemies;
-std::vector<Character*> enemyPtrs;
+EnemyStore enemies;
+const std::vector<Character*>& enemyPtrs = enemies.Ptrs();
+float gEnemyUpdateMs = 0.0f;
 std::vector<NPC> gNPCs;
 std::vector<Tentacle> tentacles;
 std::vector<Cannon> cannons;
@@ -154,11 +160,10 @@ void InitMenuLevel(LevelData& level){
     ClearLevel();
     isDungeon = false;
     InitShaders();
-    heightmap = LoadImage(level.heightmapPath.c_str());
-    ImageFormat(&heightmap, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE);
+    gHeightField.Load(level.heightmapPath, terrainScale);
     UpdateLoadingScreen(.80, "Building Terrain From Heightmap");
-    terrain = BuildTerrainGridFromHeightmap(heightmap, terrainScale, 193, true); //193 bigger chunks less draw calls.
-    Grass::GenerateFromHeightmap(heightmap, terrainScale, 40.0f, 0.90f, 5000);
+    terrain = BuildTerrainGridFromHeightmap(gHeightField, terrainScale, 193, true); //193 bigger chunks less draw calls.
+    Grass::GenerateFromHeightmap(gHeightField, terrainScale, 40.0f, 0.90f, 5000);
     GenerateEntrances();
     UpdateLoadingScreen(.10, "Generating Vegetation");
     VegetationInstanced::Generate();
@@ -215,10 +220,10 @@ void InitShaders(){
 }
 
 void UpdateShadersPerFrame(float deltaTime,float ElapsedTime, Camera& camera){
-    ShaderSetup::UpdateLavaShaderPerFrame(ShaderSetup::gLava, ElapsedTime, isLoadingLevel);
-    ShaderSetup::UpdatePortalShader(ElapsedTime);
-    ShaderSetup::UpdateWaterShaderPerFrame(ShaderSetup::gWater, ElapsedTime, camera);
-    ShaderSetup::UpdateTreeShader(ShaderSetup::gTree, camera);
+    //camera, fog colors, night darkness and time for every world shader in one pass
+    ShaderSetup::UpdateFrameUniforms(camera, ElapsedTime);
+    ShaderSetup::UpdateWaterShaderPerFrame(ShaderSetup::gWater, camera);
+    ShaderSetup::UpdateTreeShader(ShaderSetup::gTree);
     ShaderSetup::UpdateSkyShaderPerFrame(ShaderSetup::gSky, ElapsedTime);
     ShaderSetup::UpdateBloomShaderPerFrame(ShaderSetup::gBloom, deltaTime);
     ShaderSetup::UpdateGhostShaderPerFrame(ShaderSetup::gGhost);
@@ -267,10 +272,7 @@ int GetMaxParticleCount()
         total += b.sparkEmitter.GetMaxParticleCount();
     }
 
-    for (const Decal& d : decals)
-    {
-        total += d.bloodEmitter.GetMaxParticleCount();
-    }
+    total += decalBlood.GetMaxParticleCount();
 
     for (const SpiderEgg& s : eggs)
     {
@@ -293,9 +295,7 @@ int GetParticleCount(){
         total += b.sparkEmitter.GetActiveParticleCount();
     }
 
-    for (const Decal& d : decals){
-        total += d.bloodEmitter.GetActiveParticleCount();
-    }
+    total += decalBlood.GetActiveParticleCount();
 
     for (const SpiderEgg& s : eggs){
         total += s.gooEmitter.GetActiveParticleCount();
@@ -427,7 +427,6 @@ void InitLevel(LevelData& level, Camera& camera) {
     //Called when starting game and changing level. init the level you pass it. the level is chosen by menu or door's linkedLevelIndex. 
     ClearLevel();//clears everything.
     enemies.reserve(100); 
-    decals.reserve(1024);
     DebugConsole::Init();
     CameraSystem::Get().StopCinematic();
     CameraSystem::Get().SetMode(CamMode::Cinematic);
@@ -436,14 +435,13 @@ void InitLevel(LevelData& level, Camera& camera) {
     levelIndex = level.levelIndex; //update current level index to new level. 
     gCurrentLevelIndex = levelIndex; //save current level globally so we can tell if we are changing levels or resuming. 
 
-    heightmap = LoadImage(level.heightmapPath.c_str());
-    ImageFormat(&heightmap, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE);
+    gHeightField.Load(level.heightmapPath, terrainScale); //one 16-bit copy, everything below borrows it
     if (!CurrentLevelIs("Ship")){  
         UpdateLoadingScreen(0.80f, "Building Terrain From Heightmap");
-        terrain = BuildTerrainGridFromHeightmap(heightmap, terrainScale, 193, true); //193 bigger chunks less draw calls. 
+        terrain = BuildTerrainGridFromHeightmap(gHeightField, terrainScale, 193, true); //193 bigger chunks less draw calls. 
         //instanced grass
         UpdateLoadingScreen(0.10f, "Instancing Grass");
-        Grass::GenerateFromHeightmap(heightmap, terrainScale, 25.0f, 0.80f, 10000);
+        Grass::GenerateFromHeightmap(gHeightField, terrainScale, 25.0f, 0.80f, 10000);
 
     }else{
         Grass::Clear();
@@ -452,18 +450,20 @@ void InitLevel(LevelData& level, Camera& camera) {
 
     hasIslandNav = false;
 
-    if (heightmap.data != NULL && heightmap.width > 0)
+    if (gHeightField.IsValid())
     {
         UpdateLoadingScreen(0.10f, "Building NavGrid");
         float navSeaLevel = 60/255.0f; // match your actual sea level
 
+        gHeightField.BuildMips(256); // only the nav grid wants the coarse levels
         gIslandNav = HeightmapPathfinding::BuildNavGridFromHeightmap(
-            heightmap,
+            gHeightField,
             256, 256,
             navSeaLevel,
             terrainScale.x,
             terrainScale.z
         );
+        gHeightField.DropMips();
 
         if (gIslandNav.gridWidth > 0 && !gIslandNav.walkable.empty())
             hasIslandNav = true;
@@ -542,6 +542,7 @@ void InitLevel(LevelData& level, Camera& camera) {
         GenerateInvisibleWalls(floorHeight);
         UpdateLoadingScreen(.55, "Generating Doors");
         GenerateDoorways(floorHeight - 20, levelIndex); //calls generate doors from archways
+        DungeonVisibility::Build(); //rooms + portals, needs doorways and doors
         UpdateLoadingScreen(.65, "Generating Skirts");
         GenerateLavaSkirtsFromMask(floorHeight);
         UpdateLoadingScreen(.75, "Generating Barrels");
@@ -627,7 +628,7 @@ static int queuedLevel = -1;
 
 inline float FadeDt() {
     // Use unpaused time, but cap it to avoid spikes
-    float dt = GetFrameTime();               // or your unscaled dt source
+    float dt = Replay::GetFrameTime();               // or your unscaled dt source
     if (dt > 0.05f) dt = 0.05f;              // cap to 50 ms (20 fps) for fades
     return dt;
 }
@@ -820,21 +821,48 @@ void DrawWaterPlane()
 }
 
 
-void DrawEnemyShadows() {
-    Model& shadowModel = R.GetModel("shadowQuad");
+static constexpr float BLOB_SHADOW_MAX_HEIGHT = 800.0f; // bullets/pickups higher than this cast nothing
 
-    // Don’t write to depth, but still test against it
-    rlEnableDepthTest();
-    rlDisableDepthMask();
+// Ground height under a bullet or pickup. False over water on islands.
+static bool BlobShadowGround(Vector3 pos, float& groundY)
+{
+    if (isDungeon) {
+        groundY = floorHeight;
+        return true;
+    }
+    groundY = GetHeightAtWorldPosition(pos);
+    return groundY > waterHeightY;
+}
 
-    for (NPC& npc : gNPCs){
-        Vector3 groundPos = {npc.position.x, npc.GetFeetPosY() + 1.0f, npc.position.z};
+// Blob that shrinks as the object rises, gone at BLOB_SHADOW_MAX_HEIGHT.
+static void AddProjectedBlob(std::vector<Matrix>& out, Vector3 pos, float size)
+{
+    float groundY;
+    if (!BlobShadowGround(pos, groundY)) return;
 
-        DrawModelEx(shadowModel, groundPos, {0,1,0}, 0.0f, {100,100,100}, BLACK);
+    float height = pos.y - groundY;
+    if (height < 0.0f || height > BLOB_SHADOW_MAX_HEIGHT) return;
 
+    float s = size * (1.0f - 0.5f * height / BLOB_SHADOW_MAX_HEIGHT);
+    out.push_back(MatrixMultiply(MatrixScale(s, s, s), MatrixTranslate(pos.x, groundY + 2.0f, pos.z)));
+}
+
+void DrawBlobShadows() {
+    // One instance per blob, drawn with a single DrawMeshInstanced.
+    static std::vector<Matrix> transforms;
+    transforms.clear();
+
+    auto add = [](Vector3 groundPos, float size) {
+        transforms.push_back(MatrixMultiply(MatrixScale(size, size, size),
+                                            MatrixTranslate(groundPos.x, groundPos.y, groundPos.z)));
+    };
+
+    for (NPC& npc : gNPCs){
+        add({npc.position.x, npc.GetFeetPosY() + 1.0f, npc.position.z}, 100.0f);
     }
 
-    for (Character& enemy : enemies) {
+    for (Character* e : enemyPtrs) {
+        Character& enemy = *e;
         if (enemy.type == CharacterType::Bat) continue; //dont draw shadows for bats
 
         Vector3 groundPos;
@@ -842,14 +870,36 @@ void DrawEnemyShadows() {
             groundPos = { enemy.position.x, enemy.position.y - 42.0f, enemy.position.z };
             
         }else{
-            float ny = GetHeightAtWorldPosition(enemy.position, heightmap, terrainScale) + 10.0f;
-            groundPos = { enemy.position.x, ny, enemy.position.z };
+            // groundHeight was sampled in Character::Update for the ground snap
+            groundPos = { enemy.position.x, enemy.groundHeight + 10.0f, enemy.position.z };
         }
         
         if (enemy.type == CharacterType::Trex) groundPos.y -= 100; //half the frame height? 
-        DrawModelEx(shadowModel, groundPos, {0,1,0}, 0.0f, {100,100,100}, BLACK);
+        add(groundPos, 100.0f);
+    }
+
+    // projected blobs for things in the air, same draw
+    for (const Bullet& b : activeBullets) {
+        if (!b.IsAlive() || b.isExploded()) continue;
+        AddProjectedBlob(transforms, b.GetPosition(), b.GetRadius() * 2.0f);
+    }
+
+    for (const Collectable& c : collectables) {
+        AddProjectedBlob(transforms, c.position, 60.0f);
     }
 
+    if (transforms.empty() || !ShaderSetup::gShadow.instanced) return;
+
+    Model& shadowModel = R.GetModel("shadowQuad");
+    Material material = shadowModel.materials[0];
+    material.shader = *ShaderSetup::gShadow.instanced;
+
+    // Don’t write to depth, but still test against it
+    rlEnableDepthTest();
+    rlDisableDepthMask();
+
+    DrawMeshInstanced(shadowModel.meshes[0], material, transforms.data(), (int)transforms.size());
+
     rlEnableDepthMask();
 }
 
@@ -905,7 +955,6 @@ void OpenEventLockedDoors(){
 
 void removeAllCharacters(){
     enemies.clear();
-    enemyPtrs.clear();
     gNPCs.clear();
 
 }
@@ -1018,8 +1067,8 @@ void generateTrex(int amount, Vector3 centerPos, float radius, float minPlayerDi
     {
         ++attempts;
 
-        float angle = GetRandomValue(0, 360) * DEG2RAD;
-        float distance = (float)GetRandomValue((int)minCenterDistance, (int)radius);
+        float angle = RandomInt(0, 360) * DEG2RAD;
+        float distance = (float)RandomInt((int)minCenterDistance, (int)radius);
 
         float x = centerPos.x + cosf(angle) * distance;
         float z = centerPos.z + sinf(angle) * distance;
@@ -1035,7 +1084,7 @@ void generateTrex(int amount, Vector3 centerPos, float radius, float minPlayerDi
             continue;
         }
 
-        float terrainHeight = GetHeightAtWorldPosition(spawnPos, heightmap, terrainScale);
+        float terrainHeight = GetHeightAtWorldPosition(spawnPos);
 
         if (terrainHeight <= 80.0f)
         {
@@ -1060,9 +1109,8 @@ void generateTrex(int amount, Vector3 centerPos, float radius, float minPlayerDi
         Trex.maxHealth = 2000;
         Trex.currentHealth = Trex.maxHealth;
 
-        enemies.push_back(Trex);
+        enemies.Add(Trex);
 
-        enemyPtrs.push_back(&enemies.back());
 
         ++spawned;
     }
@@ -1077,14 +1125,14 @@ void generateDactyls(int amount, Vector3 centerPos, float radius) {
     while (spawned < amount && attempts < maxAttempts) {
         ++attempts;
 
-        float angle = GetRandomValue(0, 360) * DEG2RAD;
-        float distance = GetRandomValue(500, (int)radius);
+        float angle = RandomInt(0, 360) * DEG2RAD;
+        float distance = RandomInt(500, (int)radius);
         float x = centerPos.x + cosf(angle) * distance;
         float z = centerPos.z + sinf(angle) * distance;
 
         Vector3 spawnPos = { x, 0.0f, z }; //random x, z  get height diferrently for dungeon
         
-        float terrainHeight = GetHeightAtWorldPosition(spawnPos, heightmap, terrainScale);
+        float terrainHeight = GetHeightAtWorldPosition(spawnPos);
         //if (terrainHeight <= 80.0f) continue; //try again
         //dactyls can spawn over water
 
@@ -1097,8 +1145,7 @@ void generateDactyls(int amount, Vector3 centerPos, float radius) {
         dactyl.maxHealth = 100; //one harpoon shot will kill it. otherwise we would have to figure out 3d grapple pull
         dactyl.currentHealth = dactyl.maxHealth;
         dactyl.state = CharacterState::Idle;
-        enemies.push_back(dactyl);
-        enemyPtrs.push_back(&enemies.back()); 
+        enemies.Add(dactyl);
         ++spawned;
     }
 
@@ -1114,8 +1161,8 @@ void generateRaptors(int amount, Vector3 centerPos, float radius) {
     while (spawned < amount && attempts < maxAttempts) {
         ++attempts;
 
-        float angle = GetRandomValue(0, 360) * DEG2RAD;
-        float distance = GetRandomValue(500, (int)radius);
+        float angle = RandomInt(0, 360) * DEG2RAD;
+        float distance = RandomInt(500, (int)radius);
         float x = centerPos.x + cosf(angle) * distance;
         float z = centerPos.z + sinf(angle) * distance;
 
@@ -1134,7 +1181,7 @@ void generateRaptors(int amount, Vector3 centerPos, float radius) {
             spawnPos.y = dh + spriteHeight / 2.0f;
 
         } else {
-            float terrainHeight = GetHeightAtWorldPosition(spawnPos, heightmap, terrainScale);
+            float terrainHeight = GetHeightAtWorldPosition(spawnPos);
             if (terrainHeight <= 80.0f) continue; //try again
 
             float spriteHeight = 200 * 0.5f;
@@ -1145,7 +1192,7 @@ void generateRaptors(int amount, Vector3 centerPos, float radius) {
 
         Character raptor(spawnPos, R.GetTexture("raptorTexture"), 512, 512, 1, 0.5f, 0.5f, 0, CharacterType::Raptor);
 
-        raptor.isElite = (GetRandomValue(0, 99) < 15); // 15% chance
+        raptor.isElite = (RandomInt(0, 99) < 15); // 15% chance
         raptor.baseScale = 0.3; //hack for raptors specifically. 
         if (raptor.isElite){
             raptor.maxHealth = 500;
@@ -1159,9 +1206,7 @@ void generateRaptors(int amount, Vector3 centerPos, float radius) {
         }
 
 
-        raptor.id++;
-        enemies.push_back(raptor);
-        enemyPtrs.push_back(&enemies.back()); 
+        enemies.Add(raptor);
         ++spawned;
     }
 
@@ -1170,13 +1215,7 @@ void generateRaptors(int amount, Vector3 centerPos, float radius) {
 
 Character* FindEnemyById(int id)
 {
-    for (Character* e : enemyPtrs)
-    {
-        if (!e) continue;
-        if (e->id == id)
-            return e;
-    }
-    return nullptr;
+    return enemies.FindById(id);
 }
 
 void UpdateNPCs(float deltaTime){
@@ -1189,13 +1228,42 @@ void UpdateNPCs(float deltaTime){
 }
 
 void UpdateEnemies(float deltaTime) {
+    gEnemyUpdateMs = 0.0f;
     if (isLoadingLevel) return;
-    if (GameSettings::freezeAI) return;
-    if (CameraSystem::Get().GetMode() == CamMode::Cinematic) return; //dont update enemies when in cutscenes. 
-    
-    for (Character* e : enemyPtrs){
-        e->Update(deltaTime, player);
+    //dont update enemies when in cutscenes. The benchmark flythrough is a cutscene but still wants them running.
+    bool cutscene = CameraSystem::Get().GetMode() == CamMode::Cinematic && !Benchmark::IsRunning();
+    if (GameSettings::freezeAI || cutscene){
+        enemies.SyncHot(); //nothing moves them but collisions, keep the snapshot where they stand
+        return;
+    }
+
+    double start = GetTime();
+
+    static std::vector<float> aiDt;
+    AIScheduler::Schedule(enemyPtrs, enemies.Hot(), player.position, CameraSystem::Get().Active(), deltaTime, aiDt);
+
+    // think: the read-only queries (line of sight, targets, neighbours) across the job system
+    static std::vector<int> thinkers;
+    thinkers.clear();
+    for (size_t i = 0; i < aiDt.size(); i++){
+        if (aiDt[i] > 0.0f) thinkers.push_back((int)i);
     }
+    JobSystem::ParallelFor((int)thinkers.size(), 16, [&](int begin, int end){
+        for (int k = begin; k < end; k++) enemyPtrs[thinkers[k]]->Think(player, aiDt[thinkers[k]]);
+    });
+
+    // apply: state machines, movement, bullets, sounds, spawns. Main thread, same order as before.
+    // index loop: an enemy can spawn another mid-update (added after the scheduled range)
+    size_t scheduled = aiDt.size();
+    for (size_t i = 0; i < enemyPtrs.size(); i++){
+        enemyPtrs[i]->Update(deltaTime, player, i < scheduled ? aiDt[i] : deltaTime);
+    }
+
+    //the one copy per frame: bullet collision reads these, and next frame's AI tiers,
+    //think and repulsion read them as the start-of-frame snapshot
+    enemies.SyncHot();
+
+    gEnemyUpdateMs = (float)((GetTime() - start) * 1000.0);
 }
 
 void UpdateMuzzleFlashes(float deltaTime) {
@@ -1215,6 +1283,7 @@ void UpdateMuzzleFlashes(float deltaTime) {
 }
 
 void UpdateBullets(Camera& camera, float dt) {
+    activeBullets.CommitSpawns(); //bullets fired since last frame
 
     for (Bullet& b : activeBullets) {
         b.Update(camera, dt);
@@ -1231,14 +1300,13 @@ void UpdateBullets(Camera& camera, float dt) {
             }
         }
     }
+
+    activeBullets.CommitSpawns(); //shrapnel spawned by explosions above
 }
 
 void EraseBullets() {
-    activeBullets.erase(
-        std::remove_if(activeBullets.begin(), activeBullets.end(),
-            [](Bullet& b) { return b.IsDone();}),
-        activeBullets.end()
-    );
+    activeBullets.RemoveIf([](Bullet& b) { return b.IsDone(); });
+    activeBullets.CommitSpawns(); //anything spawned by collisions this frame
 }
 
 
@@ -1289,9 +1357,7 @@ void UpdateKraken(float deltaTime){
 void DrawKraken(Camera& camera){
     gKraken.Draw(camera);
 
-    for (Tentacle& t : tentacles){
-        t.Draw();
-    }
+    DrawTentacles(tentacles);
 }
 
 void DrawCollectableModels(const std::vector<Collectable>& collectables)
@@ -1383,19 +1449,14 @@ void PlayerSwipeDecal(Camera& camera){
     Vector3 vel = Vector3Add(Vector3Scale(fwd, Vector3Length(player.velocity)), Vector3Scale(right, 0.0f)); //melee swipe decals move forward 
     decal.velocity = vel;
     
-    decals.emplace_back(decal);
+    decals.Spawn(decal);
 }
 
 
 void UpdateDecals(float deltaTime){
-    //update decal animation timers
-    for (auto& d : decals) {
-        d.Update(deltaTime);
-        
-    }
-    decals.erase(std::remove_if(decals.begin(), decals.end(),
-                [](const Decal& d) { return !d.alive; }),
-                decals.end());
+    //update decal animation timers, dead decals are swap-removed
+    decals.Update(deltaTime);
+    decalBlood.UpdateBlood(deltaTime);
 }
 
 
@@ -1408,6 +1469,7 @@ void DrawBloodParticles(Camera& camera){
         egg.gooEmitter.Draw(camera);
     }
     gKraken.bloodEmitter.Draw(camera);
+    decalBlood.Draw(camera);
     
 }
 
@@ -1482,7 +1544,7 @@ void DrawOverworldProps() {
 
         //std::cout << modelKey << "\n";
         Vector3 propPos = p.position;
-        float propY = GetHeightAtWorldPosition(propPos, heightmap, terrainScale);
+        float propY = GetHeightAtWorldPosition(propPos);
         propPos.y = propY;
         DrawModelEx(R.GetModel(modelKey), propPos,
                     {0,1,0}, p.yawDeg, {p.scale,p.scale,p.scale}, WHITE);
@@ -1563,28 +1625,10 @@ void InitNPCs() //spawn hermit on island.
 
 
 
-float GetHeightAtWorldPosition(Vector3 position, Image& heightmap, Vector3 terrainScale) {
-    //read heightmap pixels and return the height in world space. 
-    int width = heightmap.width;
-    int height = heightmap.height;
-    unsigned char* pixels = (unsigned char*)heightmap.data;
-
-    // Convert world X/Z into heightmap image coordinates
-    float xPercent = (position.x + terrainScale.x / 2.0f) / terrainScale.x;
-    float zPercent = (position.z + terrainScale.z / 2.0f) / terrainScale.z;
-
-    // Clamp to valid range
-    xPercent = Clamp(xPercent, 0.0f, 1.0f);
-    zPercent = Clamp(zPercent, 0.0f, 1.0f);
-
-    // Convert to pixel indices
-    int x = (int)(xPercent * (width - 1));
-    int z = (int)(zPercent * (height - 1));
-    int index = z * width + x;
-
-    // Get grayscale pixel and scale to world height
-    float heightValue = (float)pixels[index] / 255.0f;
-    return heightValue * terrainScale.y;
+float GetHeightAtWorldPosition(Vector3 position) {
+    // Bilinear from the level's HeightField, 0 before a level has loaded one.
+    if (!gHeightField.IsValid()) return 0.0f;
+    return gHeightField.Sample(position.x, position.z);
 }
 
 void DrawReticle(WeaponType& weaponType){
@@ -1695,6 +1739,7 @@ void UpdateOverlayInfo(DebugOverlayInfo& overlayInfo){
     overlayInfo.levelIndex = gCurrentLevelIndex;
     overlayInfo.drawDistance = GameSettings::maxDrawDist;
     overlayInfo.fovY = CameraSystem::Get().Active().fovy;
+    overlayInfo.renderScale = DynamicResolution::Scale();
     overlayInfo.visibleInstances = GameSettings::gVisibleDungeonInstanceCount;
     overlayInfo.totalInstances = GameSettings::gTotalDungeonInstanceCount;
     overlayInfo.totalFoliage = VegetationInstanced::GetTotalInstanceCount();
@@ -1710,6 +1755,16 @@ void UpdateOverlayInfo(DebugOverlayInfo& overlayInfo){
     overlayInfo.lightmapHeight = gDynamic.tex.height;
     overlayInfo.skyTransition = ShaderSetup::gSky.skyTransition;
     overlayInfo.activeEnemies = enemyPtrs.size();
+    overlayInfo.enemyUpdateMs = gEnemyUpdateMs;
+    const AIScheduler::Stats& ai = AIScheduler::LastStats();
+    overlayInfo.aiFull = ai.full;
+    overlayInfo.aiReduced = ai.reduced;
+    overlayInfo.aiDormant = ai.dormant;
+    overlayInfo.aiThinks = ai.thinks;
+    overlayInfo.aiDeferred = ai.deferred;
+    overlayInfo.aiBudget = ai.budget;
+    overlayInfo.totalRooms = DungeonVisibility::RoomCount();
+    overlayInfo.visibleRooms = DungeonVisibility::VisibleRoomCount();
     overlayInfo.activeBullets = activeBullets.size();
     overlayInfo.maxParticles = GetMaxParticleCount();
     overlayInfo.activeParticles = GetParticleCount();
@@ -1810,30 +1865,11 @@ void UpdateWorldFrame(float dt, Player& player) {
 
 }
 
-static void RebuildEnemyPtrs()
-{
-    enemyPtrs.clear();
-    enemyPtrs.reserve(enemies.size());
-
-    for (Character& e : enemies)
-    {
-        enemyPtrs.push_back(&e);
-    }
-}
-
 void eraseCharacters() {
-    // Remove dead enemies
-
-    // IMPORTANT: enemies is a vector → pointers invalid after erase or reallocation
-    // Always rebuild enemyPtrs after modifying this container
-    enemies.erase(std::remove_if(enemies.begin(), enemies.end(),
-        [](const Character& e) {
-            return e.isDead && e.deathTimer > 5.0f; //is dead AND deathtimer > 5
-        }),
-        enemies.end());
-
-    // Rebuild enemyPtrs
-    RebuildEnemyPtrs();
+    // Remove dead enemies. Other enemies don't move, enemyPtrs is patched in place.
+    enemies.RemoveIf([](const Character& e) {
+        return e.isDead && e.deathTimer > 5.0f; //is dead AND deathtimer > 5
+    });
 }
 
 void ClearLevel() {
@@ -1850,15 +1886,17 @@ void ClearLevel() {
     activeBullets.clear();
     billboardRequests.clear();
     bulletLights.clear();
+    decalBlood.Clear(); //decals are cleared in ClearDungeon, their blood goes with them
     dungeonEntrances.clear();
     masts.clear();
     tentacles.clear();
+    UnloadTentacleMesh();
     cannons.clear();
     g_powerUps.clear();
     player_boat = {};
     
      //unload mesh and heightmap when switching levels. if they exist
-    if (heightmap.data != nullptr) UnloadImage(heightmap); 
+    gHeightField.Clear();
     UnloadTerrainGrid(terrain);
 
     isDungeon = false;
@@ -4,9 +4,11 @@
 #include "player.h"
 #include <vector>
 #include "character.h"
+#include "enemy_store.h"
 #include "bullet.h"
 #include "vegetation.h"
 #include "decal.h"
+#include "emitter.h"
 #include "level.h"
 #include "collectable.h"
 #include "collectableWeapon.h"
@@ -37,7 +39,6 @@ enum class GameState {
 // Globals or in a FadeController:
 enum class FadePhase { Idle, FadingOut, Swapping, FadingIn };
 
-extern Image heightmap;
 extern Kraken gKraken;
 extern Vector3 terrainScale;
 
@@ -60,7 +61,6 @@ extern bool isDungeon;
 extern float dungeonPlayerHeight; 
 extern float floorHeight;
 extern float wallHeight;
-extern unsigned char* heightmapPixels;
 extern int selectedOption; // 0 = Start, 1 = Quit
 extern int levelIndex;
 extern int previousLevelIndex;
@@ -106,17 +106,18 @@ extern MainMenu::State gMenu;
 extern HeightmapNavGrid gIslandNav;
 extern TreeShadowMask gTreeShadowMask;
 extern std::vector<DungeonEntrance> dungeonEntrances;
-//extern std::vector<Bullet> activeBullets;
-extern std::list<Bullet> activeBullets; // instead of std::vector
-extern std::vector<Decal> decals;
+extern BulletPool activeBullets; // slot map, see bullet.h
+extern DecalPool decals;
+extern Emitter decalBlood;
 extern std::vector<Collectable> collectables;
 extern std::vector<PowerUpPickup> g_powerUps;
 extern std::vector<MuzzleFlash> activeMuzzleFlashes;
 extern std::vector<PreviewInfo> levelPreviews;
 extern std::vector<CollectableWeapon> worldWeapons;
 extern std::vector<Portal> portals;
-extern std::vector<Character> enemies;  
-extern std::vector<Character*> enemyPtrs;
+extern EnemyStore enemies;  
+extern const std::vector<Character*>& enemyPtrs; // enemies.Ptrs(), patched in place on add/remove
+extern float gEnemyUpdateMs; // time spent in UpdateEnemies last frame
 extern std::vector<NPC> gNPCs;
 extern std::vector<Tentacle> tentacles;
 extern std::vector<Cannon> cannons;
@@ -136,7 +137,7 @@ void GenerateEntrances();
 void HandleWaves(Camera& camera);
 void UpdateEnemies(float deltaTime);
 void UpdateNPCs(float deltaTime);
-void DrawEnemyShadows();
+void DrawBlobShadows();
 void UpdateMuzzleFlashes(float deltaTime);
 void UpdateBullets(Camera& camera, float deltaTime);
 void EraseBullets();
@@ -151,7 +152,7 @@ void UpdateCannons(float deltaTime);
 void EventLockAllDoors(bool lock);
 void DrawReticle(WeaponType& weaponType);
 Vector3 ResolveSpawnPoint(const LevelData& level, bool isDungeon, bool first, float floorHeight);
-float GetHeightAtWorldPosition(Vector3 position, Image& heightmap, Vector3 terrainScale);
+float GetHeightAtWorldPosition(Vector3 position);
 void PlayerSwipeDecal(Camera& camera);
 void UpdateWorldFrame(float dt, Player& player);
 void StartFadeOutToLevel(int levelIndex);
@@ -18,6 +18,7 @@
 #include "transparentDraw.h"
 #include "JournalUI.h"
 #include "saveGame.h"
+#include "replay.h"
 
 
 void UpdateLevelMusic(){
@@ -40,7 +41,7 @@ void UpdateMenuState(Camera3D& camera, float deltaTime, float elapsedTime)
 {
     CameraSystem::Get().Update(deltaTime);
 
-    R.UpdateShaders(camera);
+    R.UpdateShaders();
     
     UpdateShadersPerFrame(deltaTime, elapsedTime, camera);
 
@@ -78,7 +79,7 @@ bool HandleFadeLevelSwap(Camera3D& camera)
     
     DiscoverLevel(pendingLevelIndex);
     save.levelIndex = pendingLevelIndex;
-    SaveGame::Save(save);
+    if (!Replay::IsPlayingBack()) SaveGame::Save(save); //playback shouldn't touch the player's save
 
     InitLevel(levels[pendingLevelIndex], camera);
     pendingLevelIndex = -1;
@@ -182,7 +183,7 @@ static void UpdateGameplayCollisions(Camera3D& camera)
 
 void UpdatePlayingFrame(Camera3D& camera, Player& player, float dt, float elapsedTime)
 {
-    if (IsKeyPressed(KEY_ESCAPE) && gFadePhase == FadePhase::Idle){
+    if (Replay::IsKeyPressed(KEY_ESCAPE) && gFadePhase == FadePhase::Idle){
         currentGameState = GameState::Menu;
     }
 
@@ -203,7 +204,7 @@ void UpdatePlayingFrame(Camera3D& camera, Player& player, float dt, float elapse
     UpdateWeaponBarLayoutOnResize();
     debugControls(camera, dt);
 
-    R.UpdateShaders(camera);
+    R.UpdateShaders();
     ShaderSetup::UpdateSkyTransition(dt);
     if (!isDungeon) ShaderSetup::UpdateSkyCycle(dt); //day night cycle on island maps only. 
     